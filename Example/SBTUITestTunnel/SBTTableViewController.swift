@@ -59,6 +59,7 @@ class SBTTableViewController: UITableViewController {
                                         NetworkTest(testSelector: #selector(executeUploadDataTaskRequestWithHTTPBody)),
                                         NetworkTest(testSelector: #selector(executeBackgroundUploadDataTaskRequestWithHTTPBody)),
                                         NetworkTest(testSelector: #selector(executeRequestWithRedirect)),
+                                        NetworkTest(testSelector: #selector(executeCacheableDataTaskRequest)),
                                         WebSocketTest(testSelector: #selector(executeWebSocket)),
                                         AutocompleteTest(testSelector: #selector(showAutocompleteForm)),
                                         CookiesTest(testSelector: #selector(executeRequestWithCookies)),
@@ -416,6 +417,10 @@ extension SBTTableViewController {
         dataTaskNetwork(urlString: "https://postman-echo.com/redirect-to?url=http%3A%2F%2Fgoogle.com%2F")
     }
 
+    @objc func executeCacheableDataTaskRequest() {
+        dataTaskNetwork(urlString: "https://postman-echo.com/response-headers?Cache-Control=max-age%3D600", httpMethod: "GET", httpBody: nil, delay: 0.0, shouldPushResult: false)
+    }
+
     @objc func executeWebSocket() {
         performSegue(withIdentifier: "webSocketSegue", sender: nil)
     }
@@ -0,0 +1,114 @@
+// CassetteTests.swift
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import Foundation
+import SBTUITestTunnelClient
+import SBTUITestTunnelServer
+import XCTest
+
+class CassetteTests: XCTestCase {
+    private let request = NetworkRequests()
+
+    func testRecordedRequestsAreReplayed() {
+        let token = UUID().uuidString
+        let urlString = "https://postman-echo.com/get?token=\(token)"
+
+        XCTAssert(app.cassetteStartRecordingNamed("replay"))
+        let recorded = request.dataTaskNetwork(urlString: urlString)
+        XCTAssertEqual(request.returnCode(recorded), 200)
+        XCTAssert(app.cassetteStop())
+
+        XCTAssert(app.cassetteStartReplayingNamed("replay"))
+        let replayed = request.dataTaskNetwork(urlString: urlString)
+        XCTAssertEqual(request.returnCode(replayed), 200)
+
+        let args = request.json(replayed)["args"] as? [String: String]
+        XCTAssertEqual(args?["token"], token)
+    }
+
+    func testUnrecordedRequestsFailWhenReplaying() {
+        XCTAssert(app.cassetteStartRecordingNamed("miss"))
+        XCTAssert(app.cassetteStop())
+
+        XCTAssert(app.cassetteStartReplayingNamed("miss"))
+        let result = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param=1")
+        XCTAssert(request.isNotConnectedError(result))
+    }
+
+    func testHeaderStubsMatchReplayedResponses() {
+        let token = UUID().uuidString
+        let urlString = "https://postman-echo.com/get?token=\(token)"
+
+        XCTAssert(app.cassetteStartRecordingNamed("header-stubs"))
+        _ = request.dataTaskNetwork(urlString: urlString)
+        XCTAssert(app.cassetteStop())
+
+        XCTAssert(app.cassetteStartReplayingNamed("header-stubs"))
+
+        let match = SBTRequestMatch(url: "postman-echo.com", responseHeaders: ["Content-Type": "application.*"])
+        let stubId = app.stubRequests(matching: match, response: SBTStubResponse(response: ["stubbed": 1]))!
+        let stubbed = request.dataTaskNetwork(urlString: urlString)
+        XCTAssert(request.isStubbed(stubbed, expectedStubValue: 1))
+        app.stubRequestsRemove(id: stubId)
+
+        let unmatchedMatch = SBTRequestMatch(url: "postman-echo.com", responseHeaders: ["Content-Type": "invalid"])
+        let unmatchedStubId = app.stubRequests(matching: unmatchedMatch, response: SBTStubResponse(response: ["stubbed": 1]))!
+        let replayed = request.dataTaskNetwork(urlString: urlString)
+        let args = request.json(replayed)["args"] as? [String: String]
+        XCTAssertEqual(args?["token"], token)
+        app.stubRequestsRemove(id: unmatchedStubId)
+    }
+
+    func testReplayIgnoringQueryItems() {
+        XCTAssert(app.cassetteStartRecordingNamed("ignored-query"))
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param=1&timestamp=1")
+        XCTAssert(app.cassetteStop())
+
+        let normalization = SBTRequestNormalization(includesQuery: true, ignoredQueryItems: ["timestamp"], includesBody: true, headers: nil)
+        XCTAssert(app.cassetteStartReplayingNamed("ignored-query", normalization: normalization))
+        let replayed = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param=1&timestamp=2")
+
+        let args = request.json(replayed)["args"] as? [String: String]
+        XCTAssertEqual(args?["timestamp"], "1")
+    }
+
+    func testExportAndLoadCassette() throws {
+        let token = UUID().uuidString
+        let urlString = "https://postman-echo.com/get?token=\(token)"
+
+        XCTAssert(app.cassetteStartRecordingNamed("export"))
+        _ = request.dataTaskNetwork(urlString: urlString)
+        XCTAssert(app.cassetteStop())
+
+        let cassette = try XCTUnwrap(app.cassetteNamed("export"))
+        XCTAssert(app.cassetteLoad(cassette, named: "loaded"))
+
+        XCTAssert(app.cassetteStartReplayingNamed("loaded"))
+        let replayed = request.dataTaskNetwork(urlString: urlString)
+
+        let args = request.json(replayed)["args"] as? [String: String]
+        XCTAssertEqual(args?["token"], token)
+    }
+}
+
+extension CassetteTests {
+    override func setUp() {
+        SBTUITestTunnelServer.perform(NSSelectorFromString("_connectionlessReset"))
+        app.launchConnectionless { path, params -> String in
+            SBTUITestTunnelServer.performCommand(path, params: params)
+        }
+    }
+}
@@ -51,6 +51,23 @@ class DownloadUploadTests: XCTestCase {
         XCTAssertTrue(randomString == uploadedString)
     }
 
+    func testLargeBinaryUpload() {
+        // large enough to be sent as raw bytes in a multipart body
+        var bytes = [UInt8](repeating: 0, count: 2 * 1024 * 1024)
+        for index in bytes.indices {
+            bytes[index] = UInt8.random(in: 0 ... 255)
+        }
+        let data = Data(bytes)
+
+        let paths = NSSearchPathForDirectoriesInDomains(.documentDirectory, .userDomainMask, true)
+        let testFilePath = paths.first!.appending("/test_file_binary.bin")
+        try! data.write(to: URL(fileURLWithPath: testFilePath))
+
+        app.uploadItem(atPath: testFilePath, toPath: "test_file_binary.bin", relativeTo: .documentDirectory)
+
+        XCTAssertEqual(app.downloadItems(fromPath: "test_file_binary.bin", relativeTo: .documentDirectory)?.first, data)
+    }
+
     func testMultipleDownload() {
         let randomString = ProcessInfo.processInfo.globallyUniqueString
 
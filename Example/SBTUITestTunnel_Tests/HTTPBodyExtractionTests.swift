@@ -242,4 +242,71 @@ class HTTPBodyExtractionTests: XCTestCase {
         // The actual status depends on implementation details, so we check for either
         XCTAssertTrue(inputStream.streamStatus == .closed || inputStream.streamStatus == .atEnd)
     }
+
+    // MARK: - Test tee stream capture
+
+    func testExtractHTTPBodyReadsStreamOnlyOnce() {
+        let url = URL(string: "https://example.com")!
+        let testData = "one-shot stream content".data(using: .utf8)!
+
+        let request = NSMutableURLRequest(url: url)
+        request.httpBodyStream = InputStream(data: testData)
+
+        // Body streams can't be rewound, subsequent extractions return the data captured by the first read
+        XCTAssertEqual(request.sbt_extractHTTPBody(), testData)
+        XCTAssertEqual(request.sbt_extractHTTPBody(), testData)
+    }
+
+    func testTeeInputStreamCapturesBytesWhileRead() {
+        let testData = String(repeating: "B", count: 10000).data(using: .utf8)!
+        let underlyingStream = InputStream(data: testData)
+        let teeStream = SBTTeeInputStream(inputStream: underlyingStream)
+
+        let readData = readAll(teeStream)
+
+        XCTAssertEqual(readData, testData)
+        XCTAssertTrue(teeStream.captureCompleted)
+        XCTAssertEqual(teeStream.capturedLength, UInt(testData.count))
+        XCTAssertEqual(teeStream.capturedData(), testData)
+        XCTAssertNil(teeStream.spillFileURL)
+        XCTAssertEqual(NSURLRequest.sbt_read(fromBodyStream: underlyingStream), testData)
+    }
+
+    func testTeeInputStreamSpillsToDiskBeyondThreshold() throws {
+        let testData = String(repeating: "C", count: 20000).data(using: .utf8)!
+        let teeStream = SBTTeeInputStream(inputStream: InputStream(data: testData), memoryThreshold: 1024)
+
+        XCTAssertEqual(readAll(teeStream), testData)
+
+        let spillFileURL = try XCTUnwrap(teeStream.spillFileURL)
+        XCTAssertTrue(FileManager.default.fileExists(atPath: spillFileURL.path))
+        XCTAssertEqual(teeStream.capturedData(), testData)
+    }
+
+    func testTeeInputStreamPendingCaptureIsNotExposed() {
+        let testData = "pending".data(using: .utf8)!
+        let underlyingStream = InputStream(data: testData)
+        let teeStream = SBTTeeInputStream(inputStream: underlyingStream)
+
+        // The body is being sent upstream, the underlying stream must not be read concurrently
+        XCTAssertNil(NSURLRequest.sbt_read(fromBodyStream: underlyingStream))
+
+        XCTAssertEqual(readAll(teeStream), testData)
+        XCTAssertEqual(NSURLRequest.sbt_read(fromBodyStream: underlyingStream), testData)
+    }
+
+    private func readAll(_ stream: InputStream) -> Data {
+        var data = Data()
+        var buffer = [UInt8](repeating: 0, count: 4096)
+
+        stream.open()
+        while true {
+            let bytesRead = stream.read(&buffer, maxLength: buffer.count)
+            guard bytesRead > 0 else { break }
+            data.append(buffer, count: bytesRead)
+        }
+        stream.close()
+
+        return data
+    }
 }
@@ -0,0 +1,157 @@
+// HTTPCacheTests.swift
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import Foundation
+import SBTUITestTunnelClient
+import SBTUITestTunnelServer
+import XCTest
+
+class HTTPCacheTests: XCTestCase {
+    private let request = NetworkRequests()
+    private let cacheableUrl = "https://postman-echo.com/response-headers?Cache-Control=max-age%3D600"
+
+    func testFreshResponsesAreServedFromCache() throws {
+        XCTAssert(app.httpCacheEnable())
+
+        let result = request.dataTaskNetwork(urlString: cacheableUrl)
+        let result2 = request.dataTaskNetwork(urlString: cacheableUrl)
+        XCTAssertEqual(request.returnCode(result), 200)
+        XCTAssertEqual(request.returnCode(result2), 200)
+        XCTAssertEqual(request.json(result2)["Cache-Control"] as? String, "max-age=600")
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.misses, 1)
+        XCTAssertEqual(statistics.hits, 1)
+    }
+
+    func testResponsesWithoutFreshnessAreNotServedFromCache() throws {
+        XCTAssert(app.httpCacheEnable())
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/response-headers?Cache-Control=no-store")
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/response-headers?Cache-Control=no-store")
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.misses, 2)
+        XCTAssertEqual(statistics.hits, 0)
+    }
+
+    func testCacheOptOut() throws {
+        XCTAssert(app.httpCacheEnable())
+        _ = request.dataTaskNetwork(urlString: cacheableUrl)
+
+        XCTAssert(app.httpCacheDisable())
+        _ = request.dataTaskNetwork(urlString: cacheableUrl)
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.misses, 1)
+        XCTAssertEqual(statistics.hits, 0)
+    }
+
+    func testStaleResponsesAreRevalidatedWithETag() throws {
+        XCTAssert(app.httpCacheEnable())
+
+        let url = "https://postman-echo.com/response-headers?Cache-Control=max-age%3D0&ETag=%22sbt-etag%22"
+        let result = request.dataTaskNetwork(urlString: url)
+        let result2 = request.dataTaskNetwork(urlString: url)
+        XCTAssertEqual(request.returnCode(result), 200)
+        // the 304 of the server is turned into the stored response
+        XCTAssertEqual(request.returnCode(result2), 200)
+        XCTAssertEqual(request.json(result2)["ETag"] as? String, "\"sbt-etag\"")
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.misses, 1)
+        XCTAssertEqual(statistics.revalidations, 1)
+        XCTAssertEqual(statistics.hits, 0)
+    }
+
+    func testStaleResponsesAreRevalidatedWithLastModified() throws {
+        XCTAssert(app.httpCacheEnable())
+
+        let lastModified = "Mon, 01 Jan 2024 00:00:00 GMT"
+        let url = "https://postman-echo.com/response-headers?Cache-Control=max-age%3D0&Last-Modified=\(lastModified.addingPercentEncoding(withAllowedCharacters: .alphanumerics)!)"
+        let result = request.dataTaskNetwork(urlString: url)
+        let result2 = request.dataTaskNetwork(urlString: url)
+        XCTAssertEqual(request.returnCode(result), 200)
+        XCTAssertEqual(request.returnCode(result2), 200)
+        XCTAssertEqual(request.json(result2)["Last-Modified"] as? String, lastModified)
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.misses, 1)
+        XCTAssertEqual(statistics.revalidations, 1)
+        XCTAssertEqual(statistics.hits, 0)
+    }
+
+    func testVariantsAreSelectedByVaryHeaders() throws {
+        XCTAssert(app.httpCacheEnable())
+
+        let url = "https://postman-echo.com/response-headers?Cache-Control=max-age%3D600&Vary=Accept-Language"
+        _ = request.dataTaskNetwork(urlString: url, requestHeaders: ["Accept-Language": "it"])
+        _ = request.dataTaskNetwork(urlString: url, requestHeaders: ["Accept-Language": "en"])
+        _ = request.dataTaskNetwork(urlString: url, requestHeaders: ["Accept-Language": "it"])
+        _ = request.dataTaskNetwork(urlString: url, requestHeaders: ["Accept-Language": "en"])
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.misses, 2)
+        XCTAssertEqual(statistics.hits, 2)
+    }
+
+    func testPostRequestsAreNotCached() throws {
+        XCTAssert(app.httpCacheEnable())
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/post", httpMethod: "POST", httpBody: "param=1")
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.misses, 0)
+        XCTAssertEqual(statistics.hits, 0)
+    }
+}
+
+extension HTTPCacheTests {
+    override func setUp() {
+        SBTUITestTunnelServer.perform(NSSelectorFromString("_connectionlessReset"))
+        app.launchConnectionless { path, params -> String in
+            SBTUITestTunnelServer.performCommand(path, params: params)
+        }
+        app.httpCacheClear()
+    }
+}
+
+class HTTPCachePersistenceTests: XCTestCase {
+    private let cacheableMatch = SBTRequestMatch(url: "postman-echo.com/response-headers")
+
+    func testCachedResponsesArePersistedAcrossLaunches() throws {
+        app.launchTunnel(withOptions: [SBTUITunneledApplicationLaunchOptionEnableHTTPCache])
+        XCTAssert(app.httpCacheClear())
+
+        app.monitorRequests(matching: cacheableMatch)
+        app.cells["executeCacheableDataTaskRequest"].tap()
+        XCTAssert(app.waitForMonitoredRequests(matching: cacheableMatch, timeout: 10.0))
+        XCTAssertEqual(try XCTUnwrap(app.httpCacheStatistics()).misses, 1)
+
+        app.terminate()
+        XCTAssert(app.wait(for: .notRunning, timeout: 5))
+
+        // counters start from zero in the new process, the response comes from disk
+        app.launchTunnel(withOptions: [SBTUITunneledApplicationLaunchOptionEnableHTTPCache])
+        app.monitorRequests(matching: cacheableMatch)
+        app.cells["executeCacheableDataTaskRequest"].tap()
+        XCTAssert(app.waitForMonitoredRequests(matching: cacheableMatch, timeout: 10.0))
+
+        let statistics = try XCTUnwrap(app.httpCacheStatistics())
+        XCTAssertEqual(statistics.hits, 1)
+        XCTAssertEqual(statistics.misses, 0)
+    }
+}
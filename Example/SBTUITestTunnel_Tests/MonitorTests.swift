@@ -361,6 +361,23 @@ class MonitorTests: XCTestCase {
         XCTAssertFalse(app.waitForMonitoredRequests(matching: SBTRequestMatch(url: "postman-echo.com"), timeout: 10.0, iterations: 2))
     }
 
+    func testSyncWaitForMonitoredRequestsReturnsAsSoonAsRequestCompletes() {
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+        app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com"), response: SBTStubResponse(response: ["stubbed": 1], responseTime: 0.0))
+
+        let start = Date()
+        DispatchQueue.global(qos: .userInitiated).asyncAfter(deadline: .now() + 1.0) { [weak self] in
+            _ = self?.request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1&param2=val2")
+        }
+
+        XCTAssert(app.waitForMonitoredRequests(matching: SBTRequestMatch(url: "postman-echo.com"), timeout: 10.0))
+        let delta = -start.timeIntervalSinceNow
+
+        // the wait must return with the request, well before the timeout expires. The bound is wide on purpose,
+        // simulator scheduling makes tighter wall-clock windows flaky
+        XCTAssert(delta >= 1.0 && delta < 5.0, "Failed with delta: \(delta)")
+    }
+
     func testRedirectForMonitoredRequestShouldMatch() {
         let redirectMatch = SBTRequestMatch(url: "postman-echo.com")
         app.monitorRequests(matching: redirectMatch)
@@ -398,6 +415,198 @@ class MonitorTests: XCTestCase {
         let responseString = monitoredRequest.responseString() ?? ""
         XCTAssert(responseString.contains(testBody), "Response body does not contain expected body")
     }
+
+    func testMonitorFetchSinceSequenceNumber() {
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=1")
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=2")
+
+        let firstRequests = app.monitoredRequestsSinceSequenceNumber(0)
+        XCTAssertEqual(firstRequests.count, 2)
+        XCTAssertLessThan(firstRequests[0].sequenceNumber, firstRequests[1].sequenceNumber)
+
+        let cursor = firstRequests.last?.sequenceNumber ?? 0
+        XCTAssertEqual(app.monitoredRequestsSinceSequenceNumber(cursor).count, 0)
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=3")
+
+        let newRequests = app.monitoredRequestsSinceSequenceNumber(cursor)
+        XCTAssertEqual(newRequests.map { $0.request?.url?.query }, ["index=3"])
+        XCTAssertGreaterThan(newRequests.first?.sequenceNumber ?? 0, cursor)
+
+        // fetching doesn't clear collected requests
+        XCTAssertEqual(app.monitoredRequestsFlushAll().count, 3)
+        XCTAssertEqual(app.monitoredRequestsSinceSequenceNumber(0).count, 0)
+    }
+
+    func testMonitorSummariesAndBodyRetrieval() {
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1")
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/post", httpMethod: "POST", httpBody: "param2=val2")
+
+        let peekedSummaries = app.monitoredRequestSummariesPeekAll()
+        XCTAssertEqual(peekedSummaries.map { $0.httpMethod }, ["GET", "POST"])
+        XCTAssertEqual(app.monitoredRequestsPeekAll().count, 2)
+
+        let summaries = app.monitoredRequestSummariesFlushAll()
+        XCTAssertEqual(summaries.count, 2)
+        XCTAssertEqual(app.monitoredRequestsFlushAll().count, 0)
+
+        let getSummary = summaries[0]
+        XCTAssertEqual(getSummary.statusCode, 200)
+        XCTAssertEqual(getSummary.url?.absoluteString, "https://postman-echo.com/get?param1=val1")
+        XCTAssert(getSummary.requestTime > 0.0)
+
+        // bodies of flushed requests can still be retrieved
+        let responseData = app.monitoredRequestResponseData(withSequenceNumber: getSummary.sequenceNumber) ?? Data()
+        XCTAssertEqual(responseData.count, getSummary.responseBodyLength)
+        XCTAssert(String(decoding: responseData, as: UTF8.self).contains("val1"))
+
+        let postSummary = summaries[1]
+        let requestData = app.monitoredRequestRequestData(withSequenceNumber: postSummary.sequenceNumber) ?? Data()
+        XCTAssertEqual(String(decoding: requestData, as: UTF8.self), "param2=val2")
+
+        XCTAssertNil(app.monitoredRequestResponseData(withSequenceNumber: 1000))
+    }
+
+    func testMonitorEventStream() {
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+        XCTAssert(app.monitoredRequestsSubscribe())
+
+        for index in 1 ... 3 {
+            _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=\(index)")
+        }
+
+        let start = Date()
+        while app.monitoredRequestsEventsPeekAll().count < 3, Date().timeIntervalSince(start) < 5.0 {
+            RunLoop.main.run(until: Date(timeIntervalSinceNow: 0.05))
+        }
+
+        let events = app.monitoredRequestsEventsFlushAll()
+        XCTAssertEqual(events.map { $0.url?.query }, ["index=1", "index=2", "index=3"])
+        XCTAssert(events.allSatisfy { $0.statusCode == 200 && $0.httpMethod == "GET" && $0.responseBodyLength > 0 })
+        XCTAssert(events.allSatisfy { $0.matches(SBTRequestMatch(url: "postman-echo.com/get")) })
+        XCTAssertEqual(app.monitoredRequestsEventsDroppedCount(), 0)
+        XCTAssertEqual(app.monitoredRequestsEventsPeekAll().count, 0)
+
+        XCTAssert(app.monitoredRequestsUnsubscribe())
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=4")
+        RunLoop.main.run(until: Date(timeIntervalSinceNow: 0.5))
+        XCTAssertEqual(app.monitoredRequestsEventsPeekAll().count, 0)
+
+        // requests are still collected by the app
+        XCTAssertEqual(app.monitoredRequestsFlushAll().count, 4)
+    }
+
+    func testMonitorTimingBreakdown() throws {
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+        app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com/post"), response: SBTStubResponse(response: ["stubbed": 1]))
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=1")
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=2")
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/post", httpMethod: "POST", httpBody: "param=val")
+
+        let requests = app.monitoredRequestsPeekAll()
+        XCTAssertEqual(requests.count, 3)
+        XCTAssertNil(requests[2].timing)
+
+        let timing = try XCTUnwrap(requests[0].timing)
+        XCTAssertGreaterThan(timing.totalDuration, 0.0)
+        XCTAssertGreaterThan(timing.timeToFirstByte, 0.0)
+        XCTAssertGreaterThan(timing.responseBodyBytes, 0)
+        XCTAssertNotNil(timing.networkProtocolName)
+        XCTAssertLessThanOrEqual(timing.domainLookupDuration + timing.connectDuration + timing.secureConnectionDuration + timing.timeToFirstByte, timing.totalDuration)
+
+        let endpointTimings = app.monitoredRequestsTimingByEndpoint()
+        XCTAssertEqual(endpointTimings.map { $0.endpoint }, ["GET postman-echo.com/get"])
+        XCTAssertEqual(endpointTimings.first?.count, 2)
+        XCTAssertGreaterThanOrEqual(endpointTimings.first?.maximumDuration ?? 0.0, endpointTimings.first?.averageTiming.totalDuration ?? 0.0)
+    }
+
+    func testMonitorCapacityDropsOldest() {
+        XCTAssert(app.monitoredRequestsSetCapacity(2, overflowPolicy: .dropOldest))
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+
+        for index in 1 ... 3 {
+            _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=\(index)")
+        }
+
+        let statistics = app.monitoredRequestsStatistics()
+        XCTAssertEqual(statistics?.capacity, 2)
+        XCTAssertEqual(statistics?.count, 2)
+        XCTAssertEqual(statistics?.droppedCount, 1)
+        XCTAssertEqual(statistics?.spilledCount, 0)
+
+        let requests = app.monitoredRequestsFlushAll()
+        XCTAssertEqual(requests.map { $0.request?.url?.query }, ["index=2", "index=3"])
+    }
+
+    func testMonitorCapacitySpillsToDisk() {
+        XCTAssert(app.monitoredRequestsSetCapacity(2, overflowPolicy: .spillToDisk))
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+
+        for index in 1 ... 4 {
+            _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=\(index)")
+        }
+
+        let statistics = app.monitoredRequestsStatistics()
+        XCTAssertEqual(statistics?.count, 2)
+        XCTAssertEqual(statistics?.droppedCount, 0)
+        XCTAssertEqual(statistics?.spilledCount, 2)
+
+        XCTAssertEqual(app.monitoredRequestsPeekAll().count, 4)
+
+        let requests = app.monitoredRequestsFlushAll()
+        XCTAssertEqual(requests.map { $0.request?.url?.query }, ["index=1", "index=2", "index=3", "index=4"])
+        XCTAssert((requests.first?.responseString() ?? "").contains("postman-echo.com"))
+        XCTAssertEqual(app.monitoredRequestsFlushAll().count, 0)
+    }
+
+    func testMonitorCapturePolicyTruncatesBodies() throws {
+        let capturePolicy = SBTMonitorCapturePolicy(maximumRequestBodyLength: 4, maximumResponseBodyLength: 100, sampling: .headAndTail, compressesBodies: true)
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"), capturePolicy: capturePolicy)
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/post", httpMethod: "POST", httpBody: "param1=val1")
+
+        let requests = app.monitoredRequestsFlushAll()
+        XCTAssertEqual(requests.count, 1)
+
+        let monitoredRequest = try XCTUnwrap(requests.first)
+        XCTAssert(monitoredRequest.isRequestDataTruncated)
+        XCTAssertEqual(monitoredRequest.requestDataOriginalLength, 11)
+        // the first and the last 2 bytes of "param1=val1"
+        XCTAssertEqual(monitoredRequest.requestData, Data("pal1".utf8))
+
+        XCTAssert(monitoredRequest.isResponseDataTruncated)
+        XCTAssertGreaterThan(monitoredRequest.responseDataOriginalLength, 100)
+        XCTAssertEqual(monitoredRequest.responseData?.count, 100)
+        XCTAssertEqual(monitoredRequest.bodySampling, .headAndTail)
+        XCTAssert(monitoredRequest.responseString()?.hasPrefix("{") ?? false)
+    }
+
+    func testMonitorTraceRotatesAndDownloads() throws {
+        app.monitorRequests(matching: SBTRequestMatch(url: "postman-echo.com"))
+        // every entry exceeds 1 byte so each one is written to its own file, only the last 2 are kept
+        XCTAssert(app.monitoredRequestsTraceStart(withMaximumFileSize: 1, maximumFileCount: 2))
+
+        for index in 1 ... 3 {
+            _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=\(index)")
+        }
+
+        XCTAssert(app.monitoredRequestsTraceStop())
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?index=4")
+
+        let traceURL = FileManager.default.temporaryDirectory.appendingPathComponent("trace.ndjson")
+        XCTAssert(app.monitoredRequestsTraceDownload(to: traceURL))
+
+        let lines = try String(contentsOf: traceURL).split(separator: "\n")
+        let entries = try lines.map { try XCTUnwrap(JSONSerialization.jsonObject(with: Data($0.utf8)) as? [String: Any]) }
+        let urls = entries.map { ($0["request"] as? [String: Any])?["url"] as? String }
+        XCTAssertEqual(urls, ["https://postman-echo.com/get?index=2", "https://postman-echo.com/get?index=3"])
+        XCTAssertEqual((entries.first?["response"] as? [String: Any])?["status"] as? Int, 200)
+    }
 }
 
 extension MonitorTests {
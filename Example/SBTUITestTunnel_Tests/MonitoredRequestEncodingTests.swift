@@ -0,0 +1,119 @@
+// MonitoredRequestEncodingTests.swift
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import Foundation
+import SBTUITestTunnelCommon
+import XCTest
+
+class MonitoredRequestEncodingTests: XCTestCase {
+    private lazy var requests: [SBTMonitoredNetworkRequest] = (1 ... 1000).map { makeMonitoredRequest(sequenceNumber: $0) }
+
+    func testBinaryEncodingRoundtrip() throws {
+        let request = makeMonitoredRequest(sequenceNumber: 42)
+        request.isStubbed = true
+
+        let data = SBTMonitoredNetworkRequestBinaryCoder.data(withRequests: [request], compressBodies: true)
+        XCTAssert(SBTMonitoredNetworkRequestBinaryCoder.isBinaryEncodedData(data))
+
+        let decoded = try XCTUnwrap(SBTMonitoredNetworkRequestBinaryCoder.requests(with: data).first)
+
+        XCTAssertEqual(decoded.sequenceNumber, 42)
+        XCTAssertEqual(decoded.timestamp, request.timestamp)
+        XCTAssertEqual(decoded.requestTime, request.requestTime)
+        XCTAssert(decoded.isStubbed)
+        XCTAssertFalse(decoded.isRewritten)
+        XCTAssertEqual(decoded.request?.url, request.request?.url)
+        XCTAssertEqual(decoded.request?.httpMethod, "POST")
+        XCTAssertEqual(decoded.request?.value(forHTTPHeaderField: "Content-Type"), "application/json")
+        XCTAssertEqual(decoded.request?.httpBody, request.request?.httpBody)
+        XCTAssertEqual(decoded.response?.statusCode, 201)
+        XCTAssertEqual(decoded.response?.value(forHTTPHeaderField: "X-Request-Id"), "42")
+        XCTAssertEqual(decoded.requestData, request.requestData)
+        XCTAssertEqual(decoded.responseData, request.responseData)
+        XCTAssertEqual(decoded.timing?.timeToFirstByte, 0.2)
+        XCTAssertEqual(decoded.timing?.responseBodyBytes, Int64(request.responseData?.count ?? 0))
+        XCTAssertEqual(decoded.timing?.networkProtocolName, "h2")
+    }
+
+    func testBinaryEncodingIsSmallerThanKeyedArchive() throws {
+        let binaryData = SBTMonitoredNetworkRequestBinaryCoder.data(withRequests: requests, compressBodies: true)
+        let archivedData = try NSKeyedArchiver.archivedData(withRootObject: requests, requiringSecureCoding: true)
+
+        XCTAssertLessThan(binaryData.count, archivedData.count)
+        XCTAssertFalse(SBTMonitoredNetworkRequestBinaryCoder.isBinaryEncodedData(archivedData))
+    }
+
+    func testBinaryEncodingPerformance() {
+        let requests = requests
+        measure {
+            _ = SBTMonitoredNetworkRequestBinaryCoder.data(withRequests: requests, compressBodies: true)
+        }
+    }
+
+    func testBinaryDecodingPerformance() {
+        let data = SBTMonitoredNetworkRequestBinaryCoder.data(withRequests: requests, compressBodies: true)
+        measure {
+            XCTAssertEqual(try? SBTMonitoredNetworkRequestBinaryCoder.requests(with: data).count, 1000)
+        }
+    }
+
+    func testKeyedArchiveEncodingPerformance() {
+        let requests = requests
+        measure {
+            _ = try? NSKeyedArchiver.archivedData(withRootObject: requests, requiringSecureCoding: true)
+        }
+    }
+
+    func testKeyedArchiveDecodingPerformance() throws {
+        let data = try NSKeyedArchiver.archivedData(withRootObject: requests, requiringSecureCoding: true)
+        measure {
+            let decoded = try? NSKeyedUnarchiver.unarchivedObject(ofClasses: [NSArray.self, SBTMonitoredNetworkRequest.self], from: data) as? [SBTMonitoredNetworkRequest]
+            XCTAssertEqual(decoded?.count, 1000)
+        }
+    }
+
+    private func makeMonitoredRequest(sequenceNumber: Int) -> SBTMonitoredNetworkRequest {
+        let url = URL(string: "https://postman-echo.com/post?page=\(sequenceNumber)")!
+
+        var urlRequest = URLRequest(url: url)
+        urlRequest.httpMethod = "POST"
+        urlRequest.setValue("application/json", forHTTPHeaderField: "Content-Type")
+        urlRequest.setValue("SBTUITestTunnel", forHTTPHeaderField: "User-Agent")
+        urlRequest.httpBody = Data(#"{"page":\#(sequenceNumber)}"#.utf8)
+
+        let responseBody = Data(String(repeating: #"{"id":\#(sequenceNumber),"name":"item"},"#, count: 50).utf8)
+
+        let request = SBTMonitoredNetworkRequest()
+        request.sequenceNumber = UInt(sequenceNumber)
+        request.timestamp = 1_700_000_000 + Double(sequenceNumber)
+        request.requestTime = 0.25
+        request.request = urlRequest
+        request.originalRequest = urlRequest
+        request.response = HTTPURLResponse(url: url, statusCode: 201, httpVersion: "HTTP/1.1",
+                                           headerFields: ["Content-Type": "application/json", "X-Request-Id": "\(sequenceNumber)"])
+        request.requestData = urlRequest.httpBody
+        request.responseData = responseBody
+
+        let timing = SBTMonitoredNetworkRequestTiming()
+        timing.timeToFirstByte = 0.2
+        timing.totalDuration = 0.25
+        timing.responseBodyBytes = Int64(responseBody.count)
+        timing.networkProtocolName = "h2"
+        request.timing = timing
+
+        return request
+    }
+}
@@ -0,0 +1,78 @@
+// NetworkStatisticsTests.swift
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import Foundation
+import SBTUITestTunnelClient
+import SBTUITestTunnelServer
+import XCTest
+
+class NetworkStatisticsTests: XCTestCase {
+    private let request = NetworkRequests()
+
+    func testStatisticsAreGroupedByPathTemplate() throws {
+        app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com/users"), response: SBTStubResponse(response: ["stubbed": 1], responseTime: 0.1))
+        app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com/missing"), response: SBTStubResponse(response: ["stubbed": 1], returnCode: 404))
+
+        for id in [1, 22, 333] {
+            _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/users/\(id)/posts")
+        }
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/users/0f8fad5b-d9cb-469f-a165-70867728950e/posts")
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/missing")
+
+        let statistics = app.networkStatistics()
+        XCTAssertEqual(statistics.map { $0.pathTemplate }, ["/users/{id}/posts", "/missing"])
+
+        let usersStatistics = try XCTUnwrap(statistics.first)
+        XCTAssertEqual(usersStatistics.host, "postman-echo.com")
+        XCTAssertEqual(usersStatistics.requestCount, 4)
+        XCTAssertEqual(usersStatistics.failureCount, 0)
+        XCTAssertGreaterThan(usersStatistics.bytesReceived, 0)
+        XCTAssertEqual(usersStatistics.p50Latency, 0.1, accuracy: 0.1 / 16)
+        XCTAssertEqual(usersStatistics.p99Latency, 0.1, accuracy: 0.1 / 16)
+        XCTAssertLessThanOrEqual(usersStatistics.p99Latency, usersStatistics.maximumLatency)
+
+        XCTAssertEqual(statistics.last?.failureCount, 1)
+    }
+
+    func testNetworkRequestsAreCounted() throws {
+        app.throttleRequests(matching: SBTRequestMatch(url: "postman-echo.com"), responseTime: 0.0)
+
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1")
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/post", httpMethod: "POST", httpBody: "param2=val2")
+
+        let statistics = app.networkStatistics()
+        XCTAssertEqual(Set(statistics.map { $0.pathTemplate }), ["/get", "/post"])
+        XCTAssert(statistics.allSatisfy { $0.requestCount == 1 && $0.bytesSent > 0 && $0.bytesReceived > 0 && $0.p50Latency > 0.0 })
+    }
+
+    func testStatisticsReset() {
+        app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com"), response: SBTStubResponse(response: ["stubbed": 1]))
+        _ = request.dataTaskNetwork(urlString: "https://postman-echo.com/get")
+        XCTAssertEqual(app.networkStatistics().count, 1)
+
+        XCTAssert(app.networkStatisticsReset())
+        XCTAssertEqual(app.networkStatistics().count, 0)
+    }
+}
+
+extension NetworkStatisticsTests {
+    override func setUp() {
+        SBTUITestTunnelServer.perform(NSSelectorFromString("_connectionlessReset"))
+        app.launchConnectionless { path, params -> String in
+            SBTUITestTunnelServer.performCommand(path, params: params)
+        }
+    }
+}
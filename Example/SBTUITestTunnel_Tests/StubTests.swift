@@ -33,6 +33,21 @@ class StubTests: XCTestCase {
         XCTAssertFalse(request.isStubbed(result2, expectedStubValue: 1))
     }
 
+    func testStubRemoveWithIDs() {
+        let stubIds = (0 ..< 20).compactMap { index in
+            app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com/\(index)"), response: SBTStubResponse(response: ["stubbed": index]))
+        }
+        XCTAssertEqual(app.stubRequestsAll().count, 20)
+
+        XCTAssert(app.stubRequestsRemove(ids: stubIds))
+        XCTAssert(app.stubRequestsAll().isEmpty)
+
+        // all identifiers are processed even if one of them isn't active
+        let stubId = app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com"), response: SBTStubResponse(response: ["stubbed": 1]))!
+        XCTAssertFalse(app.stubRequestsRemove(ids: [stubIds[0], stubId]))
+        XCTAssert(app.stubRequestsAll().isEmpty)
+    }
+
     func testStubRemoveAll() {
         app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com"), response: SBTStubResponse(response: ["stubbed": 1]))
 
@@ -801,6 +816,67 @@ class StubTests: XCTestCase {
             XCTAssertEqual(app.stubRequestsAll().count, 0)
         }
     }
+
+    func testStubWithHAR() throws {
+        let stubId = try XCTUnwrap(app.stubRequests(withHAR: harData()))
+
+        let result = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param2=val2&param1=val1")
+        XCTAssert(request.isStubbed(result, expectedStubValue: 1))
+        XCTAssertEqual(request.returnCode(result), 200)
+
+        let notArchived = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1")
+        XCTAssertFalse(request.isStubbed(notArchived, expectedStubValue: 1))
+
+        XCTAssert(app.stubRequestsRemove(id: stubId))
+        let result2 = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1&param2=val2")
+        XCTAssertFalse(request.isStubbed(result2, expectedStubValue: 1))
+    }
+
+    func testStubWithHARRepeatedRequests() {
+        app.stubRequests(withHAR: harData(stubValues: [1, 2]))
+
+        let result = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1&param2=val2")
+        XCTAssert(request.isStubbed(result, expectedStubValue: 1))
+        let result2 = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1&param2=val2")
+        XCTAssert(request.isStubbed(result2, expectedStubValue: 2))
+        let result3 = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1&param2=val2")
+        XCTAssert(request.isStubbed(result3, expectedStubValue: 2))
+    }
+
+    func testStubWithHARIgnoringQuery() {
+        let normalization = SBTRequestNormalization(includesQuery: false, ignoredQueryItems: nil, includesBody: true, headers: nil)
+        app.stubRequests(withHAR: harData(), normalization: normalization)
+
+        let result = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param3=val3")
+        XCTAssert(request.isStubbed(result, expectedStubValue: 1))
+    }
+
+    func testStubWithHARRemoveAll() {
+        app.stubRequests(withHAR: harData())
+        XCTAssert(app.stubRequestsRemoveAll())
+
+        let result = request.dataTaskNetwork(urlString: "https://postman-echo.com/get?param1=val1&param2=val2")
+        XCTAssertFalse(request.isStubbed(result, expectedStubValue: 1))
+    }
+
+    private func harData(stubValues: [Int] = [1]) -> Data {
+        let entries: [[String: Any]] = stubValues.map { stubValue in
+            [
+                "request": [
+                    "method": "GET",
+                    "url": "https://postman-echo.com/get?param1=val1&param2=val2",
+                    "headers": [["name": "Accept", "value": "*/*"]]
+                ],
+                "response": [
+                    "status": 200,
+                    "headers": [["name": "Content-Type", "value": "application/json"], ["name": "Content-Encoding", "value": "gzip"]],
+                    "content": ["mimeType": "application/json", "text": "{\"stubbed\": \(stubValue)}"]
+                ]
+            ]
+        }
+
+        return try! JSONSerialization.data(withJSONObject: ["log": ["version": "1.2", "entries": entries]])
+    }
 }
 
 extension StubTests {
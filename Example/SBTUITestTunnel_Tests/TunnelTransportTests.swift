@@ -0,0 +1,234 @@
+// TunnelTransportTests.swift
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import Foundation
+import SBTUITestTunnelClient
+import SBTUITestTunnelServer
+import XCTest
+
+class TunnelTransportTests: XCTestCase {
+    private let roundTrips = 200
+
+    func testCommandsOverFrameTunnel() {
+        app.launchTunnel()
+
+        assertRoundTrips()
+    }
+
+    func testCommandsOverTCPFrameTunnel() {
+        app.launchTunnel(withOptions: [SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel])
+
+        assertRoundTrips()
+    }
+
+    func testCommandsOverHTTPTunnel() {
+        app.launchTunnel(withOptions: [SBTUITunneledApplicationLaunchOptionDisableFrameTunnel])
+
+        assertRoundTrips()
+    }
+
+    func testFrameTunnelRoundTripPerformance() {
+        // on the simulator frames go through a unix domain socket
+        app.launchTunnel()
+
+        measure {
+            for _ in 0 ..< roundTrips {
+                XCTAssert(app.stubRequestsRemoveAll())
+            }
+        }
+    }
+
+    func testTCPFrameTunnelRoundTripPerformance() {
+        app.launchTunnel(withOptions: [SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel])
+
+        measure {
+            for _ in 0 ..< roundTrips {
+                XCTAssert(app.stubRequestsRemoveAll())
+            }
+        }
+    }
+
+    func testHTTPTunnelRoundTripPerformance() {
+        app.launchTunnel(withOptions: [SBTUITunneledApplicationLaunchOptionDisableFrameTunnel])
+
+        measure {
+            for _ in 0 ..< roundTrips {
+                XCTAssert(app.stubRequestsRemoveAll())
+            }
+        }
+    }
+
+    func testBackgroundThreadCommands() {
+        app.launchTunnel()
+
+        let expectation = expectation(description: "Commands completed")
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            for _ in 0 ..< 50 {
+                guard let stubId = app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com"), response: SBTStubResponse(response: ["stubbed": 1])) else {
+                    XCTFail("Failed stubbing from a background thread")
+                    break
+                }
+                XCTAssert(app.stubRequestsRemove(id: stubId))
+            }
+            expectation.fulfill()
+        }
+
+        wait(for: [expectation], timeout: 60.0)
+    }
+
+    func testBackgroundThreadCommandPerformance() {
+        app.launchTunnel()
+
+        // commands used to wait for 0.5s run loop slices when sent off the main thread
+        measure {
+            let expectation = expectation(description: "Commands completed")
+            DispatchQueue.global(qos: .userInitiated).async {
+                for _ in 0 ..< 50 {
+                    XCTAssert(app.stubRequestsRemoveAll())
+                }
+                expectation.fulfill()
+            }
+            wait(for: [expectation], timeout: 60.0)
+        }
+    }
+
+    func testIPCCommandLatencyHistogram() throws {
+        app.launchTunnel()
+
+        try XCTSkipIf(app.launchEnvironment[SBTUITunneledApplicationLaunchEnvironmentIPCKey] == nil, "Tunnel is not using IPC")
+
+        let initialCount = app.ipcCommandLatencyHistogram().values.reduce(0) { $0 + $1.intValue }
+        for _ in 0 ..< roundTrips {
+            XCTAssert(app.stubRequestsRemoveAll())
+        }
+
+        let histogram = app.ipcCommandLatencyHistogram()
+        let count = histogram.values.reduce(0) { $0 + $1.intValue } - initialCount
+        XCTAssertEqual(count, roundTrips)
+
+        // replies used to be picked up in 0.5s slices, none should take that long
+        let slowCount = histogram.filter { $0.key.doubleValue > 0.5 }.values.reduce(0) { $0 + $1.intValue }
+        XCTAssertEqual(slowCount, 0)
+    }
+
+    func testIPCCommandPerformance() throws {
+        app.launchTunnel()
+
+        try XCTSkipIf(app.launchEnvironment[SBTUITunneledApplicationLaunchEnvironmentIPCKey] == nil, "Tunnel is not using IPC")
+
+        measure {
+            for _ in 0 ..< roundTrips {
+                XCTAssert(app.stubRequestsRemoveAll())
+            }
+        }
+    }
+
+    func testLaunchPerformance() {
+        // the app signals when it's ready, launching no longer waits for the runner to poll its port
+        measure {
+            app.launchTunnel()
+            XCTAssert(app.stubRequestsRemoveAll())
+            app.terminate()
+        }
+    }
+
+    func testAsynchronousCommandsAreExecutedInOrder() {
+        app.launchTunnel()
+
+        let lock = NSLock()
+        var stubIds = [String]()
+        var completedIndexes = [Int]()
+        for index in 0 ..< 50 {
+            app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com/\(index)"), response: SBTStubResponse(response: ["stubbed": index])) { stubId in
+                lock.lock()
+                stubId.map { stubIds.append($0) }
+                completedIndexes.append(index)
+                lock.unlock()
+            }
+        }
+        // synchronous commands are queued after those in flight, stubs are installed in the order they were sent (newest first)
+        let expectedUrls = (0 ..< 50).reversed().map { "postman-echo.com/\($0)" }
+        XCTAssertEqual(app.stubRequestsAll().map { $0.match.url ?? "" }, expectedUrls)
+
+        XCTAssert(app.waitForPendingCommands())
+        XCTAssertEqual(completedIndexes, Array(0 ..< 50))
+        XCTAssertEqual(Set(stubIds).count, 50)
+
+        for stubId in stubIds {
+            app.stubRequestsRemove(id: stubId) { removed in
+                XCTAssert(removed)
+            }
+        }
+        XCTAssert(app.waitForPendingCommands())
+        XCTAssert(app.stubRequestsAll().isEmpty)
+    }
+
+    func testAsynchronousStubPerformance() {
+        app.launchTunnel()
+
+        measure {
+            for index in 0 ..< 50 {
+                app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com/\(index)"), response: SBTStubResponse(response: ["stubbed": index]), completion: nil)
+            }
+            XCTAssert(app.waitForPendingCommands())
+            XCTAssert(app.stubRequestsRemoveAll())
+        }
+    }
+
+    func testConcurrentHTTPCommands() throws {
+        app.launchTunnel(withOptions: [SBTUITunneledApplicationLaunchOptionDisableFrameTunnel])
+
+        guard let port = app.launchEnvironment[SBTUITunneledApplicationLaunchEnvironmentPortKey] else {
+            throw XCTSkip("The tunnel is using IPC")
+        }
+
+        // the client serializes commands, so requests are sent straight to the app's HTTP server
+        let session = URLSession(configuration: .ephemeral)
+        let lock = NSLock()
+        var results = [String]()
+        let group = DispatchGroup()
+        for index in 0 ..< 100 {
+            // read-only commands run concurrently, interleaved mutations are serialized between them
+            let command = index % 10 == 0 ? SBTUITunneledApplicationCommandStubRequestsRemoveAll : SBTUITunneledApplicationCommandPing
+            var request = URLRequest(url: URL(string: "http://\(SBTUITunneledApplicationDefaultHost):\(port)/\(command)")!)
+            request.httpMethod = "POST"
+            group.enter()
+            session.dataTask(with: request) { data, _, _ in
+                let json = data.flatMap { try? JSONSerialization.jsonObject(with: $0) as? [String: Any] }
+                lock.lock()
+                results.append(json?[SBTUITunnelResponseResultKey] as? String ?? "")
+                lock.unlock()
+                group.leave()
+            }.resume()
+        }
+
+        XCTAssertEqual(group.wait(timeout: .now() + 30.0), .success)
+        XCTAssertEqual(results.count, 100)
+        XCTAssert(results.allSatisfy { $0 == "YES" })
+    }
+
+    private func assertRoundTrips() {
+        // large and binary-ish payloads must survive the transport untouched
+        let value = String(repeating: "+/=%&?", count: 50_000) + ProcessInfo.processInfo.globallyUniqueString
+        XCTAssert(app.userDefaultsSetObject(value as NSCoding & NSObjectProtocol, forKey: "transport_test"))
+        XCTAssertEqual(app.userDefaultsObject(forKey: "transport_test") as? String, value)
+
+        let stubId = app.stubRequests(matching: SBTRequestMatch(url: "postman-echo.com"), response: SBTStubResponse(response: ["stubbed": 1]))
+        XCTAssert(app.stubRequestsRemove(id: stubId!))
+        XCTAssertFalse(app.stubRequestsRemove(id: stubId!))
+    }
+}
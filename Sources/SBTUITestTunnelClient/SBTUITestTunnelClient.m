@@ -18,6 +18,7 @@
 @import SBTUITestTunnelCommon;
 
 #import "include/SBTUITestTunnelClient.h"
+#import "private/SBTTunnelFrameClient.h"
 #include <ifaddrs.h>
 #include <arpa/inet.h>
 #include <netdb.h>
@@ -29,10 +30,18 @@ const NSString *SBTUITunnelJsonMimeType = @"application/json";
 {
     BOOL _userInterfaceAnimationsEnabled;
     NSInteger _userInterfaceAnimationSpeed;
+    SBTTunnelFrameClient *_frameClient;
 }
 
 @property (nonatomic, weak) XCUIApplication *application;
 @property (nonatomic, assign) NSInteger connectionPort;
+@property (nonatomic, assign) NSInteger framePort;
+@property (nonatomic, copy) NSString *frameSocketPath;
+@property (nonatomic, strong) SBTTunnelFrameClient *frameClient;
+@property (nonatomic, strong) dispatch_queue_t commandQueue;
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
+@property (nonatomic, strong) dispatch_group_t pendingCommandsGroup;
+@property (nonatomic, strong) NSMapTable<NSString *, NSData *> *serializedParametersData;
 @property (nonatomic, assign) BOOL connected;
 @property (nonatomic, assign) NSTimeInterval connectionTimeout;
 @property (nonatomic, strong) NSMutableArray *stubOnceIds;
@@ -44,6 +53,11 @@ const NSString *SBTUITunnelJsonMimeType = @"application/json";
 @property (nonatomic, strong) DTXIPCConnection* ipcConnection;
 @property (nonatomic, strong) id<SBTIPCTunnel> ipcProxy;
 @property (nonatomic, assign) NSTimeInterval launchStart;
+@property (nonatomic, strong) NSURLSessionTask *monitoredRequestsEventsTask;
+@property (nonatomic, strong) NSMutableArray<SBTMonitoredNetworkRequestSummary *> *monitoredRequestsEvents;
+@property (nonatomic, assign) NSUInteger monitoredRequestsEventsLastSequenceNumber;
+@property (nonatomic, assign) NSUInteger monitoredRequestsEventsDroppedCount;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *ipcCommandLatencyCounts;
 
 @end
 
@@ -51,6 +65,10 @@ const NSString *SBTUITunnelJsonMimeType = @"application/json";
 
 static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
 
+// upper bounds of the IPC command latency buckets, a last bucket accounts for slower commands
+static const NSTimeInterval SBTIPCCommandLatencyBucketBounds[] = {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+static const NSUInteger SBTIPCCommandLatencyBucketCount = sizeof(SBTIPCCommandLatencyBucketBounds) / sizeof(SBTIPCCommandLatencyBucketBounds[0]) + 1;
+
 - (instancetype)initWithApplication:(XCUIApplication *)application
 {
     self = [super init];
@@ -61,6 +79,11 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
         _application = application;
         _userInterfaceAnimationsEnabled = YES;
         _userInterfaceAnimationSpeed = 1;
+        _commandQueue = dispatch_queue_create("com.sbtuitesttunnel.client.queue.command", DISPATCH_QUEUE_SERIAL);
+        _completionQueue = dispatch_queue_create("com.sbtuitesttunnel.client.queue.completion", DISPATCH_QUEUE_SERIAL);
+        _pendingCommandsGroup = dispatch_group_create();
+        _serializedParametersData = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        _ipcCommandLatencyCounts = [NSMutableArray array];
         
         [self resetInternalState];
     }
@@ -78,7 +101,25 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     self.startupCompleted = NO;
     self.connected = NO;
     self.connectionPort = 0;
+    self.framePort = 0;
+    self.frameSocketPath = nil;
+    @synchronized (self.ipcCommandLatencyCounts) {
+        [self.ipcCommandLatencyCounts removeAllObjects];
+        for (NSUInteger i = 0; i < SBTIPCCommandLatencyBucketCount; i++) {
+            [self.ipcCommandLatencyCounts addObject:@0];
+        }
+    }
+    // dropped before disconnecting, commands in flight are failed without being reported as lost
+    SBTTunnelFrameClient *frameClient = self.frameClient;
+    self.frameClient = nil;
+    [frameClient disconnect];
     self.connectionTimeout = SBTUITunneledApplicationDefaultTimeout;
+
+    [self.monitoredRequestsEventsTask cancel];
+    self.monitoredRequestsEventsTask = nil;
+    self.monitoredRequestsEvents = [NSMutableArray array];
+    self.monitoredRequestsEventsLastSequenceNumber = 0;
+    self.monitoredRequestsEventsDroppedCount = 0;
 }
 
 - (void)shutDownWithError:(NSError *)error
@@ -156,13 +197,38 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
         }
 
         launchEnvironment[SBTUITunneledApplicationLaunchEnvironmentPortKey] = [NSString stringWithFormat: @"%ld", (long)self.connectionPort];
+
+        if (![self.application.launchArguments containsObject:SBTUITunneledApplicationLaunchOptionDisableFrameTunnel]) {
+            #if TARGET_OS_SIMULATOR
+                // app and test runner share the host filesystem, which allows skipping both TCP and the port reservation.
+                // sun_path is limited to 104 bytes so the socket can't live in the (long) simulator container paths
+                if (![self.application.launchArguments containsObject:SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel]) {
+                    self.frameSocketPath = [NSString stringWithFormat:@"/tmp/sbtuitesttunnel-%@.sock", [NSUUID UUID].UUIDString];
+                    launchEnvironment[SBTUITunneledApplicationLaunchEnvironmentFrameSocketPathKey] = self.frameSocketPath;
+                }
+            #endif
+
+            if (self.frameSocketPath == nil) {
+                self.framePort = [SBTUITestTunnelNetworkUtility reserveSocketPort];
+                if (self.framePort > 0) {
+                    launchEnvironment[SBTUITunneledApplicationLaunchEnvironmentFramePortKey] = [NSString stringWithFormat: @"%ld", (long)self.framePort];
+                }
+            }
+        }
+
+        // the app connects back to this listener as soon as its servers are listening
+        NSInteger readyPort = 0;
+        int readyListener = [SBTUITestTunnelNetworkUtility openLoopbackListenerWithPort:&readyPort];
+        if (readyListener >= 0) {
+            launchEnvironment[SBTUITunneledApplicationLaunchEnvironmentReadyPortKey] = [NSString stringWithFormat: @"%ld", (long)readyPort];
+        }
         self.application.launchEnvironment = launchEnvironment;
         
         __weak typeof(self)weakSelf = self;
-        // Start polling the server with the choosen port
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(2.0 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-            [weakSelf waitForConnection];
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            [weakSelf waitForConnectionWithReadyListener:readyListener];
             NSLog(@"[SBTUITestTunnel] HTTP tunnel did connect after, %fs", CFAbsoluteTimeGetCurrent() - self.launchStart);
+            [weakSelf connectFrameTunnel];
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 weakSelf.connected = YES;
@@ -205,37 +271,43 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     [self shutDownWithError:nil];
 }
 
+- (void)waitForConnectionWithReadyListener:(int)readyListener
+{
+    if (readyListener >= 0) {
+        // apps embedding an older server never signal readiness, keep probing their port meanwhile
+        NSTimeInterval start = CFAbsoluteTimeGetCurrent();
+        BOOL ready = NO;
+        while (!ready && CFAbsoluteTimeGetCurrent() - start < self.connectionTimeout) {
+            ready = [SBTUITestTunnelNetworkUtility acceptConnectionOnListener:readyListener timeout:0.5];
+            if (!ready && [self isServerListening] && [self ping]) {
+                close(readyListener);
+                NSLog(@"[SBTUITestTunnel] App did not signal readiness, connected by polling after %fs", CFAbsoluteTimeGetCurrent() - self.launchStart);
+                return;
+            }
+        }
+        close(readyListener);
+
+        if (!ready) {
+            return [self shutDownWithErrorMessage:@"Failed waiting for app to be ready" code:SBTUITestTunnelErrorConnectionToApplicationFailed];
+        }
+
+        NSLog(@"[SBTUITestTunnel] App signaled readiness after %fs", CFAbsoluteTimeGetCurrent() - self.launchStart);
+        if ([self ping]) {
+            return;
+        }
+    } else {
+        // Start polling the server with the choosen port
+        [NSThread sleepForTimeInterval:2.0];
+    }
+
+    [self waitForConnection];
+}
+
 - (void)waitForConnection
 {
     NSTimeInterval start = CFAbsoluteTimeGetCurrent();
     while (CFAbsoluteTimeGetCurrent() - start < self.connectionTimeout) {
-        char *hostname = "localhost";
-        
-        int sockfd;
-        struct sockaddr_in serv_addr;
-        struct hostent *server;
-        
-        sockfd = socket(AF_INET, SOCK_STREAM, 0);
-        if (sockfd < 0) {
-            return [self shutDownWithErrorMessage:@"Failed opening socket" code:SBTUITestTunnelErrorConnectionToApplicationFailed];
-        }
-        
-        server = gethostbyname(hostname);
-        if (server == NULL) {
-            return [self shutDownWithErrorMessage:@"Invalid host" code:SBTUITestTunnelErrorConnectionToApplicationFailed];
-        }
-        
-        bzero((char *) &serv_addr, sizeof(serv_addr));
-        serv_addr.sin_family = AF_INET;
-        bcopy((char *)server->h_addr,
-              (char *)&serv_addr.sin_addr.s_addr,
-              server->h_length);
-        
-        serv_addr.sin_port = htons(self.connectionPort);
-        BOOL serverUp = connect(sockfd,(struct sockaddr *) &serv_addr,sizeof(serv_addr)) >= 0;
-        close(sockfd);
-        
-        if (serverUp && [self ping]) {
+        if ([self isServerListening] && [self ping]) {
             return;
         } else {
             [NSThread sleepForTimeInterval:0.5];
@@ -245,6 +317,63 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     [self shutDownWithErrorMessage:@"Failed waiting for app to be ready" code:SBTUITestTunnelErrorConnectionToApplicationFailed];
 }
 
+- (BOOL)isServerListening
+{
+    char *hostname = "localhost";
+    
+    int sockfd;
+    struct sockaddr_in serv_addr;
+    struct hostent *server;
+    
+    sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (sockfd < 0) {
+        NSLog(@"[SBTUITestTunnel] Failed opening socket");
+        return NO;
+    }
+    
+    server = gethostbyname(hostname);
+    if (server == NULL) {
+        NSLog(@"[SBTUITestTunnel] Invalid host");
+        close(sockfd);
+        return NO;
+    }
+    
+    bzero((char *) &serv_addr, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    bcopy((char *)server->h_addr,
+          (char *)&serv_addr.sin_addr.s_addr,
+          server->h_length);
+    
+    serv_addr.sin_port = htons(self.connectionPort);
+    BOOL serverUp = connect(sockfd,(struct sockaddr *) &serv_addr,sizeof(serv_addr)) >= 0;
+    close(sockfd);
+    
+    return serverUp;
+}
+
+- (void)connectFrameTunnel
+{
+    SBTTunnelFrameClient *frameClient = nil;
+    NSString *endpoint = nil;
+    if (self.frameSocketPath != nil) {
+        frameClient = [[SBTTunnelFrameClient alloc] initWithSocketPath:self.frameSocketPath];
+        endpoint = self.frameSocketPath;
+    } else if (self.framePort > 0) {
+        frameClient = [[SBTTunnelFrameClient alloc] initWithPort:self.framePort];
+        endpoint = [NSString stringWithFormat:@"port %ld", (long)self.framePort];
+    } else {
+        return;
+    }
+
+    // the app starts listening for frames before the HTTP server, no need to retry
+    if ([frameClient connect]) {
+        self.frameClient = frameClient;
+        NSLog(@"[SBTUITestTunnel] Frame tunnel did connect on %@", endpoint);
+    } else {
+        NSLog(@"[SBTUITestTunnel] Frame tunnel not available, sending commands over HTTP");
+    }
+}
+
 // MARK: - SBTIPCTunnel
 
 - (void)serverDidConnect:(id)sender
@@ -310,6 +439,21 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     return [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandStubMatching params:params];
 }
 
+- (NSString *)stubRequestsWithHAR:(NSData *)har
+{
+    return [self stubRequestsWithHAR:har normalization:[SBTRequestNormalization defaultNormalization]];
+}
+
+- (NSString *)stubRequestsWithHAR:(NSData *)har normalization:(SBTRequestNormalization *)normalization
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelStubHARKey: [self base64SerializeData:har],
+                                                     SBTUITunnelStubHARNormalizationKey: [self base64SerializeObject:normalization]};
+    
+    NSString *stubId = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandStubHAR params:params];
+    
+    return stubId.length > 0 ? stubId : nil;
+}
+
 #pragma mark - Stub Remove Commands
 
 - (BOOL)stubRequestsRemoveWithId:(NSString *)stubId
@@ -321,12 +465,7 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
 
 - (BOOL)stubRequestsRemoveWithIds:(NSArray<NSString *> *)stubIds
 {
-    BOOL ret = YES;
-    for (NSString *stubId in stubIds) {
-        ret &= [self stubRequestsRemoveWithId:stubId];
-    }
-    
-    return ret;
+    return [self sendSynchronousBatchRemoveRequestWithPath:SBTUITunneledApplicationCommandStubRequestsRemove key:SBTUITunnelStubMatchRuleKey ids:stubIds];
 }
 
 - (BOOL)stubRequestsRemoveWithRequestMatch:(nonnull SBTRequestMatch *)match
@@ -380,12 +519,7 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
 
 - (BOOL)rewriteRequestsRemoveWithIds:(NSArray<NSString *> *)rewriteIds
 {
-    BOOL ret = YES;
-    for (NSString *rewriteId in rewriteIds) {
-        ret &= [self rewriteRequestsRemoveWithId:rewriteId];
-    }
-    
-    return ret;
+    return [self sendSynchronousBatchRemoveRequestWithPath:SBTUITunneledApplicationCommandRewriteRequestsRemove key:SBTUITunnelRewriteMatchRuleKey ids:rewriteIds];
 }
 
 - (BOOL)rewriteRequestsRemoveAll
@@ -402,12 +536,42 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     return [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorMatching params:params];
 }
 
+- (NSString *)monitorRequestsMatching:(SBTRequestMatch *)match capturePolicy:(SBTMonitorCapturePolicy *)capturePolicy
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelProxyQueryRuleKey: [self base64SerializeObject:match],
+                                                     SBTUITunnelMonitorCapturePolicyKey: [self base64SerializeObject:capturePolicy]};
+    
+    return [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorMatching params:params];
+}
+
 - (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsPeekAll
 {
-    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorPeek params:nil];
+    return [self monitoredRequestsWithPath:SBTUITunneledApplicationCommandMonitorPeek params:nil];
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsFlushAll
+{
+    return [self monitoredRequestsWithPath:SBTUITunneledApplicationCommandMonitorFlush params:nil];
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsWithPath:(NSString *)path params:(NSDictionary<NSString *, NSString *> *)params
+{
+    NSMutableDictionary<NSString *, NSString *> *encodingParams = [NSMutableDictionary dictionaryWithDictionary:params ?: @{}];
+    encodingParams[SBTUITunnelMonitorEncodingKey] = SBTUITunnelMonitorEncodingBinary;
+    
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:path params:encodingParams];
     if (objectBase64) {
         NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
         
+        // apps running an older server ignore the encoding parameter and reply with a keyed archive
+        if ([SBTMonitoredNetworkRequestBinaryCoder isBinaryEncodedData:objectData]) {
+            NSError *decodeError;
+            NSArray *result = [SBTMonitoredNetworkRequestBinaryCoder requestsWithData:objectData error:&decodeError];
+            NSAssert(decodeError == nil, @"Error decoding NSArray of SBTMonitoredNetworkRequest");
+            
+            return result ?: @[];
+        }
+        
         NSError *unarchiveError;
         NSSet *classes = [NSSet setWithObjects:[NSArray class], [SBTMonitoredNetworkRequest class], nil];
         NSArray *result = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:objectData error:&unarchiveError];
@@ -419,17 +583,100 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     return @[];
 }
 
-- (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsFlushAll
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestSummariesPeekAll
 {
-    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorFlush params:nil];
+    return [self monitoredRequestSummariesWithPath:SBTUITunneledApplicationCommandMonitorPeek];
+}
+
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestSummariesFlushAll
+{
+    return [self monitoredRequestSummariesWithPath:SBTUITunneledApplicationCommandMonitorFlush];
+}
+
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestSummariesWithPath:(NSString *)path
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelMonitorProjectionKey: SBTUITunnelMonitorProjectionSummary};
+    
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:path params:params];
     if (objectBase64) {
         NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
         
         NSError *unarchiveError;
-        NSSet *classes = [NSSet setWithObjects:[NSArray class], [SBTMonitoredNetworkRequest class], nil];
+        NSSet *classes = [NSSet setWithObjects:[NSArray class], [SBTMonitoredNetworkRequestSummary class], nil];
         NSArray *result = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:objectData error:&unarchiveError];
-        NSAssert(unarchiveError == nil, @"Error unarchiving NSArray of SBTMonitoredNetworkRequest");
+        NSAssert(unarchiveError == nil, @"Error unarchiving NSArray of SBTMonitoredNetworkRequestSummary");
+        
+        return result ?: @[];
+    }
+    
+    return @[];
+}
+
+- (NSData *)monitoredRequestRequestDataWithSequenceNumber:(NSUInteger)sequenceNumber
+{
+    return [self monitoredRequestBody:SBTUITunnelMonitorBodyRequest sequenceNumber:sequenceNumber];
+}
+
+- (NSData *)monitoredRequestResponseDataWithSequenceNumber:(NSUInteger)sequenceNumber
+{
+    return [self monitoredRequestBody:SBTUITunnelMonitorBodyResponse sequenceNumber:sequenceNumber];
+}
+
+- (NSData *)monitoredRequestBody:(NSString *)body sequenceNumber:(NSUInteger)sequenceNumber
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelMonitorSequenceNumberKey: [@(sequenceNumber) stringValue],
+                                                     SBTUITunnelMonitorBodyKey: body};
+    
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorBody params:params];
+    if (objectBase64.length > 0) {
+        return [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
+    }
+    
+    return nil;
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsSinceSequenceNumber:(NSUInteger)sequenceNumber
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelMonitorCursorKey: [@(sequenceNumber) stringValue]};
+    
+    return [self monitoredRequestsWithPath:SBTUITunneledApplicationCommandMonitorFetchSince params:params];
+}
+
+- (BOOL)monitoredRequestsSetCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelMonitorCapacityKey: [@(capacity) stringValue],
+                                                     SBTUITunnelMonitorOverflowPolicyKey: [@(overflowPolicy) stringValue]};
+    
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorConfigure params:params] boolValue];
+}
+
+- (SBTMonitoredNetworkRequestsStatistics *)monitoredRequestsStatistics
+{
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorStatistics params:nil];
+    if (objectBase64.length > 0) {
+        NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
+        
+        NSError *unarchiveError;
+        SBTMonitoredNetworkRequestsStatistics *result = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTMonitoredNetworkRequestsStatistics class] fromData:objectData error:&unarchiveError];
+        NSAssert(unarchiveError == nil, @"Error unarchiving SBTMonitoredNetworkRequestsStatistics");
+        
+        return result;
+    }
+    
+    return nil;
+}
 
+- (NSArray<SBTMonitoredNetworkEndpointTiming *> *)monitoredRequestsTimingByEndpoint
+{
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorTimingByEndpoint params:nil];
+    if (objectBase64) {
+        NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
+        
+        NSError *unarchiveError;
+        NSSet *classes = [NSSet setWithObjects:[NSArray class], [SBTMonitoredNetworkEndpointTiming class], [SBTMonitoredNetworkRequestTiming class], nil];
+        NSArray *result = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:objectData error:&unarchiveError];
+        NSAssert(unarchiveError == nil, @"Error unarchiving NSArray of SBTMonitoredNetworkEndpointTiming");
+        
         return result ?: @[];
     }
     
@@ -445,12 +692,7 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
 
 - (BOOL)monitorRequestRemoveWithIds:(NSArray<NSString *> *)reqIds
 {
-    BOOL ret = YES;
-    for (NSString *reqId in reqIds) {
-        ret &= [self monitorRequestRemoveWithId:reqId];
-    }
-    
-    return ret;
+    return [self sendSynchronousBatchRemoveRequestWithPath:SBTUITunneledApplicationCommandMonitorRemove key:SBTUITunnelProxyQueryRuleKey ids:reqIds];
 }
 
 - (BOOL)monitorRequestRemoveAll
@@ -458,6 +700,219 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorRemoveAll params:nil] boolValue];
 }
 
+#pragma mark - Monitor Requests Event Stream
+
+- (BOOL)monitoredRequestsSubscribe
+{
+    return [self monitoredRequestsSubscribeLossy:NO];
+}
+
+- (BOOL)monitoredRequestsSubscribeLossy:(BOOL)lossy
+{
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        [self monitoredRequestsUnsubscribe];
+        
+        // requests completed while unsubscribed weren't dropped, gaps are only counted within a subscription
+        @synchronized (self.monitoredRequestsEvents) {
+            self.monitoredRequestsEventsLastSequenceNumber = 0;
+            self.monitoredRequestsEventsDroppedCount = 0;
+        }
+        
+        NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelMonitorLossyKey: lossy ? @"YES" : @"NO"};
+        
+        NSInteger port = [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorSubscribe params:params] integerValue];
+        if (port <= 0) {
+            return NO;
+        }
+        
+        NSURL *url = [NSURL URLWithString:[NSString stringWithFormat:@"ws://%@:%ld", SBTUITunneledApplicationDefaultHost, (long)port]];
+        NSURLSessionWebSocketTask *task = [[NSURLSession sharedSession] webSocketTaskWithURL:url];
+        self.monitoredRequestsEventsTask = task;
+        [task resume];
+        [self receiveMonitoredRequestsEventOnTask:task];
+        
+        // the app replies to pings once the subscriber is connected, events published before would be dropped or delayed
+        dispatch_semaphore_t connectedSemaphore = dispatch_semaphore_create(0);
+        __block BOOL connected = NO;
+        [task sendPingWithPongReceiveHandler:^(NSError *error) {
+            connected = (error == nil);
+            dispatch_semaphore_signal(connectedSemaphore);
+        }];
+        
+        if (dispatch_semaphore_wait(connectedSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SBTUITunneledApplicationDefaultTimeout * NSEC_PER_SEC))) != 0) {}
+        
+        return connected;
+    }
+    
+    return NO;
+}
+
+- (void)receiveMonitoredRequestsEventOnTask:(NSURLSessionWebSocketTask *)task API_AVAILABLE(ios(13.0), tvos(13.0))
+{
+    __weak typeof(self) weakSelf = self;
+    [task receiveMessageWithCompletionHandler:^(NSURLSessionWebSocketMessage *message, NSError *error) {
+        if (error) {
+            return;
+        }
+        
+        NSData *event = message.type == NSURLSessionWebSocketMessageTypeData ? message.data : [message.string dataUsingEncoding:NSUTF8StringEncoding];
+        [weakSelf didReceiveMonitoredRequestsEvent:event];
+        
+        [weakSelf receiveMonitoredRequestsEventOnTask:task];
+    }];
+}
+
+- (void)didReceiveMonitoredRequestsEvent:(NSData *)event
+{
+    NSDictionary *jsonObject = event ? [NSJSONSerialization JSONObjectWithData:event options:0 error:nil] : nil;
+    SBTMonitoredNetworkRequestSummary *summary = [jsonObject isKindOfClass:[NSDictionary class]] ? [[SBTMonitoredNetworkRequestSummary alloc] initWithJSONObject:jsonObject] : nil;
+    if (summary == nil) {
+        NSLog(@"[SBTUITestTunnel] Received malformed monitored request event");
+        return;
+    }
+    
+    @synchronized (self.monitoredRequestsEvents) {
+        // every monitored request is published, gaps in sequence numbers are events dropped by a lossy stream
+        NSUInteger lastSequenceNumber = self.monitoredRequestsEventsLastSequenceNumber;
+        if (lastSequenceNumber > 0 && summary.sequenceNumber > lastSequenceNumber + 1) {
+            self.monitoredRequestsEventsDroppedCount += summary.sequenceNumber - lastSequenceNumber - 1;
+        }
+        self.monitoredRequestsEventsLastSequenceNumber = MAX(lastSequenceNumber, summary.sequenceNumber);
+        
+        [self.monitoredRequestsEvents addObject:summary];
+    }
+}
+
+- (BOOL)monitoredRequestsUnsubscribe
+{
+    if (self.monitoredRequestsEventsTask == nil) {
+        return YES;
+    }
+    
+    [self.monitoredRequestsEventsTask cancel];
+    self.monitoredRequestsEventsTask = nil;
+    
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorUnsubscribe params:nil] boolValue];
+}
+
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestsEventsPeekAll
+{
+    @synchronized (self.monitoredRequestsEvents) {
+        return [self.monitoredRequestsEvents copy];
+    }
+}
+
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestsEventsFlushAll
+{
+    @synchronized (self.monitoredRequestsEvents) {
+        NSArray<SBTMonitoredNetworkRequestSummary *> *events = [self.monitoredRequestsEvents copy];
+        [self.monitoredRequestsEvents removeAllObjects];
+        
+        return events;
+    }
+}
+
+- (NSUInteger)monitoredRequestsEventsDroppedCount
+{
+    @synchronized (self.monitoredRequestsEvents) {
+        return _monitoredRequestsEventsDroppedCount;
+    }
+}
+
+#pragma mark - Monitor Requests Trace Commands
+
+- (BOOL)monitoredRequestsTraceStartWithMaximumFileSize:(unsigned long long)maximumFileSize maximumFileCount:(NSUInteger)maximumFileCount
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelMonitorTraceFileSizeKey: [NSString stringWithFormat:@"%llu", maximumFileSize],
+                                                     SBTUITunnelMonitorTraceFileCountKey: [NSString stringWithFormat:@"%lu", (unsigned long)maximumFileCount]};
+
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorTraceStart params:params] boolValue];
+}
+
+- (BOOL)monitoredRequestsTraceStop
+{
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorTraceStop params:nil] boolValue];
+}
+
+- (BOOL)monitoredRequestsTraceDownloadToURL:(NSURL *)fileURL
+{
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+
+    if (self.ipcConnection == nil && self.connectionlessBlock == nil) {
+        return [self monitoredRequestsTraceHTTPDownloadToURL:fileURL];
+    }
+
+    // the simulator (ipc) and the same process (connectionless) share the file system with the app,
+    // trace files are copied directly without going through the tunnel
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorTraceFiles params:nil];
+    if (objectBase64.length == 0) {
+        return NO;
+    }
+
+    NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
+
+    NSError *unarchiveError;
+    NSSet *classes = [NSSet setWithObjects:[NSArray class], [NSString class], nil];
+    NSArray<NSString *> *paths = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:objectData error:&unarchiveError];
+    NSAssert(unarchiveError == nil, @"Error unarchiving NSArray of NSString");
+
+    if (![[NSFileManager defaultManager] createFileAtPath:fileURL.path contents:nil attributes:nil]) {
+        return NO;
+    }
+    NSFileHandle *outputHandle = [NSFileHandle fileHandleForWritingToURL:fileURL error:nil];
+
+    for (NSString *path in paths) {
+        NSFileHandle *inputHandle = [NSFileHandle fileHandleForReadingAtPath:path];
+        while (inputHandle != nil) {
+            @autoreleasepool {
+                NSData *chunk = [inputHandle readDataOfLength:256 * 1024];
+                if (chunk.length == 0) {
+                    break;
+                }
+                [outputHandle writeData:chunk];
+            }
+        }
+        [inputHandle closeFile];
+    }
+    [outputHandle closeFile];
+
+    return YES;
+}
+
+- (BOOL)monitoredRequestsTraceHTTPDownloadToURL:(NSURL *)fileURL
+{
+    if (self.connectionPort == 0) {
+        return NO; // connection still not established
+    }
+
+    NSString *urlString = [NSString stringWithFormat:@"http://%@:%d/%@", SBTUITunneledApplicationDefaultHost, (unsigned int)self.connectionPort, SBTUITunneledApplicationCommandMonitorTraceDownload];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:urlString]];
+
+    dispatch_semaphore_t downloadSemaphore = dispatch_semaphore_create(0);
+
+    __block BOOL ret = NO;
+    NSURLSessionDownloadTask *task = [[NSURLSession sharedSession] downloadTaskWithRequest:request completionHandler:^(NSURL *location, NSURLResponse *response, NSError *error) {
+        if (location != nil && [response isKindOfClass:[NSHTTPURLResponse class]] && ((NSHTTPURLResponse *)response).statusCode == 200) {
+            // the temporary file is removed as soon as the completion handler returns
+            ret = [[NSFileManager defaultManager] moveItemAtURL:location toURL:fileURL error:nil];
+        } else {
+            NSLog(@"[SBTUITestTunnel] Failed downloading monitored requests trace: %@", error);
+        }
+
+        dispatch_semaphore_signal(downloadSemaphore);
+    }];
+    [task resume];
+
+    // the app may die mid-download, never wait forever
+    if (dispatch_semaphore_wait(downloadSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SBTUITunneledApplicationDefaultTimeout * NSEC_PER_SEC))) != 0) {
+        NSLog(@"[SBTUITestTunnel] Timed out downloading monitored requests trace");
+        [task cancel];
+        return NO;
+    }
+
+    return ret;
+}
+
 #pragma mark - Synchronously Wait for Requests Commands
 
 - (BOOL)waitForMonitoredRequestsMatching:(SBTRequestMatch *)match timeout:(NSTimeInterval)timeout;
@@ -469,24 +924,26 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
 {
     NSTimeInterval start = CFAbsoluteTimeGetCurrent();
     
-    while (CFAbsoluteTimeGetCurrent() - start < timeout) {
-        NSArray<SBTMonitoredNetworkRequest *> *requests = [self monitoredRequestsPeekAll];
+    // the app evaluates requests as they complete and replies as soon as enough of them matched. Waits are split
+    // in slices shorter than the request timeout so that long timeouts don't make the tunnel request fail
+    do {
+        NSTimeInterval remaining = MAX(0.0, timeout - (CFAbsoluteTimeGetCurrent() - start));
+        NSTimeInterval slice = MIN(remaining, SBTUITunneledApplicationDefaultTimeout / 2.0);
         
-        NSUInteger localIterations = iterations;
-        for (SBTMonitoredNetworkRequest *request in requests) {
-            if ([request matches:match]) {
-                if (--localIterations == 0) {
-                    return YES;
-                }
-            }
-        }
+        NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelProxyQueryRuleKey: [self base64SerializeObject:match],
+                                                         SBTUITunnelMonitorIterationsKey: [@(iterations) stringValue],
+                                                         SBTUITunnelMonitorTimeoutKey: [@(slice) stringValue]};
         
-        if (iterations == 0) {
-            return localIterations == iterations;
+        NSString *result = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandMonitorWait params:params];
+        if ([result boolValue]) {
+            return YES;
+        } else if (iterations == 0) {
+            return NO;
+        } else if (result == nil) {
+            // tunnel not reachable, don't spin
+            [NSRunLoop.mainRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
         }
-        
-        [NSRunLoop.mainRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
-    }
+    } while (CFAbsoluteTimeGetCurrent() - start < timeout);
 
     return NO;
 }
@@ -509,12 +966,7 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
 
 - (BOOL)throttleRequestRemoveWithIds:(NSArray<NSString *> *)reqIds;
 {
-    BOOL ret = YES;
-    for (NSString *reqId in reqIds) {
-        ret &= [self throttleRequestRemoveWithId:reqId];
-    }
-    
-    return ret;
+    return [self sendSynchronousBatchRemoveRequestWithPath:SBTUITunneledApplicationCommandThrottleRemove key:SBTUITunnelProxyQueryRuleKey ids:reqIds];
 }
 
 - (BOOL)throttleRequestRemoveAll
@@ -546,12 +998,7 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
 
 - (BOOL)blockCookiesRequestsRemoveWithIds:(NSArray<NSString *> *)reqIds
 {
-    BOOL ret = YES;
-    for (NSString *reqId in reqIds) {
-        ret &= [self blockCookiesRequestsRemoveWithId:reqId];
-    }
-    
-    return ret;
+    return [self sendSynchronousBatchRemoveRequestWithPath:SBTUITunneledApplicationCommandCookieBlockRemove key:SBTUITunnelCookieBlockMatchRuleKey ids:reqIds];
 }
 
 - (BOOL)blockCookiesRequestsRemoveAll
@@ -559,6 +1006,110 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandCookieBlockRemoveAll params:nil] boolValue];
 }
 
+#pragma mark - Cassette Commands
+
+- (BOOL)cassetteStartRecordingNamed:(NSString *)name
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelCassetteNameKey: [self base64SerializeObject:name]};
+
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandCassetteRecord params:params] boolValue];
+}
+
+- (BOOL)cassetteStartReplayingNamed:(NSString *)name
+{
+    return [self cassetteStartReplayingNamed:name normalization:[SBTRequestNormalization defaultNormalization]];
+}
+
+- (BOOL)cassetteStartReplayingNamed:(NSString *)name normalization:(SBTRequestNormalization *)normalization
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelCassetteNameKey: [self base64SerializeObject:name],
+                                                     SBTUITunnelCassetteNormalizationKey: [self base64SerializeObject:normalization]};
+
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandCassetteReplay params:params] boolValue];
+}
+
+- (BOOL)cassetteStop
+{
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandCassetteStop params:nil] boolValue];
+}
+
+- (BOOL)cassetteLoad:(NSData *)cassette named:(NSString *)name
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelCassetteNameKey: [self base64SerializeObject:name],
+                                                     SBTUITunnelCassetteDataKey: [self base64SerializeData:cassette]};
+
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandCassetteLoad params:params] boolValue];
+}
+
+- (NSData *)cassetteNamed:(NSString *)name
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelCassetteNameKey: [self base64SerializeObject:name]};
+
+    NSString *cassetteBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandCassetteExport params:params];
+    if (cassetteBase64.length == 0) {
+        return nil;
+    }
+
+    return [[NSData alloc] initWithBase64EncodedString:cassetteBase64 options:0];
+}
+
+#pragma mark - HTTP Cache Commands
+
+- (BOOL)httpCacheEnable
+{
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandHTTPCacheEnable params:nil] boolValue];
+}
+
+- (BOOL)httpCacheDisable
+{
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandHTTPCacheDisable params:nil] boolValue];
+}
+
+- (BOOL)httpCacheClear
+{
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandHTTPCacheClear params:nil] boolValue];
+}
+
+- (SBTHTTPCacheStatistics *)httpCacheStatistics
+{
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandHTTPCacheStatistics params:nil];
+    if (objectBase64.length > 0) {
+        NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
+        
+        NSError *unarchiveError;
+        SBTHTTPCacheStatistics *result = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTHTTPCacheStatistics class] fromData:objectData error:&unarchiveError];
+        NSAssert(unarchiveError == nil, @"Error unarchiving SBTHTTPCacheStatistics");
+        
+        return result;
+    }
+    
+    return nil;
+}
+
+#pragma mark - Network Statistics Commands
+
+- (NSArray<SBTNetworkEndpointStatistics *> *)networkStatistics
+{
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandNetworkStatistics params:nil];
+    if (objectBase64) {
+        NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
+        
+        NSError *unarchiveError;
+        NSSet *classes = [NSSet setWithObjects:[NSArray class], [SBTNetworkEndpointStatistics class], nil];
+        NSArray *result = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:objectData error:&unarchiveError];
+        NSAssert(unarchiveError == nil, @"Error unarchiving NSArray of SBTNetworkEndpointStatistics");
+        
+        return result ?: @[];
+    }
+    
+    return @[];
+}
+
+- (BOOL)networkStatisticsReset
+{
+    return [[self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandNetworkStatisticsReset params:nil] boolValue];
+}
+
 #pragma mark - NSUserDefaults Commands
 
 - (BOOL)userDefaultsSetObject:(id)object forKey:(NSString *)key
@@ -697,6 +1248,72 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     return nil;
 }
 
+#pragma mark - Asynchronous Commands
+
+- (void)stubRequestsMatching:(SBTRequestMatch *)match response:(SBTStubResponse *)response completion:(void (^)(NSString *))completion
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelStubMatchRuleKey: [self base64SerializeObject:match],
+                                                     SBTUITunnelStubResponseKey: [self base64SerializeObject:response]
+                                                     };
+
+    [self sendAsynchronousRequestWithPath:SBTUITunneledApplicationCommandStubMatching params:params completion:^(NSString *result) {
+        if (completion) { completion(result); }
+    }];
+}
+
+- (void)stubRequestsRemoveWithId:(NSString *)stubId completion:(void (^)(BOOL))completion
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelStubMatchRuleKey:[self base64SerializeObject:stubId]};
+
+    [self sendAsynchronousRequestWithPath:SBTUITunneledApplicationCommandStubRequestsRemove params:params completion:^(NSString *result) {
+        if (completion) { completion([result boolValue]); }
+    }];
+}
+
+- (void)performCustomCommandNamed:(NSString *)commandName object:(id)object completion:(void (^)(id))completion
+{
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelCustomCommandKey: commandName,
+                                                     SBTUITunnelObjectKey: [self base64SerializeObject:object]};
+
+    __weak typeof(self)weakSelf = self;
+    [self sendAsynchronousRequestWithPath:SBTUITunneledApplicationCommandCustom params:params completion:^(NSString *result) {
+        id object = [weakSelf customCommandObjectFromBase64:result];
+        if (completion) { completion(object); }
+    }];
+}
+
+- (BOOL)waitForPendingCommands
+{
+    return dispatch_group_wait(self.pendingCommandsGroup, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SBTUITunneledApplicationDefaultTimeout * NSEC_PER_SEC))) == 0;
+}
+
+#pragma mark - IPC Statistics
+
+- (NSDictionary<NSNumber *, NSNumber *> *)ipcCommandLatencyHistogram
+{
+    NSMutableDictionary<NSNumber *, NSNumber *> *histogram = [NSMutableDictionary dictionary];
+    @synchronized (self.ipcCommandLatencyCounts) {
+        for (NSUInteger i = 0; i < SBTIPCCommandLatencyBucketCount; i++) {
+            NSTimeInterval upperBound = i < SBTIPCCommandLatencyBucketCount - 1 ? SBTIPCCommandLatencyBucketBounds[i] : INFINITY;
+            histogram[@(upperBound)] = self.ipcCommandLatencyCounts[i];
+        }
+    }
+
+    return [histogram copy];
+}
+
+- (void)recordIPCCommandLatency:(NSTimeInterval)latency
+{
+    NSUInteger bucket = 0;
+    while (bucket < SBTIPCCommandLatencyBucketCount - 1 && latency > SBTIPCCommandLatencyBucketBounds[bucket]) {
+        bucket++;
+    }
+
+    @synchronized (self.ipcCommandLatencyCounts) {
+        self.ipcCommandLatencyCounts[bucket] = @([self.ipcCommandLatencyCounts[bucket] unsignedIntegerValue] + 1);
+    }
+}
+
 #pragma mark - Custom Commands
 
 - (id)performCustomCommandNamed:(NSString *)commandName object:(id)object
@@ -706,6 +1323,11 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     
     NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandCustom params:params];
     
+    return [self customCommandObjectFromBase64:objectBase64];
+}
+
+- (id)customCommandObjectFromBase64:(NSString *)objectBase64
+{
     if (objectBase64) {
         NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
 
@@ -1008,7 +1630,12 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
         if (self.ipcConnection) {
             return [data base64EncodedStringWithOptions:0];
         } else {
-            return [[data base64EncodedStringWithOptions:0] stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet alphanumericCharacterSet]];
+            NSString *ret = [[data base64EncodedStringWithOptions:0] stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet alphanumericCharacterSet]];
+            // frames and multipart bodies carry the data itself, see serializedDataForParameterValue:
+            @synchronized (self.serializedParametersData) {
+                [self.serializedParametersData setObject:data forKey:ret];
+            }
+            return ret;
         }
     }
 }
@@ -1025,26 +1652,16 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
             __block NSString *ret;
             __weak typeof(self)weakSelf = self;
             
-            __block BOOL lockedDone = NO;
-            
-            NSLock *lock = [[NSLock alloc] init];
-            
+            // the caller is woken as soon as the command completes on the main thread
+            dispatch_semaphore_t commandSemaphore = dispatch_semaphore_create(0);
             dispatch_async(dispatch_get_main_queue(), ^{
                 ret = [weakSelf sendSynchronousRequestWithPath:path params:params assertOnError:assertOnError];
-                
-                [lock lock];
-                lockedDone = YES;
-                [lock unlock];
+                dispatch_semaphore_signal(commandSemaphore);
             });
             
-            NSTimeInterval start = CFAbsoluteTimeGetCurrent();
-            BOOL done = NO;
-            while (!done && CFAbsoluteTimeGetCurrent() - start < SBTUITunneledApplicationDefaultTimeout) {
-                [NSRunLoop.mainRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
-                
-                [lock lock];
-                done = lockedDone;
-                [lock unlock];
+            if (dispatch_semaphore_wait(commandSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SBTUITunneledApplicationDefaultTimeout * NSEC_PER_SEC))) != 0) {
+                NSLog(@"[SBTUITestTunnel] Timed out waiting for command '%@'", path);
+                return nil;
             }
 
             return ret;
@@ -1054,9 +1671,11 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
         ipcParams[SBTUITunnelIPCCommand] = path;
                 
         __block NSDictionary *ret = nil;
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
         [self.ipcProxy performCommandWithParameters:ipcParams block:^void(NSDictionary *dict) {
             ret = dict;
         }];
+        [self recordIPCCommandLatency:CFAbsoluteTimeGetCurrent() - start];
 
         return ret[SBTUITunnelResponseResultKey];
     } else if (self.connectionlessBlock) {
@@ -1073,7 +1692,97 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     } else if (self.connectionPort == 0) {
         return nil; // connection still not established
     }
-    
+
+    // going through the asynchronous path keeps commands in order with those still in flight
+    __block NSString *ret = nil;
+    dispatch_semaphore_t sentSemaphore = dispatch_semaphore_create(0);
+    dispatch_semaphore_t commandSemaphore = dispatch_semaphore_create(0);
+    [self sendRequestWithPath:path params:params assertOnError:assertOnError sent:^{
+        dispatch_semaphore_signal(sentSemaphore);
+    } completion:^(NSString *result) {
+        ret = result;
+        dispatch_semaphore_signal(sentSemaphore);
+        dispatch_semaphore_signal(commandSemaphore);
+    }];
+
+    // the timeout starts once the command is sent, waiting behind the commands ahead of it doesn't count.
+    // Those are bounded by their own timeout (HTTP) or only wait to be written (frames)
+    dispatch_semaphore_wait(sentSemaphore, DISPATCH_TIME_FOREVER);
+    if (dispatch_semaphore_wait(commandSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SBTUITunneledApplicationDefaultTimeout * NSEC_PER_SEC))) != 0) {
+        NSLog(@"[SBTUITestTunnel] Timed out waiting for command '%@'", path);
+    }
+
+    return ret;
+}
+
+- (void)sendAsynchronousRequestWithPath:(NSString *)path params:(NSDictionary<NSString *, NSString *> *)params completion:(void (^)(NSString *))completion
+{
+    if (self.ipcConnection || self.connectionlessBlock || self.connectionPort == 0) {
+        // IPC and connectionless commands are performed on the main thread, nothing to pipeline
+        completion([self sendSynchronousRequestWithPath:path params:params]);
+        return;
+    }
+
+    dispatch_group_enter(self.pendingCommandsGroup);
+    dispatch_group_t pendingCommandsGroup = self.pendingCommandsGroup;
+    dispatch_queue_t completionQueue = self.completionQueue;
+    [self sendRequestWithPath:path params:params assertOnError:YES sent:nil completion:^(NSString *result) {
+        // completions run in order on their own queue: callers may send synchronous commands from the completion,
+        // which would otherwise block the transport
+        dispatch_async(completionQueue, ^{
+            completion(result);
+            dispatch_group_leave(pendingCommandsGroup);
+        });
+    }];
+}
+
+- (void)sendRequestWithPath:(NSString *)path params:(NSDictionary<NSString *, NSString *> *)params assertOnError:(BOOL)assertOnError sent:(void (^)(void))sent completion:(void (^)(NSString *))commandCompletion
+{
+    __weak typeof(self)weakSelf = self;
+    void (^completion)(NSString *) = ^(NSString *result) {
+        [weakSelf forgetSerializedDataOfParameters:params];
+        commandCompletion(result);
+    };
+
+    SBTTunnelFrameClient *frameClient = self.frameClient;
+    if (frameClient != nil) {
+        // frames are pipelined on the connection, the app executes them in the order they were sent. Once the
+        // connection is lost commands still go through the frame client, which fails them in order
+        [frameClient sendCommand:path parameters:[self frameParametersFromParameters:params] written:sent completion:^(NSDictionary *response, BOOL written) {
+            if (response != nil) {
+                completion(response[SBTUITunnelResponseResultKey]);
+            } else if (weakSelf.frameClient != frameClient) {
+                // the client disconnected, e.g. when relaunching the app
+                completion(nil);
+            } else if (written) {
+                // the app may have executed the command, sending it again could execute it twice
+                NSLog(@"[SBTUITestTunnel] Frame tunnel connection lost while command '%@' was in flight", path);
+                NSCAssert(!assertOnError, @"[SBTUITestTunnel] Frame tunnel connection lost while command '%@' was in flight", path);
+                completion(nil);
+            } else {
+                // never reached the app, sent again over HTTP in the order commands were sent
+                [weakSelf enqueueHTTPRequestWithPath:path params:params assertOnError:assertOnError sent:sent completion:completion];
+            }
+        }];
+        return;
+    }
+
+    [self enqueueHTTPRequestWithPath:path params:params assertOnError:assertOnError sent:sent completion:completion];
+}
+
+- (void)enqueueHTTPRequestWithPath:(NSString *)path params:(NSDictionary<NSString *, NSString *> *)params assertOnError:(BOOL)assertOnError sent:(void (^)(void))sent completion:(void (^)(NSString *))completion
+{
+    __weak typeof(self)weakSelf = self;
+    dispatch_async(self.commandQueue, ^{
+        if (sent != nil) {
+            sent();
+        }
+        completion([weakSelf sendHTTPRequestWithPath:path params:params assertOnError:assertOnError]);
+    });
+}
+
+- (NSString *)sendHTTPRequestWithPath:(NSString *)path params:(NSDictionary<NSString *, NSString *> *)params assertOnError:(BOOL)assertOnError
+{
     NSString *urlString = [NSString stringWithFormat:@"http://%@:%d/%@", SBTUITunneledApplicationDefaultHost, (unsigned int)self.connectionPort, path];
     
     NSURL *url = [NSURL URLWithString:urlString];
@@ -1092,7 +1801,14 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     } else if  ([SBTUITunnelHTTPMethod isEqualToString:@"POST"]) {
         request = [NSMutableURLRequest requestWithURL:url];
         
-        request.HTTPBody = [components.query dataUsingEncoding:NSUTF8StringEncoding];
+        NSString *boundary = [NSString stringWithFormat:@"sbtuitesttunnel-%@", [NSUUID UUID].UUIDString];
+        NSData *multipartBody = [self multipartBodyWithParams:params boundary:boundary];
+        if (multipartBody) {
+            request.HTTPBody = multipartBody;
+            [request setValue:[NSString stringWithFormat:@"multipart/form-data; boundary=%@", boundary] forHTTPHeaderField:@"Content-Type"];
+        } else {
+            request.HTTPBody = [components.query dataUsingEncoding:NSUTF8StringEncoding];
+        }
     }
     request.HTTPMethod = SBTUITunnelHTTPMethod;
     
@@ -1136,6 +1852,147 @@ static NSTimeInterval SBTUITunneledApplicationDefaultTimeout = 30.0;
     return responseId;
 }
 
+- (NSArray *)sendSynchronousBatchRequestWithCommands:(NSArray<NSDictionary *> *)commands
+{
+    NSMutableArray<NSDictionary *> *batchCommands = [NSMutableArray arrayWithCapacity:commands.count];
+    for (NSDictionary *command in commands) {
+        [batchCommands addObject:@{SBTUITunnelBatchCommandPathKey: command[SBTUITunnelBatchCommandPathKey],
+                                   SBTUITunnelBatchCommandParametersKey: [[self rawParametersFromParameters:command[SBTUITunnelBatchCommandParametersKey]] copy]}];
+    }
+
+    NSDictionary<NSString *, NSString *> *params = @{SBTUITunnelBatchCommandsKey: [self base64SerializeObject:[batchCommands copy]]};
+
+    NSString *objectBase64 = [self sendSynchronousRequestWithPath:SBTUITunneledApplicationCommandBatch params:params];
+    if (objectBase64.length == 0) {
+        return nil;
+    }
+
+    NSData *objectData = [[NSData alloc] initWithBase64EncodedString:objectBase64 options:0];
+
+    NSError *unarchiveError;
+    NSSet *classes = [NSSet setWithObjects:[NSArray class], [NSString class], [NSNumber class], [NSNull class], nil];
+    NSArray *results = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:objectData error:&unarchiveError];
+    NSAssert(unarchiveError == nil, @"Error unarchiving batch results");
+
+    return results.count == commands.count ? results : nil;
+}
+
+- (BOOL)sendSynchronousBatchRemoveRequestWithPath:(NSString *)path key:(NSString *)key ids:(NSArray<NSString *> *)ids
+{
+    if (ids.count == 0) {
+        return YES;
+    }
+
+    NSMutableArray<NSDictionary *> *commands = [NSMutableArray arrayWithCapacity:ids.count];
+    for (NSString *identifier in ids) {
+        [commands addObject:@{SBTUITunnelBatchCommandPathKey: path,
+                              SBTUITunnelBatchCommandParametersKey: @{key: [self base64SerializeObject:identifier]}}];
+    }
+
+    NSArray *results = [self sendSynchronousBatchRequestWithCommands:commands];
+
+    BOOL ret = (results != nil);
+    for (id result in results) {
+        ret &= [result isKindOfClass:[NSString class]] && [result boolValue];
+    }
+
+    return ret;
+}
+
+- (NSData *)multipartBodyWithParams:(NSDictionary<NSString *, NSString *> *)params boundary:(NSString *)boundary
+{
+    // below this size the form encoded body is smaller than the multipart framing
+    static const NSUInteger SBTUITunnelBinaryParameterMinimumLength = 1024;
+
+    NSMutableDictionary<NSString *, NSData *> *binaryParams = [NSMutableDictionary dictionary];
+    [params enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        NSData *data = [self serializedDataForParameterValue:value];
+        if (data.length >= SBTUITunnelBinaryParameterMinimumLength) {
+            binaryParams[key] = data;
+        }
+    }];
+
+    if (binaryParams.count == 0) {
+        return nil;
+    }
+
+    NSMutableData *body = [NSMutableData data];
+    [params enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        NSData *data = binaryParams[key];
+        NSString *contentType = data ? SBTUITunnelBinaryParameterContentType : @"text/plain; charset=utf-8";
+        NSString *partHeader = [NSString stringWithFormat:@"--%@\r\nContent-Disposition: form-data; name=\"%@\"\r\nContent-Type: %@\r\n\r\n", boundary, key, contentType];
+
+        [body appendData:[partHeader dataUsingEncoding:NSUTF8StringEncoding]];
+        [body appendData:data ?: [([value stringByRemovingPercentEncoding] ?: value) dataUsingEncoding:NSUTF8StringEncoding]];
+        [body appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+    [body appendData:[[NSString stringWithFormat:@"--%@--\r\n", boundary] dataUsingEncoding:NSUTF8StringEncoding]];
+
+    return body;
+}
+
+- (NSDictionary<NSString *, NSString *> *)rawParametersFromParameters:(NSDictionary<NSString *, NSString *> *)params
+{
+    if (self.ipcConnection) {
+        return params ?: @{};
+    }
+
+    // parameters are percent encoded to be sent in HTTP requests (see base64SerializeData:), batches carry them as they are
+    NSMutableDictionary<NSString *, NSString *> *ret = [NSMutableDictionary dictionaryWithCapacity:params.count];
+    [params enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        ret[key] = [value stringByRemovingPercentEncoding] ?: value;
+    }];
+
+    return ret;
+}
+
+- (NSDictionary<NSString *, id> *)frameParametersFromParameters:(NSDictionary<NSString *, NSString *> *)params
+{
+    NSMutableDictionary<NSString *, id> *ret = [[self rawParametersFromParameters:params] mutableCopy];
+
+    // values returned by base64SerializeData: are replaced by the serialized data, sparing the base64 round trip
+    [params enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        NSData *data = [self serializedDataForParameterValue:value];
+        if (data != nil) {
+            ret[key] = data;
+        }
+    }];
+
+    return ret;
+}
+
+- (NSData *)serializedDataForParameterValue:(NSString *)value
+{
+    // binary parameters are those returned by base64SerializeData:, looked up by identity so that plain strings are never taken for them
+    @synchronized (self.serializedParametersData) {
+        return [self.serializedParametersData objectForKey:value];
+    }
+}
+
+- (void)forgetSerializedDataOfParameters:(NSDictionary<NSString *, NSString *> *)params
+{
+    @synchronized (self.serializedParametersData) {
+        for (NSString *value in params.allValues) {
+            [self.serializedParametersData removeObjectForKey:value];
+        }
+    }
+}
+
+- (SBTTunnelFrameClient *)frameClient
+{
+    // read from the transport queues while being replaced on the caller threads
+    @synchronized (self) {
+        return _frameClient;
+    }
+}
+
+- (void)setFrameClient:(SBTTunnelFrameClient *)frameClient
+{
+    @synchronized (self) {
+        _frameClient = frameClient;
+    }
+}
+
 - (NSString *)sendSynchronousRequestWithPath:(NSString *)path params:(NSDictionary<NSString *, NSString *> *)params
 {
     return [self sendSynchronousRequestWithPath:path params:params assertOnError:YES];
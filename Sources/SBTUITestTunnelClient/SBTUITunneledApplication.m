@@ -103,6 +103,16 @@
     return [self.client stubRequestsMatching:match response:response];
 }
 
+- (NSString *)stubRequestsWithHAR:(NSData *)har
+{
+    return [self.client stubRequestsWithHAR:har];
+}
+
+- (NSString *)stubRequestsWithHAR:(NSData *)har normalization:(SBTRequestNormalization *)normalization
+{
+    return [self.client stubRequestsWithHAR:har normalization:normalization];
+}
+
 #pragma mark - Stub Remove Commands
 
 - (BOOL)stubRequestsRemoveWithId:(NSString *)stubId
@@ -161,6 +171,11 @@
     return [self.client monitorRequestsMatching:match];
 }
 
+- (NSString *)monitorRequestsMatching:(SBTRequestMatch *)match capturePolicy:(SBTMonitorCapturePolicy *)capturePolicy
+{
+    return [self.client monitorRequestsMatching:match capturePolicy:capturePolicy];
+}
+
 - (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsPeekAll
 {
     return [self.client monitoredRequestsPeekAll];
@@ -171,6 +186,46 @@
     return [self.client monitoredRequestsFlushAll];
 }
 
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestSummariesPeekAll
+{
+    return [self.client monitoredRequestSummariesPeekAll];
+}
+
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestSummariesFlushAll
+{
+    return [self.client monitoredRequestSummariesFlushAll];
+}
+
+- (NSData *)monitoredRequestRequestDataWithSequenceNumber:(NSUInteger)sequenceNumber
+{
+    return [self.client monitoredRequestRequestDataWithSequenceNumber:sequenceNumber];
+}
+
+- (NSData *)monitoredRequestResponseDataWithSequenceNumber:(NSUInteger)sequenceNumber
+{
+    return [self.client monitoredRequestResponseDataWithSequenceNumber:sequenceNumber];
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsSinceSequenceNumber:(NSUInteger)sequenceNumber
+{
+    return [self.client monitoredRequestsSinceSequenceNumber:sequenceNumber];
+}
+
+- (BOOL)monitoredRequestsSetCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy
+{
+    return [self.client monitoredRequestsSetCapacity:capacity overflowPolicy:overflowPolicy];
+}
+
+- (SBTMonitoredNetworkRequestsStatistics *)monitoredRequestsStatistics
+{
+    return [self.client monitoredRequestsStatistics];
+}
+
+- (NSArray<SBTMonitoredNetworkEndpointTiming *> *)monitoredRequestsTimingByEndpoint
+{
+    return [self.client monitoredRequestsTimingByEndpoint];
+}
+
 - (BOOL)monitorRequestRemoveWithId:(NSString *)reqId
 {
     return [self.client monitorRequestRemoveWithId:reqId];
@@ -186,6 +241,55 @@
     return [self.client monitorRequestRemoveAll];
 }
 
+#pragma mark - Monitor Requests Event Stream Commands
+
+- (BOOL)monitoredRequestsSubscribe
+{
+    return [self.client monitoredRequestsSubscribe];
+}
+
+- (BOOL)monitoredRequestsSubscribeLossy:(BOOL)lossy
+{
+    return [self.client monitoredRequestsSubscribeLossy:lossy];
+}
+
+- (BOOL)monitoredRequestsUnsubscribe
+{
+    return [self.client monitoredRequestsUnsubscribe];
+}
+
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestsEventsPeekAll
+{
+    return [self.client monitoredRequestsEventsPeekAll];
+}
+
+- (NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestsEventsFlushAll
+{
+    return [self.client monitoredRequestsEventsFlushAll];
+}
+
+- (NSUInteger)monitoredRequestsEventsDroppedCount
+{
+    return [self.client monitoredRequestsEventsDroppedCount];
+}
+
+#pragma mark - Monitor Requests Trace Commands
+
+- (BOOL)monitoredRequestsTraceStartWithMaximumFileSize:(unsigned long long)maximumFileSize maximumFileCount:(NSUInteger)maximumFileCount
+{
+    return [self.client monitoredRequestsTraceStartWithMaximumFileSize:maximumFileSize maximumFileCount:maximumFileCount];
+}
+
+- (BOOL)monitoredRequestsTraceStop
+{
+    return [self.client monitoredRequestsTraceStop];
+}
+
+- (BOOL)monitoredRequestsTraceDownloadToURL:(NSURL *)fileURL
+{
+    return [self.client monitoredRequestsTraceDownloadToURL:fileURL];
+}
+
 #pragma mark - Synchronously Wait for Requests Commands
 
 - (BOOL)waitForMonitoredRequestsMatching:(SBTRequestMatch *)match timeout:(NSTimeInterval)timeout
@@ -247,6 +351,72 @@
     return [self.client blockCookiesRequestsRemoveAll];
 }
 
+#pragma mark - Cassette Commands
+
+- (BOOL)cassetteStartRecordingNamed:(NSString *)name
+{
+    return [self.client cassetteStartRecordingNamed:name];
+}
+
+- (BOOL)cassetteStartReplayingNamed:(NSString *)name
+{
+    return [self.client cassetteStartReplayingNamed:name];
+}
+
+- (BOOL)cassetteStartReplayingNamed:(NSString *)name normalization:(SBTRequestNormalization *)normalization
+{
+    return [self.client cassetteStartReplayingNamed:name normalization:normalization];
+}
+
+- (BOOL)cassetteStop
+{
+    return [self.client cassetteStop];
+}
+
+- (BOOL)cassetteLoad:(NSData *)cassette named:(NSString *)name
+{
+    return [self.client cassetteLoad:cassette named:name];
+}
+
+- (NSData *)cassetteNamed:(NSString *)name
+{
+    return [self.client cassetteNamed:name];
+}
+
+#pragma mark - HTTP Cache Commands
+
+- (BOOL)httpCacheEnable
+{
+    return [self.client httpCacheEnable];
+}
+
+- (BOOL)httpCacheDisable
+{
+    return [self.client httpCacheDisable];
+}
+
+- (BOOL)httpCacheClear
+{
+    return [self.client httpCacheClear];
+}
+
+- (SBTHTTPCacheStatistics *)httpCacheStatistics
+{
+    return [self.client httpCacheStatistics];
+}
+
+#pragma mark - Network Statistics Commands
+
+- (NSArray<SBTNetworkEndpointStatistics *> *)networkStatistics
+{
+    return [self.client networkStatistics];
+}
+
+- (BOOL)networkStatisticsReset
+{
+    return [self.client networkStatisticsReset];
+}
+
 #pragma mark - NSUserDefaults Commands
 
 - (BOOL)userDefaultsSetObject:(id<NSCoding>)object forKey:(NSString *)key
@@ -313,6 +483,35 @@
     return [self.client downloadItemsFromPath:path relativeTo:baseFolder];
 }
 
+#pragma mark - Asynchronous Commands
+
+- (void)stubRequestsMatching:(SBTRequestMatch *)match response:(SBTStubResponse *)response completion:(void (^)(NSString *))completion
+{
+    [self.client stubRequestsMatching:match response:response completion:completion];
+}
+
+- (void)stubRequestsRemoveWithId:(NSString *)stubId completion:(void (^)(BOOL))completion
+{
+    [self.client stubRequestsRemoveWithId:stubId completion:completion];
+}
+
+- (void)performCustomCommandNamed:(NSString *)commandName object:(id)object completion:(void (^)(id))completion
+{
+    [self.client performCustomCommandNamed:commandName object:object completion:completion];
+}
+
+- (BOOL)waitForPendingCommands
+{
+    return [self.client waitForPendingCommands];
+}
+
+#pragma mark - IPC Statistics
+
+- (NSDictionary<NSNumber *, NSNumber *> *)ipcCommandLatencyHistogram
+{
+    return [self.client ipcCommandLatencyHistogram];
+}
+
 #pragma mark - Custom Commands
 
 - (id)performCustomCommandNamed:(NSString *)commandName object:(id)object
@@ -65,6 +65,9 @@ typedef enum: NSUInteger {
  *  The following options can be set as `XCUIApplication.launchArguments` for additional behaviours:
  *  SBTUITunneledApplicationLaunchOptionResetFilesystem: delete app's filesystem sandbox
  *  SBTUITunneledApplicationLaunchOptionDisableUITextFieldAutocomplete disables UITextField's autocomplete functionality which can lead to unexpected results when typing text.
+ *  SBTUITunneledApplicationLaunchOptionEnableHTTPCache enables the on-device HTTP cache for passthrough GET requests, see -(BOOL)httpCacheEnable
+ *  SBTUITunneledApplicationLaunchOptionDisableFrameTunnel sends commands as HTTP requests instead of frames over a persistent connection
+ *  SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel on the simulator sends frames over a loopback TCP connection instead of a unix domain socket
  */
 @interface SBTUITestTunnelClient : NSObject <SBTUITestTunnelClientProtocol>
 
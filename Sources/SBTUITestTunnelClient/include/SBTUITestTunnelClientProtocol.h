@@ -21,6 +21,13 @@
 @class SBTRequestMatch;
 @class SBTStubResponse;
 @class SBTRewrite;
+@class SBTRequestNormalization;
+@class SBTMonitorCapturePolicy;
+@class SBTHTTPCacheStatistics;
+@class SBTMonitoredNetworkRequestsStatistics;
+@class SBTMonitoredNetworkRequestSummary;
+@class SBTMonitoredNetworkEndpointTiming;
+@class SBTNetworkEndpointStatistics;
 
 @protocol SBTUITestTunnelClientProtocol <NSObject>
 
@@ -76,6 +83,28 @@
  */
 - (nullable NSString *)stubRequestsMatching:(nonnull SBTRequestMatch *)match response:(nonnull SBTStubResponse *)response;
 
+/**
+ *  Stub all requests contained in a HAR (HTTP Archive) file, as exported by Charles or browser developer tools.
+ *  The file is uploaded once and indexed in the app so that stubbed requests are found with a single lookup.
+ *  Requests are matched by method, url (query items in any order) and body. Use -(NSString *)stubRequestsWithHAR:normalization: to customize matching
+ *
+ *  @param har The content of the HAR file
+ *
+ *  @return If nil request failed. Otherwise an identifier associated to the newly created stubs. Should be used when using -(BOOL)stubRequestsRemoveWithId:
+ */
+- (nullable NSString *)stubRequestsWithHAR:(nonnull NSData *)har;
+
+/**
+ *  Stub all requests contained in a HAR (HTTP Archive) file, as exported by Charles or browser developer tools.
+ *  The file is uploaded once and indexed in the app so that stubbed requests are found with a single lookup.
+ *
+ *  @param har The content of the HAR file
+ *  @param normalization Specifies which parts of the request are used to match archived requests
+ *
+ *  @return If nil request failed. Otherwise an identifier associated to the newly created stubs. Should be used when using -(BOOL)stubRequestsRemoveWithId:
+ */
+- (nullable NSString *)stubRequestsWithHAR:(nonnull NSData *)har normalization:(nonnull SBTRequestNormalization *)normalization;
+
 #pragma mark - Stub Remove Commands
 
 /**
@@ -171,6 +200,17 @@
  */
 - (nullable NSString *)monitorRequestsMatching:(nonnull SBTRequestMatch *)match;
 
+/**
+ *  Start monitoring requests matching a regular expression pattern, limiting how much of their bodies is kept in memory.
+ *  Monitored requests record the original body lengths, see isResponseDataTruncated
+ *
+ *  @param match The match object that contains the matching rules
+ *  @param capturePolicy How request and response bodies are truncated and compressed when captured
+ *
+ *  @return If nil request failed. Otherwise an identifier associated to the newly created monitor probe. Should be used when using -(BOOL)monitorRequestRemoveWithId:
+ */
+- (nullable NSString *)monitorRequestsMatching:(nonnull SBTRequestMatch *)match capturePolicy:(nonnull SBTMonitorCapturePolicy *)capturePolicy;
+
 /**
  *  Peek (retrieve) the current list of collected requests
  *
@@ -185,6 +225,75 @@
  */
 - (nonnull NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsFlushAll;
 
+/**
+ *  Peek (retrieve) a summary of the current list of collected requests. Headers and bodies are not transferred,
+ *  making this much cheaper than monitoredRequestsPeekAll when only method, url, status code and timing are needed
+ *
+ *  @return The list of monitored requests summaries
+ */
+- (nonnull NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestSummariesPeekAll;
+
+/**
+ *  Flushes (retrieve + clear) a summary of the current list of collected requests. Headers and bodies are not transferred,
+ *  the bodies of the most recently flushed requests can still be retrieved by sequence number
+ *
+ *  @return The list of monitored requests summaries
+ */
+- (nonnull NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestSummariesFlushAll;
+
+/**
+ *  Retrieve the request body of a collected request
+ *
+ *  @param sequenceNumber The sequence number of the monitored request
+ *
+ *  @return The request body, nil if empty or if the request is no longer available
+ */
+- (nullable NSData *)monitoredRequestRequestDataWithSequenceNumber:(NSUInteger)sequenceNumber;
+
+/**
+ *  Retrieve the response body of a collected request
+ *
+ *  @param sequenceNumber The sequence number of the monitored request
+ *
+ *  @return The response body, nil if empty or if the request is no longer available
+ */
+- (nullable NSData *)monitoredRequestResponseDataWithSequenceNumber:(NSUInteger)sequenceNumber;
+
+/**
+ *  Retrieve the collected requests completed after the one with the specified sequence number, without clearing them.
+ *  Pass the `sequenceNumber` of the last request received to fetch only new requests
+ *
+ *  @param sequenceNumber The cursor, 0 to retrieve all collected requests
+ *
+ *  @return The list of monitored requests with a greater sequence number
+ */
+- (nonnull NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsSinceSequenceNumber:(NSUInteger)sequenceNumber;
+
+/**
+ *  Limit the number of collected requests kept in memory by the app. When the limit is reached the oldest request is either dropped
+ *  or spilled to a file in the app container, spilled requests are still returned by monitoredRequestsPeekAll and monitoredRequestsFlushAll
+ *
+ *  @param capacity The maximum number of requests kept in memory, 0 for unbounded (the default)
+ *  @param overflowPolicy What happens to the oldest request when the limit is reached
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)monitoredRequestsSetCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy;
+
+/**
+ *  Retrieve occupancy and overflow counters of the collected requests
+ *
+ *  @return The statistics, nil if request failed
+ */
+- (nullable SBTMonitoredNetworkRequestsStatistics *)monitoredRequestsStatistics;
+
+/**
+ *  Aggregate the timing breakdown of the collected requests by endpoint (HTTP method, host and path). Stubbed requests are not included
+ *
+ *  @return The endpoints sorted by descending cumulative time
+ */
+- (nonnull NSArray<SBTMonitoredNetworkEndpointTiming *> *)monitoredRequestsTimingByEndpoint;
+
 /**
  *  Remove a request monitor
  *
@@ -237,6 +346,91 @@
  */
 - (BOOL)waitForMonitoredRequestsMatching:(nonnull SBTRequestMatch *)match timeout:(NSTimeInterval)timeout iterations:(NSUInteger)iterations;
 
+#pragma mark - Monitor Requests Event Stream Commands
+
+/**
+ *  Subscribe to the monitored requests of the app target. A summary of every monitored request is pushed to the test runner as soon as
+ *  it completes and collected locally, see monitoredRequestsEventsPeekAll. Events not yet delivered are queued in the app when the
+ *  test runner falls behind, up to a limit past which the oldest queued events are dropped (see monitoredRequestsEventsDroppedCount)
+ *
+ *  Note: you have to start a monitor request before calling this method. Requires iOS 13
+ *
+ *  @return `YES` once the subscription is active
+ */
+- (BOOL)monitoredRequestsSubscribe;
+
+/**
+ *  Subscribe to the monitored requests of the app target. A summary of every monitored request is pushed to the test runner as soon as
+ *  it completes and collected locally, see monitoredRequestsEventsPeekAll
+ *
+ *  Note: you have to start a monitor request before calling this method. Requires iOS 13
+ *
+ *  @param lossy When `YES` events are dropped instead of queued in the app when the test runner falls behind, see monitoredRequestsEventsDroppedCount
+ *
+ *  @return `YES` once the subscription is active
+ */
+- (BOOL)monitoredRequestsSubscribeLossy:(BOOL)lossy;
+
+/**
+ *  Stop receiving monitored requests events. Events already received are kept
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)monitoredRequestsUnsubscribe;
+
+/**
+ *  Peek (retrieve) the monitored requests events received so far. No request is sent to the app
+ *
+ *  @return The list of received events, oldest first
+ */
+- (nonnull NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestsEventsPeekAll;
+
+/**
+ *  Flushes (retrieve + clear) the monitored requests events received so far. No request is sent to the app
+ *
+ *  @return The list of received events, oldest first
+ */
+- (nonnull NSArray<SBTMonitoredNetworkRequestSummary *> *)monitoredRequestsEventsFlushAll;
+
+/**
+ *  The number of events dropped by the current subscription, detected as gaps in the events' sequence numbers. Events are
+ *  dropped by lossy subscriptions, or by any subscription when the app's queue of undelivered events is full.
+ *  Dropped requests can be retrieved with monitoredRequestsSinceSequenceNumber:
+ *
+ *  @return The number of dropped events
+ */
+- (NSUInteger)monitoredRequestsEventsDroppedCount;
+
+#pragma mark - Monitor Requests Trace Commands
+
+/**
+ *  Start writing every monitored request as a HAR entry to a trace in the app container, one JSON line per request (NDJSON).
+ *  The trace is written as requests complete and rotated by size so that long runs don't accumulate requests in memory.
+ *  A previous trace is discarded
+ *
+ *  @param maximumFileSize The size in bytes after which the trace moves to a new file, 0 for the default (16MB)
+ *  @param maximumFileCount The number of files kept, older files are removed when rotating. 0 for the default (4)
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)monitoredRequestsTraceStartWithMaximumFileSize:(unsigned long long)maximumFileSize maximumFileCount:(NSUInteger)maximumFileCount;
+
+/**
+ *  Stop writing monitored requests to the trace. The trace can still be downloaded
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)monitoredRequestsTraceStop;
+
+/**
+ *  Download the trace to a local file, oldest entries first. The trace is transferred in chunks without loading it in memory
+ *
+ *  @param fileURL The destination file, overwritten if it exists
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)monitoredRequestsTraceDownloadToURL:(nonnull NSURL *)fileURL;
+
 #pragma mark - Throttle Requests Commands
 
 /**
@@ -322,6 +516,113 @@
  */
 - (BOOL)blockCookiesRequestsRemoveAll;
 
+#pragma mark - Cassette Commands
+
+/**
+ *  Start recording all network requests performed by the app (and their responses) into a cassette stored in the app container.
+ *  Any previous content of the cassette is removed
+ *
+ *  @param name The name of the cassette
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)cassetteStartRecordingNamed:(nonnull NSString *)name;
+
+/**
+ *  Start serving network requests from a previously recorded cassette. Requests that weren't recorded fail with NSURLErrorNotConnectedToInternet
+ *
+ *  @param name The name of the cassette
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)cassetteStartReplayingNamed:(nonnull NSString *)name;
+
+/**
+ *  Start serving network requests from a previously recorded cassette. Requests that weren't recorded fail with NSURLErrorNotConnectedToInternet
+ *
+ *  @param name The name of the cassette
+ *  @param normalization Specifies which parts of the request are used to match recorded requests
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)cassetteStartReplayingNamed:(nonnull NSString *)name normalization:(nonnull SBTRequestNormalization *)normalization;
+
+/**
+ *  Stop recording or replaying cassettes
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)cassetteStop;
+
+/**
+ *  Load a cassette previously exported with -(NSData *)cassetteNamed: into the app container, replacing any existing cassette with the same name
+ *
+ *  @param cassette The exported cassette
+ *  @param name The name of the cassette
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)cassetteLoad:(nonnull NSData *)cassette named:(nonnull NSString *)name;
+
+/**
+ *  Export a cassette stored in the app container
+ *
+ *  @param name The name of the cassette
+ *
+ *  @return The cassette data, suitable to be persisted in the test bundle and loaded with -(BOOL)cassetteLoad:named:. nil if the cassette doesn't exist or request failed
+ */
+- (nullable NSData *)cassetteNamed:(nonnull NSString *)name;
+
+#pragma mark - HTTP Cache Commands
+
+/**
+ *  Enable the on-device HTTP cache for GET requests that reach the network. Cached responses are persisted in the app container
+ *  across launches and revalidated using their ETag and Last-Modified headers once stale. The cache can also be enabled at launch
+ *  by passing the SBTUITunneledApplicationLaunchOptionEnableHTTPCache launch option
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)httpCacheEnable;
+
+/**
+ *  Disable the on-device HTTP cache, requests will reach the network until the cache is enabled again
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)httpCacheDisable;
+
+/**
+ *  Remove all responses stored in the on-device HTTP cache and reset its statistics
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)httpCacheClear;
+
+/**
+ *  Get hits, revalidations and misses counters of the on-device HTTP cache
+ *
+ *  @return The cache statistics. nil if request failed
+ */
+- (nullable SBTHTTPCacheStatistics *)httpCacheStatistics;
+
+#pragma mark - Network Statistics Commands
+
+/**
+ *  Get request counters, transferred bytes and latency percentiles of every request that went through the tunnel
+ *  (monitored, stubbed, throttled, rewritten...), grouped by host and path template. Statistics are collected
+ *  without the need of a monitor and don't keep request or response bodies
+ *
+ *  @return The statistics of each endpoint, sorted by descending request count
+ */
+- (nonnull NSArray<SBTNetworkEndpointStatistics *> *)networkStatistics;
+
+/**
+ *  Reset the network statistics
+ *
+ *  @return `YES` on success
+ */
+- (BOOL)networkStatisticsReset;
+
 #pragma mark - NSUserDefaults Commands
 
 /**
@@ -433,6 +734,54 @@
  */
 - (nullable NSArray<NSData *> *)downloadItemsFromPath:(nonnull NSString *)path relativeTo:(NSSearchPathDirectory)baseFolder;
 
+#pragma mark - Asynchronous Commands
+
+/**
+ *  Stub a request matching a regular expression pattern without waiting for the app to install the stub.
+ *  Asynchronous commands are pipelined but executed by the app in the order they were sent, also with respect to synchronous commands.
+ *  Use -(BOOL)waitForPendingCommands to wait for all of them to complete. Over IPC commands are performed before returning.
+ *  Completion blocks of asynchronous commands are invoked one at a time on a serial background queue
+ *
+ *  @param match The match object that contains the matching rules
+ *  @param response The object that represents the stubbed response
+ *  @param completion Invoked on a background queue with the identifier associated to the newly created stub, nil if request failed
+ */
+- (void)stubRequestsMatching:(nonnull SBTRequestMatch *)match response:(nonnull SBTStubResponse *)response completion:(nullable void (^)(NSString * _Nullable stubId))completion NS_SWIFT_DISABLE_ASYNC;
+
+/**
+ *  Remove a specific stub without waiting for the app to remove it
+ *
+ *  @param stubId The identifier that was returned when adding the stub
+ *  @param completion Invoked on a background queue, with `NO` if the specified identifier wasn't associated to an active stub or request failed
+ */
+- (void)stubRequestsRemoveWithId:(nonnull NSString *)stubId completion:(nullable void (^)(BOOL removed))completion NS_SWIFT_NAME(stubRequestsRemove(id:completion:)) NS_SWIFT_DISABLE_ASYNC;
+
+/**
+ *  Perform custom command without waiting for it to complete
+ *
+ *  @param commandName custom name that will match [SBTUITestTunnelServer registerCustomCommandNamed:block:]
+ *  @param object optional data to be attached to request
+ *  @param completion Invoked on a background queue with the object returned from custom block
+ */
+- (void)performCustomCommandNamed:(nonnull NSString *)commandName object:(nullable id)object completion:(nullable void (^)(id _Nullable object))completion NS_SWIFT_DISABLE_ASYNC;
+
+/**
+ *  Waits for all asynchronous commands to complete, including their completion blocks
+ *
+ *  @return `YES` on success, `NO` on timeout
+ */
+- (BOOL)waitForPendingCommands;
+
+#pragma mark - IPC Statistics
+
+/**
+ *  Get the latency distribution of the commands sent over IPC since launch, measured from the test runner.
+ *  Commands sent over HTTP or frames are not accounted
+ *
+ *  @return A dictionary whose keys are the upper bound of every bucket in seconds (the last one being infinity) and values the number of commands in the bucket
+ */
+- (nonnull NSDictionary<NSNumber *, NSNumber *> *)ipcCommandLatencyHistogram;
+
 #pragma mark - Custom Commands
 
 /**
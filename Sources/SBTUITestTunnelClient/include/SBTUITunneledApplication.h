@@ -29,6 +29,8 @@
  *  SBTUITunneledApplicationLaunchOptionDisableUITextFieldAutocomplete disables UITextField's autocomplete functionality which can lead to unexpected results when typing text.
  *  SBTUITunneledApplicationLaunchOptionDisableKeepAlive: disables the keep alive functionality
  *  for the application.
+ *  SBTUITunneledApplicationLaunchOptionDisableFrameTunnel: sends commands as HTTP requests instead of frames over a persistent connection
+ *  SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel: on the simulator sends frames over loopback TCP instead of a unix domain socket
  *
  *  @param startupBlock Block that is executed before connection is estabilished.
  *  Useful to inject startup condition (user settings, preferences).
@@ -0,0 +1,52 @@
+// SBTTunnelFrameClient.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// The test runner end of the framed tunnel transport: a persistent connection to the app on which commands
+/// are sent as frames. Multiple commands can be in flight, responses are matched to commands by request identifier.
+@interface SBTTunnelFrameClient : NSObject
+
+- (nonnull instancetype)initWithPort:(NSInteger)port;
+
+/// Connects through a unix domain socket instead of a loopback port, only available when sharing the filesystem with the app (i.e. on the simulator)
+- (nonnull instancetype)initWithSocketPath:(nonnull NSString *)socketPath;
+
+/// YES while the connection to the app is open
+@property (nonatomic, readonly, getter=isConnected) BOOL connected;
+
+/// Connects to the app, returns NO if the app isn't listening
+- (BOOL)connect;
+
+/// Closes the connection, pending commands complete with a nil response
+- (void)disconnect;
+
+/**
+ *  Sends a command, commands are written in the order they are sent
+ *
+ *  @param command the command name
+ *  @param parameters the command parameters, strings or data values
+ *  @param written invoked on a private queue right before the command is written to the connection
+ *  @param completion invoked on a private serial queue with the response dictionary. If the connection is lost the
+ *  response is nil and `written` tells whether the app may have received the command, pending commands then fail in
+ *  the order they were sent
+ */
+- (void)sendCommand:(nonnull NSString *)command
+         parameters:(nullable NSDictionary<NSString *, id> *)parameters
+            written:(nullable void (^)(void))written
+         completion:(nonnull void (^)(NSDictionary * _Nullable response, BOOL written))completion;
+
+@end
@@ -0,0 +1,212 @@
+// SBTTunnelFrameClient.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import SBTUITestTunnelCommon;
+
+#import "SBTTunnelFrameClient.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+@interface SBTTunnelFrameClient()
+
+@property (nonatomic, assign) NSInteger port;
+@property (nonatomic, copy) NSString *socketPath;
+@property (nonatomic, strong) SBTTunnelFrameConnection *connection;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, void (^)(NSDictionary *, BOOL)> *pendingCompletions;
+@property (nonatomic, strong) NSMutableIndexSet *writtenRequestIds;
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
+@property (nonatomic, assign) uint32_t lastRequestId;
+
+@end
+
+@implementation SBTTunnelFrameClient
+
+- (instancetype)initWithPort:(NSInteger)port
+{
+    if ((self = [super init])) {
+        _port = port;
+        _pendingCompletions = [NSMutableDictionary dictionary];
+        _writtenRequestIds = [NSMutableIndexSet indexSet];
+        _completionQueue = dispatch_queue_create("com.sbtuitesttunnel.frame.completion", DISPATCH_QUEUE_SERIAL);
+    }
+
+    return self;
+}
+
+- (instancetype)initWithSocketPath:(NSString *)socketPath
+{
+    if ((self = [self initWithPort:0])) {
+        _socketPath = [socketPath copy];
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [_connection cancel];
+}
+
+- (BOOL)isConnected
+{
+    return self.connection.isOpen;
+}
+
+- (BOOL)connect
+{
+    int connectionSocket = self.socketPath ? [self connectUnixSocket] : [self connectTCPSocket];
+    if (connectionSocket < 0) {
+        return NO;
+    }
+
+    __weak typeof(self) weakSelf = self;
+    SBTTunnelFrameConnection *connection = [[SBTTunnelFrameConnection alloc] initWithFileDescriptor:connectionSocket frameHandler:^(SBTTunnelFrame *frame) {
+        [weakSelf completeFrame:frame];
+    }];
+    connection.closeHandler = ^{
+        NSLog(@"[SBTUITestTunnel] Frame tunnel connection closed");
+        [weakSelf failPendingCompletions];
+    };
+
+    self.connection = connection;
+    [connection resume];
+
+    return YES;
+}
+
+- (int)connectTCPSocket
+{
+    int connectionSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (connectionSocket < 0) {
+        return -1;
+    }
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)self.port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (connect(connectionSocket, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        close(connectionSocket);
+        return -1;
+    }
+
+    return connectionSocket;
+}
+
+- (int)connectUnixSocket
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    const char *path = self.socketPath.fileSystemRepresentation;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    strlcpy(address.sun_path, path, sizeof(address.sun_path));
+    address.sun_len = (uint8_t)SUN_LEN(&address);
+
+    int connectionSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connectionSocket < 0) {
+        return -1;
+    }
+
+    if (connect(connectionSocket, (struct sockaddr *)&address, SUN_LEN(&address)) != 0) {
+        close(connectionSocket);
+        return -1;
+    }
+
+    return connectionSocket;
+}
+
+- (void)disconnect
+{
+    [self.connection cancel];
+    self.connection = nil;
+}
+
+- (void)sendCommand:(NSString *)command parameters:(NSDictionary<NSString *, id> *)parameters written:(void (^)(void))written completion:(void (^)(NSDictionary *, BOOL))completion
+{
+    SBTTunnelFrameConnection *connection = self.connection;
+
+    __weak typeof(self) weakSelf = self;
+    @synchronized (self.pendingCompletions) {
+        uint32_t requestId = ++self.lastRequestId;
+        self.pendingCompletions[@(requestId)] = completion;
+
+        // frames are queued under the lock so that they're written in request identifier order
+        [connection sendFrame:[SBTTunnelFrame commandFrameWithRequestId:requestId command:command parameters:parameters] willWrite:^{
+            [weakSelf markRequestIdWritten:requestId];
+            if (written != nil) {
+                written();
+            }
+        }];
+    }
+
+    if (!connection.isOpen) {
+        // not connected or closed before the completion was registered, fails in order with the other pending commands
+        [self failPendingCompletions];
+    }
+}
+
+- (void)markRequestIdWritten:(uint32_t)requestId
+{
+    @synchronized (self.pendingCompletions) {
+        [self.writtenRequestIds addIndex:requestId];
+    }
+}
+
+- (void)completeFrame:(SBTTunnelFrame *)frame
+{
+    NSDictionary *response = [frame payloadDictionary] ?: @{};
+
+    @synchronized (self.pendingCompletions) {
+        void (^completion)(NSDictionary *, BOOL) = self.pendingCompletions[@(frame.requestId)];
+        [self.pendingCompletions removeObjectForKey:@(frame.requestId)];
+        [self.writtenRequestIds removeIndex:frame.requestId];
+
+        if (completion != nil) {
+            dispatch_async(self.completionQueue, ^{
+                completion(response, YES);
+            });
+        }
+    }
+}
+
+- (void)failPendingCompletions
+{
+    @synchronized (self.pendingCompletions) {
+        // in the order commands were sent, those never written can then be sent again in order by the caller
+        NSArray<NSNumber *> *requestIds = [self.pendingCompletions.allKeys sortedArrayUsingSelector:@selector(compare:)];
+        for (NSNumber *requestId in requestIds) {
+            void (^completion)(NSDictionary *, BOOL) = self.pendingCompletions[requestId];
+            BOOL written = [self.writtenRequestIds containsIndex:requestId.unsignedIntValue];
+            dispatch_async(self.completionQueue, ^{
+                completion(nil, written);
+            });
+        }
+
+        [self.pendingCompletions removeAllObjects];
+        [self.writtenRequestIds removeAllIndexes];
+    }
+}
+
+@end
@@ -20,15 +20,20 @@
 #define ERROR_OR_ASSERT_V(condition, ...) _ERROR_OR_ASSERT(condition, __VA_ARGS__); if((condition) == NO) { return; }
 #define ERROR_OR_ASSERT_NV(condition, ...) _ERROR_OR_ASSERT(condition, __VA_ARGS__); if((condition) == NO) { return nil; }
 
+//Replies wake the waiting caller directly, this only controls how often the connection is checked while no reply arrives.
+static const NSTimeInterval _DTXIPCLivenessCheckInterval = 0.5;
+
 @implementation _DTXIPCDistantObject
 {
 	DTXIPCConnection* _connection;
 	void (^_errorBlock)(NSError*);
 	
 	pthread_mutex_t _pendingMutex;
+	pthread_cond_t _pendingCondition;
 	NSMutableArray<_DTXIPCExportedObject*>* _pendingRemoteBlocks;
 	
-	dispatch_group_t _pendingDispatchGroup;
+	BOOL _waitingForReplies;
+	NSUInteger _pendingReplyBlockCount;
 }
 
 + (instancetype)_distantObjectWithConnection:(DTXIPCConnection*)connection synchronous:(BOOL)synchronous errorBlock:(void(^)(NSError*))errorBlock
@@ -39,6 +44,7 @@
 	rv->_errorBlock = errorBlock;
 	rv->_pendingRemoteBlocks = [NSMutableArray new];
 	pthread_mutex_init(&(rv->_pendingMutex), NULL);
+	pthread_cond_init(&(rv->_pendingCondition), NULL);
 	
 	NSString* className = [NSString stringWithFormat:@"_DTXIPCDistantObject_<%@>", NSStringFromProtocol(rv->_connection.remoteObjectInterface.protocol)];
 	Class cls = objc_getClass(className.UTF8String);
@@ -55,6 +61,7 @@
 
 - (void)dealloc
 {
+	pthread_cond_destroy(&_pendingCondition);
 	pthread_mutex_destroy(&_pendingMutex);
 }
 
@@ -73,9 +80,9 @@
 {
 	if(_synchronous)
 	{
-		ERROR_OR_ASSERT_V(_pendingDispatchGroup == nil, @"You must not send messages from multiple threads to synchronous proxies.");
+		ERROR_OR_ASSERT_V(_waitingForReplies == NO, @"You must not send messages from multiple threads to synchronous proxies.");
 		
-		_pendingDispatchGroup = dispatch_group_create();
+		_waitingForReplies = YES;
 	}
 	
 	NSDictionary* serialized = [invocation _dtx_serializedDictionaryForDistantObject:self];
@@ -85,42 +92,58 @@
 
 	if(_synchronous)
 	{
-		BOOL somethingWentWrong = NO;
-		BOOL didEndWaiting = NO;
+		[self _waitForReplies];
 		
-		do {
-			didEndWaiting = dispatch_group_wait(_pendingDispatchGroup, dispatch_walltime(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC))) == 0;
-			
-			if(didEndWaiting == NO)
-			{
-				@try {
-					//Send a ping to check if the connection is still alive while waiting.
-					[_connection.otherConnection.rootProxy _ping];
-				} @catch (NSException *exception) {
-					if(_errorBlock)
-					{
-						_errorBlock([NSError errorWithDomain:DTXIPCErrorDomain code:1 userInfo:@{NSLocalizedDescriptionKey: exception.reason}]);
-					}
-					else
-					{
-						[exception raise];
-					}
-					somethingWentWrong = YES;
-				}
-			}
-		} while(somethingWentWrong == NO && didEndWaiting == NO);
+		_waitingForReplies = NO;
+	}
+}
 
-		if(didEndWaiting)
+- (void)_waitForReplies
+{
+	BOOL somethingWentWrong = NO;
+	
+	pthread_mutex_lock(&_pendingMutex);
+	while(somethingWentWrong == NO && (_pendingReplyBlockCount > 0 || _pendingRemoteBlocks.count > 0))
+	{
+		if(_pendingRemoteBlocks.count > 0)
 		{
-			pthread_mutex_lock_deferred_unlock(&self->_pendingMutex);
-			[_pendingRemoteBlocks enumerateObjectsUsingBlock:^(_DTXIPCExportedObject * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
+			//Reply blocks run on the calling thread as soon as they arrive, without waiting for the remote end to release them.
+			NSArray<_DTXIPCExportedObject*>* remoteBlocks = [_pendingRemoteBlocks copy];
+			[_pendingRemoteBlocks removeAllObjects];
+			
+			pthread_mutex_unlock(&_pendingMutex);
+			[remoteBlocks enumerateObjectsUsingBlock:^(_DTXIPCExportedObject * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
 				[obj invoke];
 			}];
-			[_pendingRemoteBlocks removeAllObjects];
+			pthread_mutex_lock(&_pendingMutex);
+			
+			continue;
+		}
+		
+		struct timespec interval = { .tv_sec = 0, .tv_nsec = (long)(_DTXIPCLivenessCheckInterval * NSEC_PER_SEC) };
+		if(pthread_cond_timedwait_relative_np(&_pendingCondition, &_pendingMutex, &interval) != ETIMEDOUT)
+		{
+			continue;
 		}
 		
-		_pendingDispatchGroup = nil;
+		pthread_mutex_unlock(&_pendingMutex);
+		@try {
+			//Send a ping to check if the connection is still alive while waiting.
+			[_connection.otherConnection.rootProxy _ping];
+		} @catch (NSException *exception) {
+			if(_errorBlock)
+			{
+				_errorBlock([NSError errorWithDomain:DTXIPCErrorDomain code:1 userInfo:@{NSLocalizedDescriptionKey: exception.reason}]);
+			}
+			else
+			{
+				[exception raise];
+			}
+			somethingWentWrong = YES;
+		}
+		pthread_mutex_lock(&_pendingMutex);
 	}
+	pthread_mutex_unlock(&_pendingMutex);
 }
 
 - (void)_enterReplyBlock
@@ -130,7 +153,8 @@
 		return;
 	}
 	
-	dispatch_group_enter(_pendingDispatchGroup);
+	pthread_mutex_lock_deferred_unlock(&self->_pendingMutex);
+	_pendingReplyBlockCount += 1;
 }
 
 - (void)_leavelReplyBlock
@@ -140,7 +164,9 @@
 		return;
 	}
 	
-	dispatch_group_leave(_pendingDispatchGroup);
+	pthread_mutex_lock_deferred_unlock(&self->_pendingMutex);
+	_pendingReplyBlockCount -= 1;
+	pthread_cond_signal(&_pendingCondition);
 }
 
 - (BOOL)_enqueueSynchronousExportedObjectInvocation:(_DTXIPCExportedObject*)object
@@ -152,6 +178,7 @@
 
 	pthread_mutex_lock_deferred_unlock(&self->_pendingMutex);
 	[_pendingRemoteBlocks addObject:object];
+	pthread_cond_signal(&_pendingCondition);
 	
 	return YES;
 }
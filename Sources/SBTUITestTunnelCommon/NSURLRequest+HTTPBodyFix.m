@@ -18,6 +18,7 @@
 #import "include/SBTUITestTunnel.h"
 #import "include/SBTSwizzleHelpers.h"
 #import "include/SBTRequestPropertyStorage.h"
+#import "include/SBTTeeInputStream.h"
 
 @implementation NSURLRequest (HTTPBodyFix)
 
@@ -42,6 +43,12 @@ NSString * const SBTUITunneledNSURLProtocolIsUploadTaskKey = @"SBTUITunneledNSUR
         return nil;
     }
 
+    // Body streams are one-shot: once a stream was read (or is being sent upstream through a
+    // SBTTeeInputStream) return the captured copy instead of attempting to read it again
+    if ([SBTTeeInputStream isCapturingStream:stream]) {
+        return [SBTTeeInputStream capturedDataForStream:stream];
+    }
+
     NSMutableData *data = [NSMutableData data];
     uint8_t buffer[4096];
 
@@ -64,7 +71,13 @@ NSString * const SBTUITunneledNSURLProtocolIsUploadTaskKey = @"SBTUITunneledNSUR
         }
     }
 
-    return data.length > 0 ? data : nil;
+    if (data.length == 0) {
+        return nil;
+    }
+
+    [SBTTeeInputStream setCapturedData:data forStream:stream];
+
+    return data;
 }
 
 - (NSData *)sbt_uploadHTTPBody
@@ -0,0 +1,59 @@
+// SBTHTTPCacheStatistics.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTHTTPCacheStatistics.h"
+
+@implementation SBTHTTPCacheStatistics
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        self.hits = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(hits))];
+        self.revalidations = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(revalidations))];
+        self.misses = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(misses))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeInteger:self.hits forKey:NSStringFromSelector(@selector(hits))];
+    [encoder encodeInteger:self.revalidations forKey:NSStringFromSelector(@selector(revalidations))];
+    [encoder encodeInteger:self.misses forKey:NSStringFromSelector(@selector(misses))];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    SBTHTTPCacheStatistics *copy = [[SBTHTTPCacheStatistics allocWithZone:zone] init];
+
+    copy.hits = self.hits;
+    copy.revalidations = self.revalidations;
+    copy.misses = self.misses;
+
+    return copy;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"Hits: %lu, revalidations: %lu, misses: %lu", (unsigned long)self.hits, (unsigned long)self.revalidations, (unsigned long)self.misses];
+}
+
+@end
@@ -0,0 +1,125 @@
+// SBTMonitorCapturePolicy.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTMonitorCapturePolicy.h"
+#import "include/SBTMonitoredNetworkRequest.h"
+
+@implementation SBTMonitorCapturePolicy
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
++ (instancetype)defaultPolicy
+{
+    return [[self alloc] init];
+}
+
+- (instancetype)init
+{
+    return [self initWithMaximumRequestBodyLength:0 maximumResponseBodyLength:0 sampling:SBTMonitorCaptureSamplingHead compressesBodies:NO];
+}
+
+- (instancetype)initWithMaximumRequestBodyLength:(NSUInteger)maximumRequestBodyLength maximumResponseBodyLength:(NSUInteger)maximumResponseBodyLength sampling:(SBTMonitorCaptureSampling)sampling compressesBodies:(BOOL)compressesBodies
+{
+    if (self = [super init]) {
+        self.maximumRequestBodyLength = maximumRequestBodyLength;
+        self.maximumResponseBodyLength = maximumResponseBodyLength;
+        self.sampling = sampling;
+        self.compressesBodies = compressesBodies;
+    }
+
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        self.maximumRequestBodyLength = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(maximumRequestBodyLength))];
+        self.maximumResponseBodyLength = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(maximumResponseBodyLength))];
+        self.sampling = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(sampling))];
+        self.compressesBodies = [decoder decodeBoolForKey:NSStringFromSelector(@selector(compressesBodies))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeInteger:self.maximumRequestBodyLength forKey:NSStringFromSelector(@selector(maximumRequestBodyLength))];
+    [encoder encodeInteger:self.maximumResponseBodyLength forKey:NSStringFromSelector(@selector(maximumResponseBodyLength))];
+    [encoder encodeInteger:self.sampling forKey:NSStringFromSelector(@selector(sampling))];
+    [encoder encodeBool:self.compressesBodies forKey:NSStringFromSelector(@selector(compressesBodies))];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return [[SBTMonitorCapturePolicy allocWithZone:zone] initWithMaximumRequestBodyLength:self.maximumRequestBodyLength
+                                                                maximumResponseBodyLength:self.maximumResponseBodyLength
+                                                                                 sampling:self.sampling
+                                                                         compressesBodies:self.compressesBodies];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"Maximum request body length: %lu\nMaximum response body length: %lu\nSampling: %@\nCompresses bodies: %@", (unsigned long)self.maximumRequestBodyLength, (unsigned long)self.maximumResponseBodyLength, self.sampling == SBTMonitorCaptureSamplingHeadAndTail ? @"head and tail" : @"head", self.compressesBodies ? @"YES" : @"NO"];
+}
+
+#pragma mark - Capture
+
+- (void)applyToRequest:(SBTMonitoredNetworkRequest *)request
+{
+    NSData *requestData = request.requestData;
+    NSData *responseData = request.responseData;
+
+    request.requestDataOriginalLength = requestData.length;
+    request.responseDataOriginalLength = responseData.length;
+    request.bodySampling = self.sampling;
+
+    // bodies are cleared so that only the sampled bytes get compressed
+    request.requestData = nil;
+    request.responseData = nil;
+    request.compressesBodiesInMemory = self.compressesBodies;
+
+    request.requestData = [SBTMonitorCapturePolicy sampleData:requestData maximumLength:self.maximumRequestBodyLength sampling:self.sampling];
+    request.responseData = [SBTMonitorCapturePolicy sampleData:responseData maximumLength:self.maximumResponseBodyLength sampling:self.sampling];
+}
+
++ (NSData *)sampleData:(NSData *)data maximumLength:(NSUInteger)maximumLength sampling:(SBTMonitorCaptureSampling)sampling
+{
+    if (maximumLength == 0 || data.length <= maximumLength) {
+        return data;
+    }
+
+    // subdata copies the bytes, releasing the reference to the whole body
+    switch (sampling) {
+        case SBTMonitorCaptureSamplingHeadAndTail: {
+            NSUInteger headLength = maximumLength / 2;
+            NSUInteger tailLength = maximumLength - headLength;
+
+            NSMutableData *ret = [NSMutableData dataWithCapacity:maximumLength];
+            [ret appendBytes:data.bytes length:headLength];
+            [ret appendBytes:(const uint8_t *)data.bytes + data.length - tailLength length:tailLength];
+            return ret;
+        }
+        case SBTMonitorCaptureSamplingHead:
+        default:
+            return [data subdataWithRange:NSMakeRange(0, maximumLength)];
+    }
+}
+
+@end
@@ -0,0 +1,118 @@
+// SBTMonitoredNetworkEndpointTiming.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTMonitoredNetworkEndpointTiming.h"
+#import "include/SBTMonitoredNetworkRequest.h"
+#import "include/SBTMonitoredNetworkRequestTiming.h"
+
+@interface SBTMonitoredNetworkEndpointTiming()
+
+@property (nonatomic, assign) int64_t requestHeaderBytes;
+@property (nonatomic, assign) int64_t requestBodyBytes;
+@property (nonatomic, assign) int64_t responseHeaderBytes;
+@property (nonatomic, assign) int64_t responseBodyBytes;
+
+@end
+
+@implementation SBTMonitoredNetworkEndpointTiming
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
++ (NSArray<SBTMonitoredNetworkEndpointTiming *> *)endpointTimingsWithRequests:(NSArray<SBTMonitoredNetworkRequest *> *)requests
+{
+    NSMutableDictionary<NSString *, SBTMonitoredNetworkEndpointTiming *> *endpointTimings = [NSMutableDictionary dictionary];
+
+    for (SBTMonitoredNetworkRequest *request in requests) {
+        SBTMonitoredNetworkRequestTiming *timing = request.timing;
+        if (timing == nil || request.isStubbed) {
+            continue;
+        }
+
+        NSURLRequest *urlRequest = request.originalRequest ?: request.request;
+        NSString *endpoint = [NSString stringWithFormat:@"%@ %@%@", urlRequest.HTTPMethod ?: @"GET", urlRequest.URL.host ?: @"", urlRequest.URL.path ?: @""];
+
+        SBTMonitoredNetworkEndpointTiming *endpointTiming = endpointTimings[endpoint];
+        if (endpointTiming == nil) {
+            endpointTiming = [[SBTMonitoredNetworkEndpointTiming alloc] init];
+            endpointTiming.endpoint = endpoint;
+            endpointTiming.averageTiming = [[SBTMonitoredNetworkRequestTiming alloc] init];
+            endpointTimings[endpoint] = endpointTiming;
+        }
+
+        [endpointTiming addTiming:timing];
+    }
+
+    return [endpointTimings.allValues sortedArrayUsingComparator:^NSComparisonResult(SBTMonitoredNetworkEndpointTiming *lhs, SBTMonitoredNetworkEndpointTiming *rhs) {
+        NSTimeInterval lhsTotal = lhs.averageTiming.totalDuration * lhs.count;
+        NSTimeInterval rhsTotal = rhs.averageTiming.totalDuration * rhs.count;
+
+        return lhsTotal > rhsTotal ? NSOrderedAscending : (lhsTotal < rhsTotal ? NSOrderedDescending : NSOrderedSame);
+    }];
+}
+
+- (void)addTiming:(SBTMonitoredNetworkRequestTiming *)timing
+{
+    SBTMonitoredNetworkRequestTiming *average = self.averageTiming;
+    double n = (double)++self.count;
+
+    average.domainLookupDuration += (timing.domainLookupDuration - average.domainLookupDuration) / n;
+    average.connectDuration += (timing.connectDuration - average.connectDuration) / n;
+    average.secureConnectionDuration += (timing.secureConnectionDuration - average.secureConnectionDuration) / n;
+    average.requestDuration += (timing.requestDuration - average.requestDuration) / n;
+    average.timeToFirstByte += (timing.timeToFirstByte - average.timeToFirstByte) / n;
+    average.responseDuration += (timing.responseDuration - average.responseDuration) / n;
+    average.totalDuration += (timing.totalDuration - average.totalDuration) / n;
+    self.requestHeaderBytes += timing.requestHeaderBytes;
+    self.requestBodyBytes += timing.requestBodyBytes;
+    self.responseHeaderBytes += timing.responseHeaderBytes;
+    self.responseBodyBytes += timing.responseBodyBytes;
+    average.requestHeaderBytes = self.requestHeaderBytes / (int64_t)self.count;
+    average.requestBodyBytes = self.requestBodyBytes / (int64_t)self.count;
+    average.responseHeaderBytes = self.responseHeaderBytes / (int64_t)self.count;
+    average.responseBodyBytes = self.responseBodyBytes / (int64_t)self.count;
+    average.networkProtocolName = timing.networkProtocolName ?: average.networkProtocolName;
+
+    self.maximumDuration = MAX(self.maximumDuration, timing.totalDuration);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        self.endpoint = [decoder decodeObjectOfClass:[NSString class] forKey:NSStringFromSelector(@selector(endpoint))] ?: @"";
+        self.count = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(count))];
+        self.averageTiming = [decoder decodeObjectOfClass:[SBTMonitoredNetworkRequestTiming class] forKey:NSStringFromSelector(@selector(averageTiming))] ?: [[SBTMonitoredNetworkRequestTiming alloc] init];
+        self.maximumDuration = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(maximumDuration))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeObject:self.endpoint forKey:NSStringFromSelector(@selector(endpoint))];
+    [encoder encodeInteger:self.count forKey:NSStringFromSelector(@selector(count))];
+    [encoder encodeObject:self.averageTiming forKey:NSStringFromSelector(@selector(averageTiming))];
+    [encoder encodeDouble:self.maximumDuration forKey:NSStringFromSelector(@selector(maximumDuration))];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@ x%lu, max: %.3fs, average %@", self.endpoint, (unsigned long)self.count, self.maximumDuration, self.averageTiming];
+}
+
+@end
@@ -15,11 +15,25 @@
 // limitations under the License.
 
 #import "include/SBTMonitoredNetworkRequest.h"
+#import "include/SBTMonitoredNetworkRequestTiming.h"
 #import "include/SBTRequestMatch.h"
 #import "include/SBTRequestPropertyStorage.h"
 #import "include/SBTUITestTunnel.h"
 #import "private/NSData+gzip.h"
 
+@interface SBTMonitoredNetworkRequest()
+{
+    NSData *_requestData;
+    NSData *_responseData;
+}
+
+@property (nonatomic, assign) NSUInteger requestDataLength;
+@property (nonatomic, assign) NSUInteger responseDataLength;
+@property (nonatomic, assign) BOOL isRequestDataCompressed;
+@property (nonatomic, assign) BOOL isResponseDataCompressed;
+
+@end
+
 @implementation SBTMonitoredNetworkRequest : NSObject
 
 + (BOOL)supportsSecureCoding {
@@ -29,8 +43,10 @@
 - (instancetype)initWithCoder:(NSCoder *)decoder
 {
     if (self = [super init]) {
+        self.sequenceNumber = (NSUInteger)[decoder decodeInt64ForKey:NSStringFromSelector(@selector(sequenceNumber))];
         self.timestamp = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(timestamp))];
         self.requestTime = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(requestTime))];
+        self.timing = [decoder decodeObjectOfClass:[SBTMonitoredNetworkRequestTiming class] forKey:NSStringFromSelector(@selector(timing))];
         self.request = [decoder decodeObjectOfClass:[NSURLRequest class] forKey:NSStringFromSelector(@selector(request))];
         self.originalRequest = [decoder decodeObjectOfClass:[NSURLRequest class] forKey:NSStringFromSelector(@selector(originalRequest))];
         self.response = [decoder decodeObjectOfClasses:[NSSet setWithObjects:[NSHTTPURLResponse class], [NSString class], [NSURLResponse class], nil] forKey:NSStringFromSelector(@selector(response))];
@@ -38,6 +54,13 @@
         self.isStubbed = [decoder decodeBoolForKey:NSStringFromSelector(@selector(isStubbed))];
         self.isRewritten = [decoder decodeBoolForKey:NSStringFromSelector(@selector(isRewritten))];
         self.requestData = [decoder decodeObjectOfClass:[NSData class] forKey:NSStringFromSelector(@selector(requestData))];
+        self.bodySampling = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(bodySampling))];
+
+        // archives of older versions don't contain original lengths
+        NSString *requestDataOriginalLengthKey = NSStringFromSelector(@selector(requestDataOriginalLength));
+        NSString *responseDataOriginalLengthKey = NSStringFromSelector(@selector(responseDataOriginalLength));
+        self.requestDataOriginalLength = [decoder containsValueForKey:requestDataOriginalLengthKey] ? (NSUInteger)[decoder decodeInt64ForKey:requestDataOriginalLengthKey] : self.requestDataLength;
+        self.responseDataOriginalLength = [decoder containsValueForKey:responseDataOriginalLengthKey] ? (NSUInteger)[decoder decodeInt64ForKey:responseDataOriginalLengthKey] : self.responseDataLength;
     }
     
     return self;
@@ -45,8 +68,10 @@
 
 - (void)encodeWithCoder:(NSCoder *)encoder
 {
+    [encoder encodeInt64:(int64_t)self.sequenceNumber forKey:NSStringFromSelector(@selector(sequenceNumber))];
     [encoder encodeDouble:self.timestamp forKey:NSStringFromSelector(@selector(timestamp))];
     [encoder encodeDouble:self.requestTime forKey:NSStringFromSelector(@selector(requestTime))];
+    [encoder encodeObject:self.timing forKey:NSStringFromSelector(@selector(timing))];
     
     NSMutableURLRequest *fixedRequest = [self.request mutableCopy];
     fixedRequest.HTTPBody = [SBTRequestPropertyStorage propertyForKey:SBTUITunneledNSURLProtocolHTTPBodyKey inRequest:self.request];
@@ -61,6 +86,75 @@
     [encoder encodeObject:self.requestData forKey:NSStringFromSelector(@selector(requestData))];
     [encoder encodeBool:self.isStubbed forKey:NSStringFromSelector(@selector(isStubbed))];
     [encoder encodeBool:self.isRewritten forKey:NSStringFromSelector(@selector(isRewritten))];
+    [encoder encodeInt64:(int64_t)self.requestDataOriginalLength forKey:NSStringFromSelector(@selector(requestDataOriginalLength))];
+    [encoder encodeInt64:(int64_t)self.responseDataOriginalLength forKey:NSStringFromSelector(@selector(responseDataOriginalLength))];
+    [encoder encodeInteger:self.bodySampling forKey:NSStringFromSelector(@selector(bodySampling))];
+}
+
+#pragma mark - Bodies
+
+- (NSData *)requestData
+{
+    return self.isRequestDataCompressed ? [_requestData gzipInflate] : _requestData;
+}
+
+- (void)setRequestData:(NSData *)requestData
+{
+    self.requestDataLength = requestData.length;
+
+    NSData *compressedData = self.compressesBodiesInMemory ? [self compressedData:requestData] : nil;
+    self.isRequestDataCompressed = compressedData != nil;
+    _requestData = compressedData ?: requestData;
+}
+
+- (NSData *)responseData
+{
+    return self.isResponseDataCompressed ? [_responseData gzipInflate] : _responseData;
+}
+
+- (void)setResponseData:(NSData *)responseData
+{
+    self.responseDataLength = responseData.length;
+
+    NSData *compressedData = self.compressesBodiesInMemory ? [self compressedData:responseData] : nil;
+    self.isResponseDataCompressed = compressedData != nil;
+    _responseData = compressedData ?: responseData;
+}
+
+- (void)setCompressesBodiesInMemory:(BOOL)compressesBodiesInMemory
+{
+    if (_compressesBodiesInMemory == compressesBodiesInMemory) {
+        return;
+    }
+
+    NSData *requestData = self.requestData;
+    NSData *responseData = self.responseData;
+
+    _compressesBodiesInMemory = compressesBodiesInMemory;
+
+    self.requestData = requestData;
+    self.responseData = responseData;
+}
+
+- (NSData *)compressedData:(NSData *)data
+{
+    if (data.length == 0) {
+        return nil;
+    }
+
+    // already compressed payloads (e.g. images) are kept as they are
+    NSData *ret = [data gzipDeflate];
+    return ret.length < data.length ? ret : nil;
+}
+
+- (BOOL)isRequestDataTruncated
+{
+    return self.requestDataOriginalLength > self.requestDataLength;
+}
+
+- (BOOL)isResponseDataTruncated
+{
+    return self.responseDataOriginalLength > self.responseDataLength;
 }
 
 - (NSString *)description
@@ -0,0 +1,640 @@
+// SBTMonitoredNetworkRequestBinaryCoder.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTMonitoredNetworkRequestBinaryCoder.h"
+#import "include/SBTMonitoredNetworkRequest.h"
+#import "include/SBTMonitoredNetworkRequestTiming.h"
+#import "include/SBTRequestPropertyStorage.h"
+#import "include/SBTUITestTunnel.h"
+#import "private/NSData+gzip.h"
+
+static const uint8_t SBTBinaryCoderMagic[4] = { 'S', 'B', 'T', 'M' };
+static const uint8_t SBTBinaryCoderVersion = 1;
+static const uint8_t SBTBinaryCoderCompressedFlag = 0x80;
+static const NSUInteger SBTBinaryCoderCompressionThreshold = 512;
+
+typedef NS_ENUM(uint8_t, SBTBinaryCoderEntryTag) {
+    SBTBinaryCoderEntryTagSequenceNumber = 1,
+    SBTBinaryCoderEntryTagTimestamp = 2,
+    SBTBinaryCoderEntryTagRequestTime = 3,
+    SBTBinaryCoderEntryTagFlags = 4,
+    SBTBinaryCoderEntryTagRequest = 5,
+    SBTBinaryCoderEntryTagOriginalRequest = 6,
+    SBTBinaryCoderEntryTagResponse = 7,
+    SBTBinaryCoderEntryTagRequestData = 8,
+    SBTBinaryCoderEntryTagResponseData = 9,
+    SBTBinaryCoderEntryTagTiming = 10,
+    SBTBinaryCoderEntryTagRequestDataOriginalLength = 11,
+    SBTBinaryCoderEntryTagResponseDataOriginalLength = 12,
+    SBTBinaryCoderEntryTagBodySampling = 13,
+};
+
+typedef NS_ENUM(uint8_t, SBTBinaryCoderMessageTag) {
+    SBTBinaryCoderMessageTagURL = 1,
+    SBTBinaryCoderMessageTagMethod = 2,
+    SBTBinaryCoderMessageTagHeader = 3,
+    SBTBinaryCoderMessageTagBody = 4,
+    SBTBinaryCoderMessageTagStatusCode = 5,
+};
+
+typedef NS_ENUM(uint8_t, SBTBinaryCoderTimingTag) {
+    SBTBinaryCoderTimingTagDomainLookup = 1,
+    SBTBinaryCoderTimingTagConnect = 2,
+    SBTBinaryCoderTimingTagSecureConnection = 3,
+    SBTBinaryCoderTimingTagRequest = 4,
+    SBTBinaryCoderTimingTagTimeToFirstByte = 5,
+    SBTBinaryCoderTimingTagResponse = 6,
+    SBTBinaryCoderTimingTagTotal = 7,
+    SBTBinaryCoderTimingTagRequestHeaderBytes = 8,
+    SBTBinaryCoderTimingTagRequestBodyBytes = 9,
+    SBTBinaryCoderTimingTagResponseHeaderBytes = 10,
+    SBTBinaryCoderTimingTagResponseBodyBytes = 11,
+    SBTBinaryCoderTimingTagProtocol = 12,
+    SBTBinaryCoderTimingTagReusedConnection = 13,
+    SBTBinaryCoderTimingTagRedirectCount = 14,
+};
+
+typedef NS_OPTIONS(uint64_t, SBTBinaryCoderFlags) {
+    SBTBinaryCoderFlagsStubbed = 1 << 0,
+    SBTBinaryCoderFlagsRewritten = 1 << 1,
+};
+
+#pragma mark - Writing
+
+static void SBTWriteVarint(NSMutableData *data, uint64_t value)
+{
+    uint8_t buffer[10];
+    NSUInteger length = 0;
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        buffer[length++] = byte | (value ? 0x80 : 0);
+    } while (value);
+
+    [data appendBytes:buffer length:length];
+}
+
+static void SBTWriteField(NSMutableData *data, uint8_t tag, const void *bytes, NSUInteger length)
+{
+    [data appendBytes:&tag length:1];
+    SBTWriteVarint(data, length);
+    [data appendBytes:bytes length:length];
+}
+
+static void SBTWriteDataField(NSMutableData *data, uint8_t tag, NSData *value, BOOL compress)
+{
+    if (value.length == 0) {
+        return;
+    }
+
+    if (compress && value.length >= SBTBinaryCoderCompressionThreshold) {
+        NSData *compressed = [value gzipDeflate];
+        if (compressed.length > 0 && compressed.length < value.length) {
+            SBTWriteField(data, tag | SBTBinaryCoderCompressedFlag, compressed.bytes, compressed.length);
+            return;
+        }
+    }
+
+    SBTWriteField(data, tag, value.bytes, value.length);
+}
+
+static void SBTWriteStringField(NSMutableData *data, uint8_t tag, NSString *value)
+{
+    if (value == nil) {
+        return;
+    }
+
+    const char *utf8 = value.UTF8String;
+    SBTWriteField(data, tag, utf8, strlen(utf8));
+}
+
+static void SBTWriteVarintField(NSMutableData *data, uint8_t tag, uint64_t value)
+{
+    NSMutableData *payload = [NSMutableData dataWithCapacity:10];
+    SBTWriteVarint(payload, value);
+    SBTWriteField(data, tag, payload.bytes, payload.length);
+}
+
+static void SBTWriteDoubleField(NSMutableData *data, uint8_t tag, double value)
+{
+    CFSwappedFloat64 swapped = CFConvertDoubleHostToSwapped(value);
+    SBTWriteField(data, tag, &swapped, sizeof(swapped));
+}
+
+#pragma mark - Reading
+
+typedef struct {
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger offset;
+} SBTReader;
+
+static BOOL SBTReadVarint(SBTReader *reader, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (NSUInteger shift = 0; shift < 64; shift += 7) {
+        if (reader->offset >= reader->length) {
+            return NO;
+        }
+
+        uint8_t byte = reader->bytes[reader->offset++];
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return YES;
+        }
+    }
+
+    return NO;
+}
+
+static BOOL SBTReadField(SBTReader *reader, uint8_t *tag, SBTReader *payload)
+{
+    if (reader->offset >= reader->length) {
+        return NO;
+    }
+    *tag = reader->bytes[reader->offset++];
+
+    uint64_t length = 0;
+    if (!SBTReadVarint(reader, &length) || length > reader->length - reader->offset) {
+        return NO;
+    }
+
+    *payload = (SBTReader){ reader->bytes + reader->offset, (NSUInteger)length, 0 };
+    reader->offset += (NSUInteger)length;
+
+    return YES;
+}
+
+static NSData *SBTPayloadData(SBTReader payload, uint8_t tag)
+{
+    NSData *data = [NSData dataWithBytes:payload.bytes length:payload.length];
+
+    return (tag & SBTBinaryCoderCompressedFlag) ? [data gzipInflate] : data;
+}
+
+static NSString *SBTPayloadString(SBTReader payload)
+{
+    return [[NSString alloc] initWithBytes:payload.bytes length:payload.length encoding:NSUTF8StringEncoding];
+}
+
+static uint64_t SBTPayloadVarint(SBTReader payload)
+{
+    uint64_t value = 0;
+    SBTReadVarint(&payload, &value);
+
+    return value;
+}
+
+static double SBTPayloadDouble(SBTReader payload)
+{
+    CFSwappedFloat64 swapped = { 0 };
+    if (payload.length == sizeof(swapped)) {
+        memcpy(&swapped, payload.bytes, sizeof(swapped));
+    }
+
+    return CFConvertDoubleSwappedToHost(swapped);
+}
+
+@interface SBTMonitoredNetworkRequestBinaryCoder ()
+
+@property (nonatomic, assign) BOOL compressBodies;
+@property (nonatomic, strong) NSMutableArray<NSString *> *strings;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *stringIndexes;
+
+@end
+
+@implementation SBTMonitoredNetworkRequestBinaryCoder
+
++ (BOOL)isBinaryEncodedData:(NSData *)data
+{
+    return data.length > sizeof(SBTBinaryCoderMagic) && memcmp(data.bytes, SBTBinaryCoderMagic, sizeof(SBTBinaryCoderMagic)) == 0;
+}
+
+#pragma mark - Encoding
+
++ (NSData *)dataWithRequests:(NSArray<SBTMonitoredNetworkRequest *> *)requests compressBodies:(BOOL)compressBodies
+{
+    SBTMonitoredNetworkRequestBinaryCoder *coder = [[SBTMonitoredNetworkRequestBinaryCoder alloc] init];
+    coder.compressBodies = compressBodies;
+    coder.strings = [NSMutableArray array];
+    coder.stringIndexes = [NSMutableDictionary dictionary];
+
+    // entries are encoded first so that the table of interned strings is complete when writing the header
+    NSMutableData *entries = [NSMutableData data];
+    NSMutableData *entry = [NSMutableData data];
+    for (SBTMonitoredNetworkRequest *request in requests) {
+        entry.length = 0;
+        [coder encodeRequest:request into:entry];
+
+        SBTWriteVarint(entries, entry.length);
+        [entries appendData:entry];
+    }
+
+    NSMutableData *data = [NSMutableData dataWithCapacity:entries.length + 64];
+    [data appendBytes:SBTBinaryCoderMagic length:sizeof(SBTBinaryCoderMagic)];
+    [data appendBytes:&SBTBinaryCoderVersion length:1];
+
+    SBTWriteVarint(data, coder.strings.count);
+    for (NSString *string in coder.strings) {
+        const char *utf8 = string.UTF8String;
+        SBTWriteVarint(data, strlen(utf8));
+        [data appendBytes:utf8 length:strlen(utf8)];
+    }
+
+    SBTWriteVarint(data, requests.count);
+    [data appendData:entries];
+
+    return data;
+}
+
+- (uint64_t)indexOfString:(NSString *)string
+{
+    NSNumber *index = self.stringIndexes[string];
+    if (index == nil) {
+        index = @(self.strings.count);
+        self.stringIndexes[string] = index;
+        [self.strings addObject:string];
+    }
+
+    return index.unsignedLongLongValue;
+}
+
+- (void)encodeRequest:(SBTMonitoredNetworkRequest *)request into:(NSMutableData *)data
+{
+    SBTWriteVarintField(data, SBTBinaryCoderEntryTagSequenceNumber, request.sequenceNumber);
+    SBTWriteDoubleField(data, SBTBinaryCoderEntryTagTimestamp, request.timestamp);
+    SBTWriteDoubleField(data, SBTBinaryCoderEntryTagRequestTime, request.requestTime);
+
+    SBTBinaryCoderFlags flags = (request.isStubbed ? SBTBinaryCoderFlagsStubbed : 0) | (request.isRewritten ? SBTBinaryCoderFlagsRewritten : 0);
+    if (flags != 0) {
+        SBTWriteVarintField(data, SBTBinaryCoderEntryTagFlags, flags);
+    }
+
+    NSMutableData *message = [NSMutableData data];
+    if (request.request != nil) {
+        [self encodeURLRequest:request.request into:message];
+        SBTWriteField(data, SBTBinaryCoderEntryTagRequest, message.bytes, message.length);
+    }
+    if (request.originalRequest != nil) {
+        message.length = 0;
+        [self encodeURLRequest:request.originalRequest into:message];
+        SBTWriteField(data, SBTBinaryCoderEntryTagOriginalRequest, message.bytes, message.length);
+    }
+    if (request.response != nil) {
+        message.length = 0;
+        [self encodeResponse:request.response into:message];
+        SBTWriteField(data, SBTBinaryCoderEntryTagResponse, message.bytes, message.length);
+    }
+
+    if (request.timing != nil) {
+        message.length = 0;
+        [self encodeTiming:request.timing into:message];
+        SBTWriteField(data, SBTBinaryCoderEntryTagTiming, message.bytes, message.length);
+    }
+
+    SBTWriteDataField(data, SBTBinaryCoderEntryTagRequestData, request.requestData, self.compressBodies);
+    SBTWriteDataField(data, SBTBinaryCoderEntryTagResponseData, request.responseData, self.compressBodies);
+
+    // original lengths are only written for truncated bodies, the decoder defaults them to the body length
+    if (request.isRequestDataTruncated) {
+        SBTWriteVarintField(data, SBTBinaryCoderEntryTagRequestDataOriginalLength, request.requestDataOriginalLength);
+    }
+    if (request.isResponseDataTruncated) {
+        SBTWriteVarintField(data, SBTBinaryCoderEntryTagResponseDataOriginalLength, request.responseDataOriginalLength);
+    }
+    if (request.bodySampling != SBTMonitorCaptureSamplingHead) {
+        SBTWriteVarintField(data, SBTBinaryCoderEntryTagBodySampling, (uint64_t)request.bodySampling);
+    }
+}
+
+- (void)encodeURLRequest:(NSURLRequest *)request into:(NSMutableData *)data
+{
+    SBTWriteStringField(data, SBTBinaryCoderMessageTagURL, request.URL.absoluteString);
+    if (request.HTTPMethod != nil) {
+        SBTWriteVarintField(data, SBTBinaryCoderMessageTagMethod, [self indexOfString:request.HTTPMethod]);
+    }
+    [self encodeHeaders:request.allHTTPHeaderFields into:data];
+
+    NSData *body = [SBTRequestPropertyStorage propertyForKey:SBTUITunneledNSURLProtocolHTTPBodyKey inRequest:request] ?: request.HTTPBody;
+    SBTWriteDataField(data, SBTBinaryCoderMessageTagBody, body, self.compressBodies);
+}
+
+- (void)encodeResponse:(NSHTTPURLResponse *)response into:(NSMutableData *)data
+{
+    SBTWriteStringField(data, SBTBinaryCoderMessageTagURL, response.URL.absoluteString);
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        SBTWriteVarintField(data, SBTBinaryCoderMessageTagStatusCode, (uint64_t)response.statusCode);
+        [self encodeHeaders:response.allHeaderFields into:data];
+    }
+}
+
+- (void)encodeTiming:(SBTMonitoredNetworkRequestTiming *)timing into:(NSMutableData *)data
+{
+    SBTWriteDoubleField(data, SBTBinaryCoderTimingTagDomainLookup, timing.domainLookupDuration);
+    SBTWriteDoubleField(data, SBTBinaryCoderTimingTagConnect, timing.connectDuration);
+    SBTWriteDoubleField(data, SBTBinaryCoderTimingTagSecureConnection, timing.secureConnectionDuration);
+    SBTWriteDoubleField(data, SBTBinaryCoderTimingTagRequest, timing.requestDuration);
+    SBTWriteDoubleField(data, SBTBinaryCoderTimingTagTimeToFirstByte, timing.timeToFirstByte);
+    SBTWriteDoubleField(data, SBTBinaryCoderTimingTagResponse, timing.responseDuration);
+    SBTWriteDoubleField(data, SBTBinaryCoderTimingTagTotal, timing.totalDuration);
+    SBTWriteVarintField(data, SBTBinaryCoderTimingTagRequestHeaderBytes, (uint64_t)MAX(0, timing.requestHeaderBytes));
+    SBTWriteVarintField(data, SBTBinaryCoderTimingTagRequestBodyBytes, (uint64_t)MAX(0, timing.requestBodyBytes));
+    SBTWriteVarintField(data, SBTBinaryCoderTimingTagResponseHeaderBytes, (uint64_t)MAX(0, timing.responseHeaderBytes));
+    SBTWriteVarintField(data, SBTBinaryCoderTimingTagResponseBodyBytes, (uint64_t)MAX(0, timing.responseBodyBytes));
+    if (timing.networkProtocolName != nil) {
+        SBTWriteVarintField(data, SBTBinaryCoderTimingTagProtocol, [self indexOfString:timing.networkProtocolName]);
+    }
+    SBTWriteVarintField(data, SBTBinaryCoderTimingTagReusedConnection, timing.isReusedConnection);
+    SBTWriteVarintField(data, SBTBinaryCoderTimingTagRedirectCount, timing.redirectCount);
+}
+
+- (void)encodeHeaders:(NSDictionary *)headers into:(NSMutableData *)data
+{
+    NSMutableData *header = [NSMutableData data];
+    [headers enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSString *value, BOOL *stop) {
+        header.length = 0;
+        SBTWriteVarint(header, [self indexOfString:name]);
+        const char *utf8 = [value description].UTF8String;
+        [header appendBytes:utf8 length:strlen(utf8)];
+
+        SBTWriteField(data, SBTBinaryCoderMessageTagHeader, header.bytes, header.length);
+    }];
+}
+
+#pragma mark - Decoding
+
++ (NSArray<SBTMonitoredNetworkRequest *> *)requestsWithData:(NSData *)data error:(NSError **)error
+{
+    SBTReader reader = { data.bytes, data.length, 0 };
+
+    if (![self isBinaryEncodedData:data] || ((const uint8_t *)data.bytes)[sizeof(SBTBinaryCoderMagic)] != SBTBinaryCoderVersion) {
+        return [self failWithError:error message:@"Unsupported monitored requests encoding"];
+    }
+    reader.offset = sizeof(SBTBinaryCoderMagic) + 1;
+
+    SBTMonitoredNetworkRequestBinaryCoder *coder = [[SBTMonitoredNetworkRequestBinaryCoder alloc] init];
+    coder.strings = [NSMutableArray array];
+
+    uint64_t stringCount = 0;
+    if (!SBTReadVarint(&reader, &stringCount)) {
+        return [self failWithError:error message:@"Malformed string table"];
+    }
+    for (uint64_t i = 0; i < stringCount; i++) {
+        uint64_t length = 0;
+        if (!SBTReadVarint(&reader, &length) || length > reader.length - reader.offset) {
+            return [self failWithError:error message:@"Malformed string table"];
+        }
+
+        NSString *string = [[NSString alloc] initWithBytes:reader.bytes + reader.offset length:(NSUInteger)length encoding:NSUTF8StringEncoding];
+        [coder.strings addObject:string ?: @""];
+        reader.offset += (NSUInteger)length;
+    }
+
+    uint64_t entryCount = 0;
+    if (!SBTReadVarint(&reader, &entryCount)) {
+        return [self failWithError:error message:@"Malformed entries"];
+    }
+
+    NSMutableArray<SBTMonitoredNetworkRequest *> *requests = [NSMutableArray arrayWithCapacity:(NSUInteger)MIN(entryCount, 100000)];
+    for (uint64_t i = 0; i < entryCount; i++) {
+        uint64_t length = 0;
+        if (!SBTReadVarint(&reader, &length) || length > reader.length - reader.offset) {
+            return [self failWithError:error message:@"Malformed entries"];
+        }
+
+        SBTReader entry = { reader.bytes + reader.offset, (NSUInteger)length, 0 };
+        reader.offset += (NSUInteger)length;
+
+        [requests addObject:[coder decodeRequest:entry]];
+    }
+
+    return requests;
+}
+
++ (id)failWithError:(NSError **)error message:(NSString *)message
+{
+    if (error) {
+        *error = [NSError errorWithDomain:@"SBTMonitoredNetworkRequestBinaryCoder" code:-1 userInfo:@{ NSLocalizedDescriptionKey: message }];
+    }
+
+    return nil;
+}
+
+- (NSString *)stringAtIndex:(uint64_t)index
+{
+    return index < self.strings.count ? self.strings[(NSUInteger)index] : nil;
+}
+
+- (SBTMonitoredNetworkRequest *)decodeRequest:(SBTReader)reader
+{
+    SBTMonitoredNetworkRequest *request = [[SBTMonitoredNetworkRequest alloc] init];
+    NSUInteger requestDataOriginalLength = 0;
+    NSUInteger responseDataOriginalLength = 0;
+
+    uint8_t tag = 0;
+    SBTReader payload;
+    while (SBTReadField(&reader, &tag, &payload)) {
+        switch (tag & ~SBTBinaryCoderCompressedFlag) {
+            case SBTBinaryCoderEntryTagSequenceNumber:
+                request.sequenceNumber = (NSUInteger)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderEntryTagTimestamp:
+                request.timestamp = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderEntryTagRequestTime:
+                request.requestTime = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderEntryTagFlags: {
+                SBTBinaryCoderFlags flags = SBTPayloadVarint(payload);
+                request.isStubbed = (flags & SBTBinaryCoderFlagsStubbed) != 0;
+                request.isRewritten = (flags & SBTBinaryCoderFlagsRewritten) != 0;
+                break;
+            }
+            case SBTBinaryCoderEntryTagRequest:
+                request.request = [self decodeURLRequest:payload];
+                break;
+            case SBTBinaryCoderEntryTagOriginalRequest:
+                request.originalRequest = [self decodeURLRequest:payload];
+                break;
+            case SBTBinaryCoderEntryTagResponse:
+                request.response = [self decodeResponse:payload];
+                break;
+            case SBTBinaryCoderEntryTagTiming:
+                request.timing = [self decodeTiming:payload];
+                break;
+            case SBTBinaryCoderEntryTagRequestData:
+                request.requestData = SBTPayloadData(payload, tag);
+                break;
+            case SBTBinaryCoderEntryTagResponseData:
+                request.responseData = SBTPayloadData(payload, tag);
+                break;
+            case SBTBinaryCoderEntryTagRequestDataOriginalLength:
+                requestDataOriginalLength = (NSUInteger)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderEntryTagResponseDataOriginalLength:
+                responseDataOriginalLength = (NSUInteger)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderEntryTagBodySampling:
+                request.bodySampling = (SBTMonitorCaptureSampling)SBTPayloadVarint(payload);
+                break;
+            default:
+                break;
+        }
+    }
+
+    request.requestDataOriginalLength = MAX(requestDataOriginalLength, request.requestData.length);
+    request.responseDataOriginalLength = MAX(responseDataOriginalLength, request.responseData.length);
+
+    return request;
+}
+
+- (NSURLRequest *)decodeURLRequest:(SBTReader)reader
+{
+    NSMutableURLRequest *request = [[NSMutableURLRequest alloc] init];
+
+    uint8_t tag = 0;
+    SBTReader payload;
+    while (SBTReadField(&reader, &tag, &payload)) {
+        switch (tag & ~SBTBinaryCoderCompressedFlag) {
+            case SBTBinaryCoderMessageTagURL:
+                request.URL = [NSURL URLWithString:SBTPayloadString(payload)];
+                break;
+            case SBTBinaryCoderMessageTagMethod:
+                request.HTTPMethod = [self stringAtIndex:SBTPayloadVarint(payload)] ?: @"GET";
+                break;
+            case SBTBinaryCoderMessageTagHeader: {
+                NSString *name = nil;
+                NSString *value = [self decodeHeader:payload name:&name];
+                if (name != nil && value != nil) {
+                    [request setValue:value forHTTPHeaderField:name];
+                }
+                break;
+            }
+            case SBTBinaryCoderMessageTagBody:
+                request.HTTPBody = SBTPayloadData(payload, tag);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return request;
+}
+
+- (NSHTTPURLResponse *)decodeResponse:(SBTReader)reader
+{
+    NSURL *url = nil;
+    NSInteger statusCode = 0;
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary dictionary];
+
+    uint8_t tag = 0;
+    SBTReader payload;
+    while (SBTReadField(&reader, &tag, &payload)) {
+        switch (tag & ~SBTBinaryCoderCompressedFlag) {
+            case SBTBinaryCoderMessageTagURL:
+                url = [NSURL URLWithString:SBTPayloadString(payload)];
+                break;
+            case SBTBinaryCoderMessageTagStatusCode:
+                statusCode = (NSInteger)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderMessageTagHeader: {
+                NSString *name = nil;
+                NSString *value = [self decodeHeader:payload name:&name];
+                if (name != nil && value != nil) {
+                    headers[name] = value;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return [[NSHTTPURLResponse alloc] initWithURL:url ?: [NSURL URLWithString:@"about:blank"] statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:headers];
+}
+
+- (SBTMonitoredNetworkRequestTiming *)decodeTiming:(SBTReader)reader
+{
+    SBTMonitoredNetworkRequestTiming *timing = [[SBTMonitoredNetworkRequestTiming alloc] init];
+
+    uint8_t tag = 0;
+    SBTReader payload;
+    while (SBTReadField(&reader, &tag, &payload)) {
+        switch (tag) {
+            case SBTBinaryCoderTimingTagDomainLookup:
+                timing.domainLookupDuration = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderTimingTagConnect:
+                timing.connectDuration = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderTimingTagSecureConnection:
+                timing.secureConnectionDuration = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderTimingTagRequest:
+                timing.requestDuration = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderTimingTagTimeToFirstByte:
+                timing.timeToFirstByte = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderTimingTagResponse:
+                timing.responseDuration = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderTimingTagTotal:
+                timing.totalDuration = SBTPayloadDouble(payload);
+                break;
+            case SBTBinaryCoderTimingTagRequestHeaderBytes:
+                timing.requestHeaderBytes = (int64_t)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderTimingTagRequestBodyBytes:
+                timing.requestBodyBytes = (int64_t)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderTimingTagResponseHeaderBytes:
+                timing.responseHeaderBytes = (int64_t)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderTimingTagResponseBodyBytes:
+                timing.responseBodyBytes = (int64_t)SBTPayloadVarint(payload);
+                break;
+            case SBTBinaryCoderTimingTagProtocol:
+                timing.networkProtocolName = [self stringAtIndex:SBTPayloadVarint(payload)];
+                break;
+            case SBTBinaryCoderTimingTagReusedConnection:
+                timing.isReusedConnection = SBTPayloadVarint(payload) != 0;
+                break;
+            case SBTBinaryCoderTimingTagRedirectCount:
+                timing.redirectCount = (NSUInteger)SBTPayloadVarint(payload);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return timing;
+}
+
+- (NSString *)decodeHeader:(SBTReader)payload name:(NSString **)name
+{
+    uint64_t nameIndex = 0;
+    if (!SBTReadVarint(&payload, &nameIndex)) {
+        return nil;
+    }
+
+    *name = [self stringAtIndex:nameIndex];
+
+    return [[NSString alloc] initWithBytes:payload.bytes + payload.offset length:payload.length - payload.offset encoding:NSUTF8StringEncoding];
+}
+
+@end
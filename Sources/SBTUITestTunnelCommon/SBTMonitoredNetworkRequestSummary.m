@@ -0,0 +1,180 @@
+// SBTMonitoredNetworkRequestSummary.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTMonitoredNetworkRequestSummary.h"
+#import "include/SBTMonitoredNetworkRequest.h"
+#import "include/SBTRequestMatch.h"
+
+static NSString * const SBTSummarySequenceNumberKey = @"seq";
+static NSString * const SBTSummaryTimestampKey = @"ts";
+static NSString * const SBTSummaryRequestTimeKey = @"rt";
+static NSString * const SBTSummaryMethodKey = @"m";
+static NSString * const SBTSummaryURLKey = @"u";
+static NSString * const SBTSummaryStatusCodeKey = @"s";
+static NSString * const SBTSummaryRequestBodyLengthKey = @"qb";
+static NSString * const SBTSummaryResponseBodyLengthKey = @"rb";
+static NSString * const SBTSummaryStubbedKey = @"st";
+static NSString * const SBTSummaryRewrittenKey = @"rw";
+
+@implementation SBTMonitoredNetworkRequestSummary
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)initWithMonitoredRequest:(SBTMonitoredNetworkRequest *)request
+{
+    if (self = [super init]) {
+        self.sequenceNumber = request.sequenceNumber;
+        self.timestamp = request.timestamp;
+        self.requestTime = request.requestTime;
+        self.HTTPMethod = request.originalRequest.HTTPMethod;
+        self.URL = request.originalRequest.URL;
+        self.statusCode = request.response.statusCode;
+        self.requestBodyLength = request.requestDataOriginalLength;
+        self.responseBodyLength = request.responseDataOriginalLength;
+        self.isStubbed = request.isStubbed;
+        self.isRewritten = request.isRewritten;
+    }
+
+    return self;
+}
+
+- (instancetype)initWithJSONObject:(NSDictionary<NSString *, id> *)jsonObject
+{
+    if (![jsonObject isKindOfClass:[NSDictionary class]] || ![jsonObject[SBTSummarySequenceNumberKey] isKindOfClass:[NSNumber class]]) {
+        return nil;
+    }
+
+    if (self = [super init]) {
+        self.sequenceNumber = [jsonObject[SBTSummarySequenceNumberKey] unsignedIntegerValue];
+        self.timestamp = [jsonObject[SBTSummaryTimestampKey] doubleValue];
+        self.requestTime = [jsonObject[SBTSummaryRequestTimeKey] doubleValue];
+        self.HTTPMethod = jsonObject[SBTSummaryMethodKey];
+        self.URL = [jsonObject[SBTSummaryURLKey] isKindOfClass:[NSString class]] ? [NSURL URLWithString:jsonObject[SBTSummaryURLKey]] : nil;
+        self.statusCode = [jsonObject[SBTSummaryStatusCodeKey] integerValue];
+        self.requestBodyLength = [jsonObject[SBTSummaryRequestBodyLengthKey] unsignedIntegerValue];
+        self.responseBodyLength = [jsonObject[SBTSummaryResponseBodyLengthKey] unsignedIntegerValue];
+        self.isStubbed = [jsonObject[SBTSummaryStubbedKey] boolValue];
+        self.isRewritten = [jsonObject[SBTSummaryRewrittenKey] boolValue];
+    }
+
+    return self;
+}
+
+- (NSDictionary<NSString *, id> *)JSONObject
+{
+    NSMutableDictionary<NSString *, id> *ret = [NSMutableDictionary dictionary];
+
+    ret[SBTSummarySequenceNumberKey] = @(self.sequenceNumber);
+    ret[SBTSummaryTimestampKey] = @(self.timestamp);
+    ret[SBTSummaryRequestTimeKey] = @(self.requestTime);
+    ret[SBTSummaryMethodKey] = self.HTTPMethod;
+    ret[SBTSummaryURLKey] = self.URL.absoluteString;
+    ret[SBTSummaryStatusCodeKey] = @(self.statusCode);
+    // flags and empty bodies are omitted to keep the representation small
+    if (self.requestBodyLength > 0) {
+        ret[SBTSummaryRequestBodyLengthKey] = @(self.requestBodyLength);
+    }
+    if (self.responseBodyLength > 0) {
+        ret[SBTSummaryResponseBodyLengthKey] = @(self.responseBodyLength);
+    }
+    if (self.isStubbed) {
+        ret[SBTSummaryStubbedKey] = @YES;
+    }
+    if (self.isRewritten) {
+        ret[SBTSummaryRewrittenKey] = @YES;
+    }
+
+    return ret;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        self.sequenceNumber = (NSUInteger)[decoder decodeInt64ForKey:NSStringFromSelector(@selector(sequenceNumber))];
+        self.timestamp = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(timestamp))];
+        self.requestTime = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(requestTime))];
+        self.HTTPMethod = [decoder decodeObjectOfClass:[NSString class] forKey:NSStringFromSelector(@selector(HTTPMethod))];
+        self.URL = [decoder decodeObjectOfClass:[NSURL class] forKey:NSStringFromSelector(@selector(URL))];
+        self.statusCode = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(statusCode))];
+        self.requestBodyLength = (NSUInteger)[decoder decodeInt64ForKey:NSStringFromSelector(@selector(requestBodyLength))];
+        self.responseBodyLength = (NSUInteger)[decoder decodeInt64ForKey:NSStringFromSelector(@selector(responseBodyLength))];
+        self.isStubbed = [decoder decodeBoolForKey:NSStringFromSelector(@selector(isStubbed))];
+        self.isRewritten = [decoder decodeBoolForKey:NSStringFromSelector(@selector(isRewritten))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeInt64:(int64_t)self.sequenceNumber forKey:NSStringFromSelector(@selector(sequenceNumber))];
+    [encoder encodeDouble:self.timestamp forKey:NSStringFromSelector(@selector(timestamp))];
+    [encoder encodeDouble:self.requestTime forKey:NSStringFromSelector(@selector(requestTime))];
+    [encoder encodeObject:self.HTTPMethod forKey:NSStringFromSelector(@selector(HTTPMethod))];
+    [encoder encodeObject:self.URL forKey:NSStringFromSelector(@selector(URL))];
+    [encoder encodeInteger:self.statusCode forKey:NSStringFromSelector(@selector(statusCode))];
+    [encoder encodeInt64:(int64_t)self.requestBodyLength forKey:NSStringFromSelector(@selector(requestBodyLength))];
+    [encoder encodeInt64:(int64_t)self.responseBodyLength forKey:NSStringFromSelector(@selector(responseBodyLength))];
+    [encoder encodeBool:self.isStubbed forKey:NSStringFromSelector(@selector(isStubbed))];
+    [encoder encodeBool:self.isRewritten forKey:NSStringFromSelector(@selector(isRewritten))];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    SBTMonitoredNetworkRequestSummary *copy = [[SBTMonitoredNetworkRequestSummary allocWithZone:zone] init];
+
+    copy.sequenceNumber = self.sequenceNumber;
+    copy.timestamp = self.timestamp;
+    copy.requestTime = self.requestTime;
+    copy.HTTPMethod = self.HTTPMethod;
+    copy.URL = self.URL;
+    copy.statusCode = self.statusCode;
+    copy.requestBodyLength = self.requestBodyLength;
+    copy.responseBodyLength = self.responseBodyLength;
+    copy.isStubbed = self.isStubbed;
+    copy.isRewritten = self.isRewritten;
+
+    return copy;
+}
+
+- (BOOL)matches:(SBTRequestMatch *)match
+{
+    if (self.URL == nil) {
+        return NO;
+    }
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:self.URL];
+    request.HTTPMethod = self.HTTPMethod ?: @"GET";
+
+    return [match matchesURLRequest:request];
+}
+
+- (NSString *)description
+{
+    NSString *ret = [NSString stringWithFormat:@"SBTUITestTunnel[%.4f] #%lu %@ %@ %ld", self.timestamp, (unsigned long)self.sequenceNumber, self.HTTPMethod, self.URL.absoluteString, (long)self.statusCode];
+
+    if (self.isStubbed) {
+        return [ret stringByAppendingString:@" (Stubbed)"];
+    } else if (self.isRewritten) {
+        return [ret stringByAppendingString:@" (Rewritten)"];
+    } else {
+        return ret;
+    }
+}
+
+@end
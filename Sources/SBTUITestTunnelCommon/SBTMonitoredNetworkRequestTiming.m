@@ -0,0 +1,136 @@
+// SBTMonitoredNetworkRequestTiming.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTMonitoredNetworkRequestTiming.h"
+
+static NSTimeInterval SBTDuration(NSDate *start, NSDate *end)
+{
+    return (start != nil && end != nil) ? MAX(0.0, [end timeIntervalSinceDate:start]) : 0.0;
+}
+
+@implementation SBTMonitoredNetworkRequestTiming
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)initWithTaskMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+    if ((self = [super init])) {
+        _totalDuration = metrics.taskInterval.duration;
+        _redirectCount = metrics.redirectCount;
+
+        // phases are taken from the last network transaction, the one that produced the response
+        NSURLSessionTaskTransactionMetrics *lastTransaction = nil;
+        for (NSURLSessionTaskTransactionMetrics *transaction in metrics.transactionMetrics) {
+            if (transaction.resourceFetchType != NSURLSessionTaskMetricsResourceFetchTypeNetworkLoad) {
+                continue;
+            }
+            lastTransaction = transaction;
+
+            if (@available(iOS 13.0, tvOS 13.0, *)) {
+                _requestHeaderBytes += transaction.countOfRequestHeaderBytesSent;
+                _requestBodyBytes += transaction.countOfRequestBodyBytesSent;
+                _responseHeaderBytes += transaction.countOfResponseHeaderBytesReceived;
+                _responseBodyBytes += transaction.countOfResponseBodyBytesReceived;
+            }
+        }
+
+        if (lastTransaction != nil) {
+            _domainLookupDuration = SBTDuration(lastTransaction.domainLookupStartDate, lastTransaction.domainLookupEndDate);
+            _connectDuration = SBTDuration(lastTransaction.connectStartDate, lastTransaction.secureConnectionStartDate ?: lastTransaction.connectEndDate);
+            _secureConnectionDuration = SBTDuration(lastTransaction.secureConnectionStartDate, lastTransaction.secureConnectionEndDate);
+            _requestDuration = SBTDuration(lastTransaction.requestStartDate, lastTransaction.requestEndDate);
+            _timeToFirstByte = SBTDuration(lastTransaction.requestEndDate, lastTransaction.responseStartDate);
+            _responseDuration = SBTDuration(lastTransaction.responseStartDate, lastTransaction.responseEndDate);
+            _networkProtocolName = [lastTransaction.networkProtocolName copy];
+            _isReusedConnection = lastTransaction.isReusedConnection;
+        }
+    }
+
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        self.domainLookupDuration = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(domainLookupDuration))];
+        self.connectDuration = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(connectDuration))];
+        self.secureConnectionDuration = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(secureConnectionDuration))];
+        self.requestDuration = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(requestDuration))];
+        self.timeToFirstByte = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(timeToFirstByte))];
+        self.responseDuration = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(responseDuration))];
+        self.totalDuration = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(totalDuration))];
+        self.requestHeaderBytes = [decoder decodeInt64ForKey:NSStringFromSelector(@selector(requestHeaderBytes))];
+        self.requestBodyBytes = [decoder decodeInt64ForKey:NSStringFromSelector(@selector(requestBodyBytes))];
+        self.responseHeaderBytes = [decoder decodeInt64ForKey:NSStringFromSelector(@selector(responseHeaderBytes))];
+        self.responseBodyBytes = [decoder decodeInt64ForKey:NSStringFromSelector(@selector(responseBodyBytes))];
+        self.networkProtocolName = [decoder decodeObjectOfClass:[NSString class] forKey:NSStringFromSelector(@selector(networkProtocolName))];
+        self.isReusedConnection = [decoder decodeBoolForKey:NSStringFromSelector(@selector(isReusedConnection))];
+        self.redirectCount = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(redirectCount))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeDouble:self.domainLookupDuration forKey:NSStringFromSelector(@selector(domainLookupDuration))];
+    [encoder encodeDouble:self.connectDuration forKey:NSStringFromSelector(@selector(connectDuration))];
+    [encoder encodeDouble:self.secureConnectionDuration forKey:NSStringFromSelector(@selector(secureConnectionDuration))];
+    [encoder encodeDouble:self.requestDuration forKey:NSStringFromSelector(@selector(requestDuration))];
+    [encoder encodeDouble:self.timeToFirstByte forKey:NSStringFromSelector(@selector(timeToFirstByte))];
+    [encoder encodeDouble:self.responseDuration forKey:NSStringFromSelector(@selector(responseDuration))];
+    [encoder encodeDouble:self.totalDuration forKey:NSStringFromSelector(@selector(totalDuration))];
+    [encoder encodeInt64:self.requestHeaderBytes forKey:NSStringFromSelector(@selector(requestHeaderBytes))];
+    [encoder encodeInt64:self.requestBodyBytes forKey:NSStringFromSelector(@selector(requestBodyBytes))];
+    [encoder encodeInt64:self.responseHeaderBytes forKey:NSStringFromSelector(@selector(responseHeaderBytes))];
+    [encoder encodeInt64:self.responseBodyBytes forKey:NSStringFromSelector(@selector(responseBodyBytes))];
+    [encoder encodeObject:self.networkProtocolName forKey:NSStringFromSelector(@selector(networkProtocolName))];
+    [encoder encodeBool:self.isReusedConnection forKey:NSStringFromSelector(@selector(isReusedConnection))];
+    [encoder encodeInteger:self.redirectCount forKey:NSStringFromSelector(@selector(redirectCount))];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    SBTMonitoredNetworkRequestTiming *copy = [[SBTMonitoredNetworkRequestTiming allocWithZone:zone] init];
+
+    copy.domainLookupDuration = self.domainLookupDuration;
+    copy.connectDuration = self.connectDuration;
+    copy.secureConnectionDuration = self.secureConnectionDuration;
+    copy.requestDuration = self.requestDuration;
+    copy.timeToFirstByte = self.timeToFirstByte;
+    copy.responseDuration = self.responseDuration;
+    copy.totalDuration = self.totalDuration;
+    copy.requestHeaderBytes = self.requestHeaderBytes;
+    copy.requestBodyBytes = self.requestBodyBytes;
+    copy.responseHeaderBytes = self.responseHeaderBytes;
+    copy.responseBodyBytes = self.responseBodyBytes;
+    copy.networkProtocolName = self.networkProtocolName;
+    copy.isReusedConnection = self.isReusedConnection;
+    copy.redirectCount = self.redirectCount;
+
+    return copy;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"Total: %.3fs (dns: %.3fs, connect: %.3fs, tls: %.3fs, request: %.3fs, ttfb: %.3fs, response: %.3fs), %lld bytes in, %lld bytes out, %@",
+            self.totalDuration, self.domainLookupDuration, self.connectDuration, self.secureConnectionDuration, self.requestDuration, self.timeToFirstByte, self.responseDuration,
+            self.responseHeaderBytes + self.responseBodyBytes, self.requestHeaderBytes + self.requestBodyBytes, self.networkProtocolName ?: @"unknown protocol"];
+}
+
+@end
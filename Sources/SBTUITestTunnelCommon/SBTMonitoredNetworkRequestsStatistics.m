@@ -0,0 +1,65 @@
+// SBTMonitoredNetworkRequestsStatistics.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTMonitoredNetworkRequestsStatistics.h"
+
+@implementation SBTMonitoredNetworkRequestsStatistics
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        self.capacity = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(capacity))];
+        self.overflowPolicy = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(overflowPolicy))];
+        self.count = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(count))];
+        self.droppedCount = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(droppedCount))];
+        self.spilledCount = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(spilledCount))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeInteger:self.capacity forKey:NSStringFromSelector(@selector(capacity))];
+    [encoder encodeInteger:self.overflowPolicy forKey:NSStringFromSelector(@selector(overflowPolicy))];
+    [encoder encodeInteger:self.count forKey:NSStringFromSelector(@selector(count))];
+    [encoder encodeInteger:self.droppedCount forKey:NSStringFromSelector(@selector(droppedCount))];
+    [encoder encodeInteger:self.spilledCount forKey:NSStringFromSelector(@selector(spilledCount))];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    SBTMonitoredNetworkRequestsStatistics *copy = [[SBTMonitoredNetworkRequestsStatistics allocWithZone:zone] init];
+
+    copy.capacity = self.capacity;
+    copy.overflowPolicy = self.overflowPolicy;
+    copy.count = self.count;
+    copy.droppedCount = self.droppedCount;
+    copy.spilledCount = self.spilledCount;
+
+    return copy;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"Capacity: %lu, count: %lu, dropped: %lu, spilled: %lu", (unsigned long)self.capacity, (unsigned long)self.count, (unsigned long)self.droppedCount, (unsigned long)self.spilledCount];
+}
+
+@end
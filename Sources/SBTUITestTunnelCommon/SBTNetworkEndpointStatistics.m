@@ -0,0 +1,85 @@
+// SBTNetworkEndpointStatistics.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTNetworkEndpointStatistics.h"
+
+@implementation SBTNetworkEndpointStatistics
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        self.host = [decoder decodeObjectOfClass:[NSString class] forKey:NSStringFromSelector(@selector(host))] ?: @"";
+        self.pathTemplate = [decoder decodeObjectOfClass:[NSString class] forKey:NSStringFromSelector(@selector(pathTemplate))] ?: @"";
+        self.requestCount = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(requestCount))];
+        self.failureCount = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(failureCount))];
+        self.bytesSent = [decoder decodeInt64ForKey:NSStringFromSelector(@selector(bytesSent))];
+        self.bytesReceived = [decoder decodeInt64ForKey:NSStringFromSelector(@selector(bytesReceived))];
+        self.meanLatency = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(meanLatency))];
+        self.p50Latency = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(p50Latency))];
+        self.p90Latency = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(p90Latency))];
+        self.p99Latency = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(p99Latency))];
+        self.maximumLatency = [decoder decodeDoubleForKey:NSStringFromSelector(@selector(maximumLatency))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeObject:self.host forKey:NSStringFromSelector(@selector(host))];
+    [encoder encodeObject:self.pathTemplate forKey:NSStringFromSelector(@selector(pathTemplate))];
+    [encoder encodeInteger:self.requestCount forKey:NSStringFromSelector(@selector(requestCount))];
+    [encoder encodeInteger:self.failureCount forKey:NSStringFromSelector(@selector(failureCount))];
+    [encoder encodeInt64:self.bytesSent forKey:NSStringFromSelector(@selector(bytesSent))];
+    [encoder encodeInt64:self.bytesReceived forKey:NSStringFromSelector(@selector(bytesReceived))];
+    [encoder encodeDouble:self.meanLatency forKey:NSStringFromSelector(@selector(meanLatency))];
+    [encoder encodeDouble:self.p50Latency forKey:NSStringFromSelector(@selector(p50Latency))];
+    [encoder encodeDouble:self.p90Latency forKey:NSStringFromSelector(@selector(p90Latency))];
+    [encoder encodeDouble:self.p99Latency forKey:NSStringFromSelector(@selector(p99Latency))];
+    [encoder encodeDouble:self.maximumLatency forKey:NSStringFromSelector(@selector(maximumLatency))];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    SBTNetworkEndpointStatistics *copy = [[SBTNetworkEndpointStatistics allocWithZone:zone] init];
+
+    copy.host = self.host;
+    copy.pathTemplate = self.pathTemplate;
+    copy.requestCount = self.requestCount;
+    copy.failureCount = self.failureCount;
+    copy.bytesSent = self.bytesSent;
+    copy.bytesReceived = self.bytesReceived;
+    copy.meanLatency = self.meanLatency;
+    copy.p50Latency = self.p50Latency;
+    copy.p90Latency = self.p90Latency;
+    copy.p99Latency = self.p99Latency;
+    copy.maximumLatency = self.maximumLatency;
+
+    return copy;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@%@ x%lu (%lu failed), %lld bytes out, %lld bytes in, p50: %.3fs, p90: %.3fs, p99: %.3fs, max: %.3fs",
+            self.host, self.pathTemplate, (unsigned long)self.requestCount, (unsigned long)self.failureCount, self.bytesSent, self.bytesReceived,
+            self.p50Latency, self.p90Latency, self.p99Latency, self.maximumLatency];
+}
+
+@end
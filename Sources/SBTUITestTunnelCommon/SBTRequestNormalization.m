@@ -0,0 +1,154 @@
+// SBTRequestNormalization.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTRequestNormalization.h"
+#import "include/NSURLRequest+HTTPBodyFix.h"
+#import <CommonCrypto/CommonDigest.h>
+
+@implementation SBTRequestNormalization
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
++ (instancetype)defaultNormalization
+{
+    return [[self alloc] initWithIncludesQuery:YES ignoredQueryItems:nil includesBody:YES headers:nil];
+}
+
+- (instancetype)init
+{
+    return [self initWithIncludesQuery:YES ignoredQueryItems:nil includesBody:YES headers:nil];
+}
+
+- (instancetype)initWithIncludesQuery:(BOOL)includesQuery ignoredQueryItems:(NSArray<NSString *> *)ignoredQueryItems includesBody:(BOOL)includesBody headers:(NSArray<NSString *> *)headers
+{
+    if (self = [super init]) {
+        self.includesQuery = includesQuery;
+        self.ignoredQueryItems = ignoredQueryItems;
+        self.includesBody = includesBody;
+        self.headers = headers;
+    }
+
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    if (self = [super init]) {
+        NSSet *arrayClasses = [NSSet setWithObjects:[NSArray class], [NSString class], nil];
+
+        self.includesQuery = [decoder decodeBoolForKey:NSStringFromSelector(@selector(includesQuery))];
+        self.ignoredQueryItems = [decoder decodeObjectOfClasses:arrayClasses forKey:NSStringFromSelector(@selector(ignoredQueryItems))];
+        self.includesBody = [decoder decodeBoolForKey:NSStringFromSelector(@selector(includesBody))];
+        self.headers = [decoder decodeObjectOfClasses:arrayClasses forKey:NSStringFromSelector(@selector(headers))];
+    }
+
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeBool:self.includesQuery forKey:NSStringFromSelector(@selector(includesQuery))];
+    [encoder encodeObject:self.ignoredQueryItems forKey:NSStringFromSelector(@selector(ignoredQueryItems))];
+    [encoder encodeBool:self.includesBody forKey:NSStringFromSelector(@selector(includesBody))];
+    [encoder encodeObject:self.headers forKey:NSStringFromSelector(@selector(headers))];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return [[SBTRequestNormalization allocWithZone:zone] initWithIncludesQuery:self.includesQuery
+                                                             ignoredQueryItems:[self.ignoredQueryItems copy]
+                                                                  includesBody:self.includesBody
+                                                                       headers:[self.headers copy]];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"Includes query: %@\nIgnored query items: %@\nIncludes body: %@\nHeaders: %@", self.includesQuery ? @"YES" : @"NO", self.ignoredQueryItems ?: @"N/A", self.includesBody ? @"YES" : @"NO", self.headers ?: @"N/A"];
+}
+
+#pragma mark - Keys
+
+- (NSString *)keyForRequest:(NSURLRequest *)request body:(NSData *)body
+{
+    if (body == nil && self.includesBody) {
+        body = [request sbt_extractHTTPBody];
+    }
+
+    NSString *bodyDigest = body.length > 0 ? [SBTRequestNormalization digestOfData:body] : nil;
+
+    return [self keyForMethod:request.HTTPMethod url:request.URL headers:request.allHTTPHeaderFields bodyDigest:bodyDigest];
+}
+
+- (NSString *)keyForMethod:(NSString *)method url:(NSURL *)url headers:(NSDictionary<NSString *, NSString *> *)headers bodyDigest:(NSString *)bodyDigest
+{
+    NSURLComponents *components = [NSURLComponents componentsWithURL:url resolvingAgainstBaseURL:NO];
+
+    NSMutableString *key = [NSMutableString stringWithFormat:@"%@ %@://%@", (method ?: @"GET").uppercaseString, components.scheme.lowercaseString ?: @"", components.host.lowercaseString ?: @""];
+    if (components.port != nil) {
+        [key appendFormat:@":%@", components.port];
+    }
+    [key appendString:components.percentEncodedPath.length > 0 ? components.percentEncodedPath : @"/"];
+
+    if (self.includesQuery && components.queryItems.count > 0) {
+        NSMutableArray<NSString *> *queryItems = [NSMutableArray array];
+        for (NSURLQueryItem *queryItem in components.queryItems) {
+            if (![self.ignoredQueryItems containsObject:queryItem.name]) {
+                [queryItems addObject:[NSString stringWithFormat:@"%@=%@", queryItem.name, queryItem.value ?: @""]];
+            }
+        }
+
+        if (queryItems.count > 0) {
+            [queryItems sortUsingSelector:@selector(compare:)];
+            [key appendFormat:@"?%@", [queryItems componentsJoinedByString:@"&"]];
+        }
+    }
+
+    for (NSString *header in [self.headers sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)]) {
+        NSString *value = nil;
+        for (NSString *requestHeader in headers) {
+            if ([requestHeader caseInsensitiveCompare:header] == NSOrderedSame) {
+                value = headers[requestHeader];
+                break;
+            }
+        }
+
+        [key appendFormat:@"|%@=%@", header.lowercaseString, value ?: @""];
+    }
+
+    if (self.includesBody && bodyDigest.length > 0) {
+        [key appendFormat:@"|%@", bodyDigest];
+    }
+
+    return key;
+}
+
++ (NSString *)digestOfData:(NSData *)data
+{
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+
+    NSMutableString *ret = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [ret appendFormat:@"%02x", digest[i]];
+    }
+
+    return ret;
+}
+
+@end
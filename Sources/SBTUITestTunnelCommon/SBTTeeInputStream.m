@@ -0,0 +1,270 @@
+// SBTTeeInputStream.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTTeeInputStream.h"
+
+const NSUInteger SBTTeeInputStreamDefaultMemoryThreshold = 1024 * 1024;
+
+@interface SBTTeeInputStream()
+
+@property (nonatomic, strong) NSInputStream *stream;
+@property (nonatomic, assign) NSUInteger memoryThreshold;
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, strong) NSFileHandle *spillFileHandle;
+@property (nonatomic, strong) NSURL *spillFileURL;
+@property (nonatomic, assign) NSUInteger capturedLength;
+@property (nonatomic, assign) BOOL captureCompleted;
+@property (nonatomic, assign) NSStreamStatus tee_streamStatus;
+@property (nonatomic, strong) NSError *tee_streamError;
+@property (nonatomic, weak) id<NSStreamDelegate> tee_delegate;
+
+@end
+
+@implementation SBTTeeInputStream
+
+// streams are weakly referenced so that captures go away together with the request that owns the body.
+// Tee streams retain the stream they wrap so they are weakly referenced as well to avoid a retain cycle
+static NSMapTable<NSInputStream *, NSData *> *captures;
+static NSMapTable<NSInputStream *, SBTTeeInputStream *> *tees;
+
++ (void)initialize
+{
+    if (self == [SBTTeeInputStream class]) {
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            captures = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                             valueOptions:NSPointerFunctionsStrongMemory];
+            tees = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                         valueOptions:NSPointerFunctionsWeakMemory];
+        });
+    }
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream
+{
+    return [self initWithInputStream:stream memoryThreshold:SBTTeeInputStreamDefaultMemoryThreshold];
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream memoryThreshold:(NSUInteger)memoryThreshold
+{
+    if ((self = [super init])) {
+        _stream = stream;
+        _memoryThreshold = memoryThreshold;
+        _buffer = [NSMutableData data];
+        _tee_streamStatus = NSStreamStatusNotOpen;
+
+        @synchronized (captures) {
+            [tees setObject:self forKey:stream];
+        }
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [_spillFileHandle closeFile];
+    if (_spillFileURL != nil) {
+        [[NSFileManager defaultManager] removeItemAtURL:_spillFileURL error:nil];
+    }
+}
+
+#pragma mark - Capture
+
+- (NSData *)capturedData
+{
+    @synchronized (self) {
+        if (self.spillFileURL != nil) {
+            [self.spillFileHandle synchronizeFile];
+            return [NSData dataWithContentsOfURL:self.spillFileURL options:NSDataReadingMappedIfSafe error:nil];
+        }
+
+        return self.capturedLength > 0 ? [self.buffer copy] : nil;
+    }
+}
+
+- (void)captureBytes:(const uint8_t *)bytes length:(NSUInteger)length
+{
+    @synchronized (self) {
+        if (self.spillFileHandle == nil && self.buffer.length + length > self.memoryThreshold) {
+            [self spillToDisk];
+        }
+
+        if (self.spillFileHandle != nil) {
+            [self.spillFileHandle writeData:[NSData dataWithBytesNoCopy:(void *)bytes length:length freeWhenDone:NO]];
+        } else {
+            [self.buffer appendBytes:bytes length:length];
+        }
+
+        self.capturedLength += length;
+    }
+}
+
+- (void)spillToDisk
+{
+    NSString *filename = [NSString stringWithFormat:@"sbtuitesttunnel-body-%@", [[NSUUID UUID] UUIDString]];
+    NSURL *url = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:filename]];
+
+    if (![[NSFileManager defaultManager] createFileAtPath:url.path contents:self.buffer attributes:nil]) {
+        NSLog(@"[SBTUITestTunnel] Failed to create body capture file at %@, keeping body in memory", url.path);
+        return;
+    }
+
+    self.spillFileHandle = [NSFileHandle fileHandleForWritingAtPath:url.path];
+    [self.spillFileHandle seekToEndOfFile];
+    self.spillFileURL = url;
+    self.buffer = [NSMutableData data];
+}
+
++ (NSData *)capturedDataForStream:(NSInputStream *)stream
+{
+    NSData *data = nil;
+    SBTTeeInputStream *tee = nil;
+    @synchronized (captures) {
+        data = [captures objectForKey:stream];
+        tee = [tees objectForKey:stream];
+    }
+
+    if (data == nil && tee.captureCompleted) {
+        data = [tee capturedData];
+    }
+
+    return data;
+}
+
++ (void)setCapturedData:(NSData *)data forStream:(NSInputStream *)stream
+{
+    @synchronized (captures) {
+        [captures setObject:data forKey:stream];
+    }
+}
+
++ (BOOL)isCapturingStream:(NSInputStream *)stream
+{
+    @synchronized (captures) {
+        return [captures objectForKey:stream] != nil || [tees objectForKey:stream] != nil;
+    }
+}
+
+#pragma mark - NSStream
+
+- (void)open
+{
+    if (self.tee_streamStatus != NSStreamStatusNotOpen) {
+        return;
+    }
+
+    [self.stream open];
+    self.tee_streamStatus = NSStreamStatusOpen;
+}
+
+- (void)close
+{
+    [self.stream close];
+    self.tee_streamStatus = NSStreamStatusClosed;
+
+    @synchronized (self) {
+        [self.spillFileHandle synchronizeFile];
+    }
+}
+
+- (NSStreamStatus)streamStatus
+{
+    return self.tee_streamStatus;
+}
+
+- (NSError *)streamError
+{
+    return self.tee_streamError;
+}
+
+- (id<NSStreamDelegate>)delegate
+{
+    return self.tee_delegate ?: self;
+}
+
+- (void)setDelegate:(id<NSStreamDelegate>)delegate
+{
+    self.tee_delegate = delegate;
+}
+
+- (id)propertyForKey:(NSStreamPropertyKey)key
+{
+    return [self.stream propertyForKey:key];
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSStreamPropertyKey)key
+{
+    return [self.stream setProperty:property forKey:key];
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSRunLoopMode)mode {}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSRunLoopMode)mode {}
+
+#pragma mark - NSInputStream
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len
+{
+    if (self.tee_streamStatus == NSStreamStatusClosed || self.tee_streamStatus == NSStreamStatusAtEnd) {
+        return 0;
+    }
+
+    self.tee_streamStatus = NSStreamStatusReading;
+    NSInteger bytesRead = [self.stream read:buffer maxLength:len];
+
+    if (bytesRead > 0) {
+        [self captureBytes:buffer length:bytesRead];
+        self.tee_streamStatus = NSStreamStatusOpen;
+        // the reader may stop as soon as Content-Length bytes were received without issuing a final read.
+        // hasBytesAvailable can't be used here: producer driven streams (i.e. bound pairs) may just be waiting for more data
+        self.captureCompleted = (self.stream.streamStatus == NSStreamStatusAtEnd);
+    } else if (bytesRead == 0) {
+        self.captureCompleted = YES;
+        self.tee_streamStatus = NSStreamStatusAtEnd;
+    } else {
+        self.tee_streamError = self.stream.streamError;
+        self.tee_streamStatus = NSStreamStatusError;
+    }
+
+    return bytesRead;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len
+{
+    return NO;
+}
+
+- (BOOL)hasBytesAvailable
+{
+    return self.tee_streamStatus == NSStreamStatusOpen;
+}
+
+#pragma mark - Undocumented CFReadStream Bridged Methods
+
+// NSURLSession toll-free bridges body streams to CFReadStream, which requires NSInputStream subclasses
+// to implement these private methods. Reads are performed synchronously so scheduling is a no-op.
+
+- (void)_scheduleInCFRunLoop:(__unused CFRunLoopRef)aRunLoop forMode:(__unused CFStringRef)aMode {}
+
+- (void)_unscheduleFromCFRunLoop:(__unused CFRunLoopRef)aRunLoop forMode:(__unused CFStringRef)aMode {}
+
+- (BOOL)_setCFClientFlags:(__unused CFOptionFlags)inFlags callback:(__unused CFReadStreamClientCallBack)inCallback context:(__unused CFStreamClientContext *)inContext
+{
+    return NO;
+}
+
+@end
@@ -0,0 +1,167 @@
+// SBTTunnelFrame.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTTunnelFrame.h"
+
+const uint32_t SBTTunnelFrameMaximumLength = 512 * 1024 * 1024;
+
+// type byte, request identifier and command length
+static const NSUInteger SBTTunnelFrameHeaderLength = 1 + 4 + 2;
+
+static uint32_t SBTReadUInt32(const uint8_t *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt32BigToHost(value);
+}
+
+static uint16_t SBTReadUInt16(const uint8_t *bytes)
+{
+    uint16_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt16BigToHost(value);
+}
+
+@implementation SBTTunnelFrame
+
+- (instancetype)initWithType:(SBTTunnelFrameType)type requestId:(uint32_t)requestId command:(NSString *)command payload:(NSData *)payload
+{
+    if ((self = [super init])) {
+        _type = type;
+        _requestId = requestId;
+        _command = [command copy];
+        _payload = payload;
+    }
+
+    return self;
+}
+
++ (instancetype)commandFrameWithRequestId:(uint32_t)requestId command:(NSString *)command parameters:(NSDictionary *)parameters
+{
+    return [[self alloc] initWithType:SBTTunnelFrameTypeCommand requestId:requestId command:command payload:[self payloadWithDictionary:parameters]];
+}
+
++ (instancetype)responseFrameForFrame:(SBTTunnelFrame *)frame response:(NSDictionary *)response
+{
+    return [[self alloc] initWithType:SBTTunnelFrameTypeResponse requestId:frame.requestId command:frame.command payload:[self payloadWithDictionary:response]];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"Frame %u type %u command '%@' (%lu bytes)", self.requestId, self.type, self.command, (unsigned long)self.payload.length];
+}
+
+#pragma mark - Payload
+
++ (NSData *)payloadWithDictionary:(NSDictionary *)dictionary
+{
+    if (dictionary.count == 0) {
+        return [NSData data];
+    }
+
+    NSData *ret = [NSPropertyListSerialization dataWithPropertyList:dictionary format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+    if (ret == nil && [NSJSONSerialization isValidJSONObject:dictionary]) {
+        // e.g. responses containing NSNull
+        ret = [NSJSONSerialization dataWithJSONObject:dictionary options:0 error:nil];
+    }
+
+    return ret ?: [NSData data];
+}
+
+- (NSDictionary *)payloadDictionary
+{
+    if (self.payload.length == 0) {
+        return nil;
+    }
+
+    id ret = [NSPropertyListSerialization propertyListWithData:self.payload options:NSPropertyListImmutable format:nil error:nil];
+    if (ret == nil) {
+        ret = [NSJSONSerialization JSONObjectWithData:self.payload options:0 error:nil];
+    }
+
+    return [ret isKindOfClass:[NSDictionary class]] ? ret : nil;
+}
+
+#pragma mark - Serialization
+
+- (NSData *)data
+{
+    NSData *command = [self.command dataUsingEncoding:NSUTF8StringEncoding];
+    uint16_t commandLength = (uint16_t)MIN(command.length, UINT16_MAX);
+
+    uint32_t length = (uint32_t)(SBTTunnelFrameHeaderLength + commandLength + self.payload.length);
+    NSMutableData *ret = [NSMutableData dataWithCapacity:sizeof(length) + length];
+
+    uint32_t lengthBE = CFSwapInt32HostToBig(length);
+    uint8_t type = self.type;
+    uint32_t requestIdBE = CFSwapInt32HostToBig(self.requestId);
+    uint16_t commandLengthBE = CFSwapInt16HostToBig(commandLength);
+
+    [ret appendBytes:&lengthBE length:sizeof(lengthBE)];
+    [ret appendBytes:&type length:sizeof(type)];
+    [ret appendBytes:&requestIdBE length:sizeof(requestIdBE)];
+    [ret appendBytes:&commandLengthBE length:sizeof(commandLengthBE)];
+    [ret appendBytes:command.bytes length:commandLength];
+    [ret appendData:self.payload];
+
+    return ret;
+}
+
++ (NSArray<SBTTunnelFrame *> *)framesByConsumingBuffer:(NSMutableData *)buffer error:(NSError **)error
+{
+    NSMutableArray<SBTTunnelFrame *> *ret = [NSMutableArray array];
+
+    const uint8_t *bytes = buffer.bytes;
+    NSUInteger offset = 0;
+    while (buffer.length - offset >= sizeof(uint32_t)) {
+        uint32_t length = SBTReadUInt32(bytes + offset);
+        if (length < SBTTunnelFrameHeaderLength || length > SBTTunnelFrameMaximumLength) {
+            if (error) {
+                *error = [NSError errorWithDomain:@"SBTTunnelFrame" code:-1 userInfo:@{ NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Invalid frame length %u", length] }];
+            }
+            return nil;
+        }
+
+        if (buffer.length - offset - sizeof(uint32_t) < length) {
+            break; // partial frame
+        }
+
+        const uint8_t *frame = bytes + offset + sizeof(uint32_t);
+        SBTTunnelFrameType type = frame[0];
+        uint32_t requestId = SBTReadUInt32(frame + 1);
+        uint16_t commandLength = SBTReadUInt16(frame + 5);
+        if (SBTTunnelFrameHeaderLength + commandLength > length) {
+            if (error) {
+                *error = [NSError errorWithDomain:@"SBTTunnelFrame" code:-1 userInfo:@{ NSLocalizedDescriptionKey: @"Invalid frame command length" }];
+            }
+            return nil;
+        }
+
+        NSString *command = [[NSString alloc] initWithBytes:frame + SBTTunnelFrameHeaderLength length:commandLength encoding:NSUTF8StringEncoding] ?: @"";
+        NSUInteger payloadOffset = SBTTunnelFrameHeaderLength + commandLength;
+        NSData *payload = [NSData dataWithBytes:frame + payloadOffset length:length - payloadOffset];
+
+        [ret addObject:[[SBTTunnelFrame alloc] initWithType:type requestId:requestId command:command payload:payload]];
+
+        offset += sizeof(uint32_t) + length;
+    }
+
+    [buffer replaceBytesInRange:NSMakeRange(0, offset) withBytes:NULL length:0];
+
+    return ret;
+}
+
+@end
@@ -0,0 +1,179 @@
+// SBTTunnelFrameConnection.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "include/SBTTunnelFrameConnection.h"
+#import "include/SBTTunnelFrame.h"
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+@interface SBTTunnelFrameConnection()
+
+@property (nonatomic, assign) int fileDescriptor;
+@property (nonatomic, strong) dispatch_queue_t readQueue;
+@property (nonatomic, strong) dispatch_queue_t writeQueue;
+@property (nonatomic, strong) dispatch_source_t readSource;
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, copy) void (^frameHandler)(SBTTunnelFrame *);
+@property (nonatomic, assign, readwrite, getter=isOpen) BOOL open;
+
+@end
+
+@implementation SBTTunnelFrameConnection
+
+- (instancetype)initWithFileDescriptor:(int)fileDescriptor frameHandler:(void (^)(SBTTunnelFrame *))frameHandler
+{
+    if ((self = [super init])) {
+        _fileDescriptor = fileDescriptor;
+        _frameHandler = frameHandler;
+        _buffer = [NSMutableData data];
+        _readQueue = dispatch_queue_create("com.sbtuitesttunnel.frame.read", DISPATCH_QUEUE_SERIAL);
+        _writeQueue = dispatch_queue_create("com.sbtuitesttunnel.frame.write", DISPATCH_QUEUE_SERIAL);
+        _open = YES;
+
+        int on = 1;
+        setsockopt(fileDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+        // commands are small request/response exchanges, don't wait to coalesce them (fails harmlessly on unix sockets)
+        setsockopt(fileDescriptor, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [self cancel];
+}
+
+- (void)resume
+{
+    __weak typeof(self) weakSelf = self;
+    int fileDescriptor = self.fileDescriptor;
+    dispatch_queue_t writeQueue = self.writeQueue;
+
+    self.readSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)fileDescriptor, 0, self.readQueue);
+    dispatch_source_set_event_handler(self.readSource, ^{
+        [weakSelf readAvailableBytes];
+    });
+    dispatch_source_set_cancel_handler(self.readSource, ^{
+        // no more reads, the socket is closed once the writes in progress drained
+        dispatch_async(writeQueue, ^{
+            close(fileDescriptor);
+        });
+    });
+    dispatch_resume(self.readSource);
+}
+
+- (void)readAvailableBytes
+{
+    size_t available = MAX(dispatch_source_get_data(self.readSource), 1);
+    uint8_t chunk[64 * 1024];
+
+    ssize_t bytesRead = read(self.fileDescriptor, chunk, MIN(available, sizeof(chunk)));
+    if (bytesRead <= 0) {
+        // end of stream or error
+        [self cancel];
+        return;
+    }
+
+    [self.buffer appendBytes:chunk length:(NSUInteger)bytesRead];
+
+    NSError *error = nil;
+    NSArray<SBTTunnelFrame *> *frames = [SBTTunnelFrame framesByConsumingBuffer:self.buffer error:&error];
+    if (frames == nil) {
+        NSLog(@"[SBTUITestTunnel] Closing frame connection, %@", error.localizedDescription);
+        [self cancel];
+        return;
+    }
+
+    for (SBTTunnelFrame *frame in frames) {
+        self.frameHandler(frame);
+    }
+}
+
+- (void)sendFrame:(SBTTunnelFrame *)frame
+{
+    [self sendFrame:frame willWrite:nil];
+}
+
+- (void)sendFrame:(SBTTunnelFrame *)frame willWrite:(void (^)(void))willWrite
+{
+    NSData *data = [frame data];
+    int fileDescriptor = self.fileDescriptor;
+
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(self.writeQueue, ^{
+        // the socket is only closed on the write queue, it can't be closed (and its descriptor reused) while writing
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (strongSelf == nil) {
+            return;
+        }
+
+        // under the same lock as cancel: either willWrite runs before the connection is closed or the frame is never written
+        @synchronized (strongSelf) {
+            if (!strongSelf.open) {
+                return;
+            }
+
+            if (willWrite != nil) {
+                willWrite();
+            }
+        }
+
+        const uint8_t *bytes = data.bytes;
+        NSUInteger offset = 0;
+        while (offset < data.length) {
+            ssize_t written = write(fileDescriptor, bytes + offset, data.length - offset);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            } else if (written <= 0) {
+                [strongSelf cancel];
+                return;
+            }
+            offset += (NSUInteger)written;
+        }
+    });
+}
+
+- (void)cancel
+{
+    void (^closeHandler)(void) = nil;
+    @synchronized (self) {
+        if (!self.open) {
+            return;
+        }
+        self.open = NO;
+
+        closeHandler = self.closeHandler;
+        self.closeHandler = nil;
+    }
+
+    if (self.readSource != nil) {
+        // the socket is closed by the cancel handler, once the source stopped monitoring it
+        dispatch_source_cancel(self.readSource);
+    } else {
+        int fileDescriptor = self.fileDescriptor;
+        dispatch_async(self.writeQueue, ^{
+            close(fileDescriptor);
+        });
+    }
+
+    if (closeHandler != nil) {
+        closeHandler();
+    }
+}
+
+@end
@@ -18,6 +18,9 @@
 
 NSString * const SBTUITunneledApplicationLaunchEnvironmentIPCKey = @"SBTUITunneledApplicationLaunchEnvironmentIPCKey";
 NSString * const SBTUITunneledApplicationLaunchEnvironmentPortKey = @"SBTUITunneledApplicationLaunchEnvironmentPortKey";
+NSString * const SBTUITunneledApplicationLaunchEnvironmentFramePortKey = @"SBTUITunneledApplicationLaunchEnvironmentFramePortKey";
+NSString * const SBTUITunneledApplicationLaunchEnvironmentFrameSocketPathKey = @"SBTUITunneledApplicationLaunchEnvironmentFrameSocketPathKey";
+NSString * const SBTUITunneledApplicationLaunchEnvironmentReadyPortKey = @"SBTUITunneledApplicationLaunchEnvironmentReadyPortKey";
 NSString * const SBTUITunneledApplicationDefaultHost = @"localhost";
 
 const double SBTUITunnelStubsDownloadSpeedGPRS   =-    56 / 8; // kbps -> KB/s
@@ -31,6 +34,9 @@ NSString * const SBTUITunneledApplicationLaunchOptionResetFilesystem = @"SBTUITu
 NSString * const SBTUITunneledApplicationLaunchOptionDisableKeepAlive = @"SBTUITunneledApplicationLaunchOptionDisableKeepAlive";
 NSString * const SBTUITunneledApplicationLaunchOptionDisableUITextFieldAutocomplete = @"SBTUITunneledApplicationLaunchOptionDisableUITextFieldAutocomplete";
 NSString * const SBTUITunneledApplicationLaunchOptionHasStartupCommands = @"SBTUITunneledApplicationLaunchOptionHasStartupCommands";
+NSString * const SBTUITunneledApplicationLaunchOptionEnableHTTPCache = @"SBTUITunneledApplicationLaunchOptionEnableHTTPCache";
+NSString * const SBTUITunneledApplicationLaunchOptionDisableFrameTunnel = @"SBTUITunneledApplicationLaunchOptionDisableFrameTunnel";
+NSString * const SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel = @"SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel";
 
 NSString * const SBTUITunnelIPCCommand = @"ipc_command";
 
@@ -38,6 +44,8 @@ NSString * const SBTUITunnelHTTPMethod = @"POST";
 
 NSString * const SBTUITunnelStubMatchRuleKey = @"match_rule";
 NSString * const SBTUITunnelStubResponseKey = @"response";
+NSString * const SBTUITunnelStubHARKey = @"har";
+NSString * const SBTUITunnelStubHARNormalizationKey = @"normalization";
 
 NSString * const SBTUITunnelRewriteMatchRuleKey = @"match_rule";
 NSString * const SBTUITunnelRewriteKey = @"rewrite_rule";
@@ -45,6 +53,25 @@ NSString * const SBTUITunnelRewriteKey = @"rewrite_rule";
 NSString * const SBTUITunnelProxyQueryRuleKey = @"rule";
 NSString * const SBTUITunnelProxyQueryResponseTimeKey = @"time_response";
 
+NSString * const SBTUITunnelMonitorCapacityKey = @"capacity";
+NSString * const SBTUITunnelMonitorOverflowPolicyKey = @"overflow_policy";
+NSString * const SBTUITunnelMonitorCursorKey = @"cursor";
+NSString * const SBTUITunnelMonitorIterationsKey = @"iterations";
+NSString * const SBTUITunnelMonitorTimeoutKey = @"timeout";
+NSString * const SBTUITunnelMonitorLossyKey = @"lossy";
+NSString * const SBTUITunnelMonitorWindowKey = @"window";
+NSString * const SBTUITunnelMonitorProjectionKey = @"projection";
+NSString * const SBTUITunnelMonitorProjectionSummary = @"summary";
+NSString * const SBTUITunnelMonitorSequenceNumberKey = @"sequence_number";
+NSString * const SBTUITunnelMonitorBodyKey = @"body";
+NSString * const SBTUITunnelMonitorBodyRequest = @"request";
+NSString * const SBTUITunnelMonitorBodyResponse = @"response";
+NSString * const SBTUITunnelMonitorEncodingKey = @"encoding";
+NSString * const SBTUITunnelMonitorEncodingBinary = @"binary";
+NSString * const SBTUITunnelMonitorTraceFileSizeKey = @"trace_file_size";
+NSString * const SBTUITunnelMonitorTraceFileCountKey = @"trace_file_count";
+NSString * const SBTUITunnelMonitorCapturePolicyKey = @"capture_policy";
+
 NSString * const SBTUITunnelCookieBlockMatchRuleKey = @"rule";
 NSString * const SBTUITunnelCookieBlockQueryIterationsKey = @"iterations";
 
@@ -63,13 +90,23 @@ NSString * const SBTUITunnelUploadBasePathKey = @"base";
 NSString * const SBTUITunnelDownloadPathKey = @"path";
 NSString * const SBTUITunnelDownloadBasePathKey = @"base";
 
+NSString * const SBTUITunnelCassetteNameKey = @"cassette_name";
+NSString * const SBTUITunnelCassetteNormalizationKey = @"normalization";
+NSString * const SBTUITunnelCassetteDataKey = @"cassette";
+
 NSString * const SBTUITunnelResponseResultKey = @"result";
 NSString * const SBTUITunnelResponseDebugKey = @"debug";
 
+NSString * const SBTUITunnelBinaryParameterContentType = @"application/octet-stream";
+
 NSString * const SBTUITunnelXCUIExtensionScrollType = @"type";
 
 NSString * const SBTUITunnelCustomCommandKey = @"cust_command";
 
+NSString * const SBTUITunnelBatchCommandsKey = @"batch_commands";
+NSString * const SBTUITunnelBatchCommandPathKey = @"path";
+NSString * const SBTUITunnelBatchCommandParametersKey = @"params";
+
 NSString * const SBTUITunneledApplicationCommandPing = @"commandPing";
 NSString * const SBTUITunneledApplicationCommandQuit = @"commandQuit";
 
@@ -77,6 +114,7 @@ NSString * const SBTUITunneledApplicationCommandStubMatching = @"commandStubMatc
 NSString * const SBTUITunneledApplicationCommandStubRequestsRemove = @"commandStubRequestsRemove";
 NSString * const SBTUITunneledApplicationCommandStubRequestsRemoveAll = @"commandStubRequestsRemoveAll";
 NSString * const SBTUITunneledApplicationCommandStubRequestsAll = @"commandStubRequestsAll";
+NSString * const SBTUITunneledApplicationCommandStubHAR = @"commandStubHAR";
 
 NSString * const SBTUITunneledApplicationCommandRewriteMatching = @"commandRewriteMatching";
 NSString * const SBTUITunneledApplicationCommandRewriteRequestsRemove = @"commandRewriteRemove";
@@ -87,6 +125,18 @@ NSString * const SBTUITunneledApplicationCommandMonitorRemove = @"commandMonitor
 NSString * const SBTUITunneledApplicationCommandMonitorRemoveAll = @"commandMonitorsRemoveAll";
 NSString * const SBTUITunneledApplicationCommandMonitorPeek = @"commandMonitorPeek";
 NSString * const SBTUITunneledApplicationCommandMonitorFlush = @"commandMonitorFlush";
+NSString * const SBTUITunneledApplicationCommandMonitorFetchSince = @"commandMonitorFetchSince";
+NSString * const SBTUITunneledApplicationCommandMonitorWait = @"commandMonitorWait";
+NSString * const SBTUITunneledApplicationCommandMonitorSubscribe = @"commandMonitorSubscribe";
+NSString * const SBTUITunneledApplicationCommandMonitorUnsubscribe = @"commandMonitorUnsubscribe";
+NSString * const SBTUITunneledApplicationCommandMonitorBody = @"commandMonitorBody";
+NSString * const SBTUITunneledApplicationCommandMonitorConfigure = @"commandMonitorConfigure";
+NSString * const SBTUITunneledApplicationCommandMonitorStatistics = @"commandMonitorStatistics";
+NSString * const SBTUITunneledApplicationCommandMonitorTimingByEndpoint = @"commandMonitorTimingByEndpoint";
+NSString * const SBTUITunneledApplicationCommandMonitorTraceStart = @"commandMonitorTraceStart";
+NSString * const SBTUITunneledApplicationCommandMonitorTraceStop = @"commandMonitorTraceStop";
+NSString * const SBTUITunneledApplicationCommandMonitorTraceFiles = @"commandMonitorTraceFiles";
+NSString * const SBTUITunneledApplicationCommandMonitorTraceDownload = @"commandMonitorTraceDownload";
 
 NSString * const SBTUITunneledApplicationCommandThrottleMatching = @"commandThrottleMatching";
 NSString * const SBTUITunneledApplicationCommandThrottleRemove = @"commandThrottleRemove";
@@ -96,6 +146,20 @@ NSString * const SBTUITunneledApplicationCommandCookieBlockMatching = @"commandC
 NSString * const SBTUITunneledApplicationCommandCookieBlockRemove = @"commandCookiesBlockRemove";
 NSString * const SBTUITunneledApplicationCommandCookieBlockRemoveAll = @"commandCookiesBlockRemoveAll";
 
+NSString * const SBTUITunneledApplicationCommandCassetteRecord = @"commandCassetteRecord";
+NSString * const SBTUITunneledApplicationCommandCassetteReplay = @"commandCassetteReplay";
+NSString * const SBTUITunneledApplicationCommandCassetteStop = @"commandCassetteStop";
+NSString * const SBTUITunneledApplicationCommandCassetteLoad = @"commandCassetteLoad";
+NSString * const SBTUITunneledApplicationCommandCassetteExport = @"commandCassetteExport";
+
+NSString * const SBTUITunneledApplicationCommandHTTPCacheEnable = @"commandHTTPCacheEnable";
+NSString * const SBTUITunneledApplicationCommandHTTPCacheDisable = @"commandHTTPCacheDisable";
+NSString * const SBTUITunneledApplicationCommandHTTPCacheClear = @"commandHTTPCacheClear";
+NSString * const SBTUITunneledApplicationCommandHTTPCacheStatistics = @"commandHTTPCacheStatistics";
+
+NSString * const SBTUITunneledApplicationCommandNetworkStatistics = @"commandNetworkStatistics";
+NSString * const SBTUITunneledApplicationCommandNetworkStatisticsReset = @"commandNetworkStatisticsReset";
+
 NSString * const SBTUITunneledApplicationCommandNSUserDefaultsSetObject = @"commandNSUserDefaultsSetObject";
 NSString * const SBTUITunneledApplicationCommandNSUserDefaultsRemoveObject = @"commandNSUserDefaultsRemoveObject";
 NSString * const SBTUITunneledApplicationCommandNSUserDefaultsObject = @"commandNSUserDefaultsObject";
@@ -106,6 +170,8 @@ NSString * const SBTUITunneledApplicationCommandMainBundleInfoDictionary = @"com
 
 NSString * const SBTUITunneledApplicationCommandCustom = @"commandCustom";
 
+NSString * const SBTUITunneledApplicationCommandBatch = @"commandBatch";
+
 NSString * const SBTUITunneledApplicationCommandSetUserInterfaceAnimations = @"commandSetUIAnimations";
 NSString * const SBTUITunneledApplicationCommandSetUserInterfaceAnimationSpeed = @"commandSetUIAnimationSpeed";
 
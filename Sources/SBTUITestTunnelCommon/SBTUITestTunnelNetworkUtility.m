@@ -18,6 +18,7 @@
 #include <arpa/inet.h>
 #include <ifaddrs.h>
 #include <netdb.h>
+#include <poll.h>
 
 @implementation SBTUITestTunnelNetworkUtility
 
@@ -93,4 +94,70 @@
     return -8;
 }
 
++ (int)openLoopbackListenerWithPort:(NSInteger *)port
+{
+    struct sockaddr_in addr = {0};
+    socklen_t len = sizeof(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return -1;
+    }
+
+    if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        getsockname(listener, (struct sockaddr *)&addr, &len) != 0 ||
+        listen(listener, 1) != 0) {
+        close(listener);
+        return -2;
+    }
+
+    *port = ntohs(addr.sin_port);
+
+    return listener;
+}
+
++ (BOOL)acceptConnectionOnListener:(int)listener timeout:(NSTimeInterval)timeout
+{
+    struct pollfd pfd = { .fd = listener, .events = POLLIN, .revents = 0 };
+
+    int result = 0;
+    do {
+        result = poll(&pfd, 1, (int)(timeout * 1000));
+    } while (result < 0 && errno == EINTR);
+
+    if (result <= 0 || !(pfd.revents & POLLIN)) {
+        return NO;
+    }
+
+    int peer = accept(listener, NULL, NULL);
+    if (peer < 0) {
+        return NO;
+    }
+
+    close(peer);
+
+    return YES;
+}
+
++ (BOOL)signalLoopbackPort:(NSInteger)port
+{
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((in_port_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+        return NO;
+    }
+
+    BOOL connected = connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+    close(sock);
+
+    return connected;
+}
+
 @end
@@ -21,6 +21,9 @@
 @interface NSURLRequest (HTTPBodyFix)
 
 /// Reads data from an NSInputStream
+///
+/// The data read is remembered so that subsequent calls for the same stream don't need to read it again.
+/// Streams wrapped by a SBTTeeInputStream return the bytes captured while being sent instead.
 + (nullable NSData *)sbt_readFromBodyStream:(nullable NSInputStream *)stream;
 
 /// Extracts HTTP body data from a request using multiple fallback strategies:
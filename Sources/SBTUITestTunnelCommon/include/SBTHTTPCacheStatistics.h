@@ -0,0 +1,31 @@
+// SBTHTTPCacheStatistics.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// Counters of the on-device HTTP cache used for passthrough requests
+@interface SBTHTTPCacheStatistics : NSObject<NSSecureCoding, NSCopying>
+
+/// Requests served from the cache without reaching the network
+@property (nonatomic, assign) NSUInteger hits;
+
+/// Requests served from the cache after the server confirmed that the cached response is still valid (304 Not Modified)
+@property (nonatomic, assign) NSUInteger revalidations;
+
+/// Requests that were fetched from the network
+@property (nonatomic, assign) NSUInteger misses;
+
+@end
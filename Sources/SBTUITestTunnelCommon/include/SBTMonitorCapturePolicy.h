@@ -0,0 +1,69 @@
+// SBTMonitorCapturePolicy.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTMonitoredNetworkRequest;
+
+/// Which part of a body exceeding the capture limit is kept
+typedef NS_ENUM(NSInteger, SBTMonitorCaptureSampling) {
+    /// The first bytes of the body are kept
+    SBTMonitorCaptureSamplingHead = 0,
+    /// The first and the last bytes of the body are kept, half of the limit each
+    SBTMonitorCaptureSamplingHeadAndTail = 1,
+};
+
+/// Describes how the bodies of monitored requests are captured.
+///
+/// By default bodies are kept in full. Monitors on endpoints returning large payloads (e.g. images) can limit the number
+/// of bytes kept and compress them in memory. Entries record the original body lengths so that truncation can be detected.
+@interface SBTMonitorCapturePolicy : NSObject<NSSecureCoding, NSCopying>
+
+/// The maximum number of request body bytes kept, 0 to keep the whole body
+@property (nonatomic, assign) NSUInteger maximumRequestBodyLength;
+
+/// The maximum number of response body bytes kept, 0 to keep the whole body
+@property (nonatomic, assign) NSUInteger maximumResponseBodyLength;
+
+/// Which part of a body exceeding the limit is kept. Defaults to SBTMonitorCaptureSamplingHead
+@property (nonatomic, assign) SBTMonitorCaptureSampling sampling;
+
+/// Whether captured bodies are kept gzip compressed in memory, they are inflated transparently when accessed. Defaults to NO
+@property (nonatomic, assign) BOOL compressesBodies;
+
+/// The default policy: whole bodies, uncompressed
++ (nonnull instancetype)defaultPolicy;
+
+/**
+ *  Initializer
+ *
+ *  @param maximumRequestBodyLength the maximum number of request body bytes kept, 0 to keep the whole body
+ *  @param maximumResponseBodyLength the maximum number of response body bytes kept, 0 to keep the whole body
+ *  @param sampling which part of a body exceeding the limit is kept
+ *  @param compressesBodies whether captured bodies are kept gzip compressed in memory
+ */
+- (nonnull instancetype)initWithMaximumRequestBodyLength:(NSUInteger)maximumRequestBodyLength
+                               maximumResponseBodyLength:(NSUInteger)maximumResponseBodyLength
+                                                sampling:(SBTMonitorCaptureSampling)sampling
+                                        compressesBodies:(BOOL)compressesBodies;
+
+/// Truncates and compresses the bodies of a monitored request, recording their original length
+- (void)applyToRequest:(nonnull SBTMonitoredNetworkRequest *)request;
+
+/// Returns the bytes of data kept when capturing at most maximumLength bytes
++ (nullable NSData *)sampleData:(nullable NSData *)data maximumLength:(NSUInteger)maximumLength sampling:(SBTMonitorCaptureSampling)sampling;
+
+@end
@@ -0,0 +1,40 @@
+// SBTMonitoredNetworkEndpointTiming.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTMonitoredNetworkRequest;
+@class SBTMonitoredNetworkRequestTiming;
+
+/// Timing breakdown of the monitored requests sent to the same endpoint (HTTP method, host and path)
+@interface SBTMonitoredNetworkEndpointTiming : NSObject<NSSecureCoding>
+
+/// The endpoint in the `METHOD host/path` form
+@property (nonnull, nonatomic, copy) NSString *endpoint;
+
+/// The number of requests that contributed to the breakdown
+@property (nonatomic, assign) NSUInteger count;
+
+/// Mean duration of each phase and mean byte counts
+@property (nonnull, nonatomic, strong) SBTMonitoredNetworkRequestTiming *averageTiming;
+
+/// The slowest total duration
+@property (nonatomic, assign) NSTimeInterval maximumDuration;
+
+/// Groups requests by endpoint, sorted by descending cumulative time. Stubbed requests and requests without timing are skipped
++ (nonnull NSArray<SBTMonitoredNetworkEndpointTiming *> *)endpointTimingsWithRequests:(nonnull NSArray<SBTMonitoredNetworkRequest *> *)requests;
+
+@end
@@ -16,6 +16,9 @@
 
 @import Foundation;
 
+#import "SBTMonitorCapturePolicy.h"
+
+@class SBTMonitoredNetworkRequestTiming;
 @class SBTRequestMatch;
 
 @interface SBTMonitoredNetworkRequest : NSObject<NSSecureCoding>
@@ -28,9 +31,15 @@
 
 - (BOOL)matches:(nonnull SBTRequestMatch *)match;
 
+/// Monotonically increasing number assigned by the app when the request completes, starting from 1
+@property (nonatomic, assign) NSUInteger sequenceNumber;
+
 @property (nonatomic, assign) NSTimeInterval timestamp;
 @property (nonatomic, assign) NSTimeInterval requestTime;
 
+/// Per-phase breakdown of the network load collected from NSURLSessionTaskMetrics, nil for stubbed requests
+@property (nullable, nonatomic, strong) SBTMonitoredNetworkRequestTiming *timing;
+
 @property (nullable, nonatomic, strong) NSURLRequest *request;
 @property (nullable, nonatomic, strong) NSURLRequest *originalRequest;
 @property (nullable, nonatomic, strong) NSHTTPURLResponse *response;
@@ -38,7 +47,24 @@
 @property (nullable, nonatomic, strong) NSData *responseData;
 @property (nullable, nonatomic, strong) NSData *requestData;
 
+/// YES when the response came from a stub. Responses served by the HTTP cache, a replayed cassette or a HAR file are not considered stubbed
 @property (nonatomic, assign) BOOL isStubbed;
 @property (nonatomic, assign) BOOL isRewritten;
 
+/// The length of the request body before the monitor's capture policy was applied
+@property (nonatomic, assign) NSUInteger requestDataOriginalLength;
+/// The length of the response body before the monitor's capture policy was applied
+@property (nonatomic, assign) NSUInteger responseDataOriginalLength;
+
+/// YES if requestData holds only part of the request body, see SBTMonitorCapturePolicy
+@property (nonatomic, readonly) BOOL isRequestDataTruncated;
+/// YES if responseData holds only part of the response body, see SBTMonitorCapturePolicy
+@property (nonatomic, readonly) BOOL isResponseDataTruncated;
+
+/// Which part of truncated bodies was kept
+@property (nonatomic, assign) SBTMonitorCaptureSampling bodySampling;
+
+/// When YES bodies are kept gzip compressed and inflated every time they are accessed. Not encoded, decoded requests hold plain bodies
+@property (nonatomic, assign) BOOL compressesBodiesInMemory;
+
 @end
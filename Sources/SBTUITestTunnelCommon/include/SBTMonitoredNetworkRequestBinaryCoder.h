@@ -0,0 +1,44 @@
+// SBTMonitoredNetworkRequestBinaryCoder.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTMonitoredNetworkRequest;
+
+/// A compact binary encoding of monitored requests, faster to build and much smaller than keyed archives.
+///
+/// The encoding starts with the `SBTM` magic and a version byte, followed by a table of interned strings
+/// (HTTP methods and header names) and by the list of entries. Every entry is a length-prefixed list of
+/// fields, each made of a tag byte, a varint length and the payload, so that decoders skip unknown fields.
+/// Payloads of body fields are gzip compressed when requested and when compression pays off, which is
+/// signaled by the high bit of the tag.
+@interface SBTMonitoredNetworkRequestBinaryCoder : NSObject
+
+/**
+ *  Encodes monitored requests
+ *
+ *  @param requests the requests to encode
+ *  @param compressBodies `YES` to gzip request and response bodies larger than 512 bytes
+ */
++ (nonnull NSData *)dataWithRequests:(nonnull NSArray<SBTMonitoredNetworkRequest *> *)requests compressBodies:(BOOL)compressBodies;
+
+/// Decodes monitored requests, returns nil if the data is malformed or was encoded by an unsupported version
++ (nullable NSArray<SBTMonitoredNetworkRequest *> *)requestsWithData:(nonnull NSData *)data error:(NSError * _Nullable * _Nullable)error;
+
+/// Returns YES if the data starts with the binary encoding magic, NO for example for keyed archives
++ (BOOL)isBinaryEncodedData:(nonnull NSData *)data;
+
+@end
@@ -0,0 +1,54 @@
+// SBTMonitoredNetworkRequestSummary.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTMonitoredNetworkRequest;
+@class SBTRequestMatch;
+
+/// A lightweight projection of a monitored request without headers and bodies
+@interface SBTMonitoredNetworkRequestSummary : NSObject<NSSecureCoding, NSCopying>
+
+/// The sequence number of the monitored request
+@property (nonatomic, assign) NSUInteger sequenceNumber;
+
+@property (nonatomic, assign) NSTimeInterval timestamp;
+@property (nonatomic, assign) NSTimeInterval requestTime;
+
+@property (nullable, nonatomic, strong) NSString *HTTPMethod;
+@property (nullable, nonatomic, strong) NSURL *URL;
+
+/// The HTTP status code of the response, 0 if the request failed
+@property (nonatomic, assign) NSInteger statusCode;
+
+@property (nonatomic, assign) NSUInteger requestBodyLength;
+@property (nonatomic, assign) NSUInteger responseBodyLength;
+
+@property (nonatomic, assign) BOOL isStubbed;
+@property (nonatomic, assign) BOOL isRewritten;
+
+- (nonnull instancetype)initWithMonitoredRequest:(nonnull SBTMonitoredNetworkRequest *)request;
+
+/// Initializes the summary from its compact JSON representation, returns nil if the dictionary is malformed
+- (nullable instancetype)initWithJSONObject:(nonnull NSDictionary<NSString *, id> *)jsonObject;
+
+/// A compact JSON representation using short keys
+- (nonnull NSDictionary<NSString *, id> *)JSONObject;
+
+/// Matches the URL and method of the original request. Rules on request body or headers can't be evaluated and never match
+- (BOOL)matches:(nonnull SBTRequestMatch *)match;
+
+@end
@@ -0,0 +1,51 @@
+// SBTMonitoredNetworkRequestTiming.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// Breakdown of the time spent by a monitored request in each phase of its network load, as reported by
+/// NSURLSessionTaskMetrics. Phases that didn't happen, for example DNS lookup and connection establishment
+/// when an existing connection was reused, have a duration of 0.
+@interface SBTMonitoredNetworkRequestTiming : NSObject<NSSecureCoding, NSCopying>
+
+- (nonnull instancetype)initWithTaskMetrics:(nonnull NSURLSessionTaskMetrics *)metrics;
+
+/// Time spent resolving the host name
+@property (nonatomic, assign) NSTimeInterval domainLookupDuration;
+/// Time spent establishing the TCP (or QUIC) connection, excluding the TLS handshake
+@property (nonatomic, assign) NSTimeInterval connectDuration;
+/// Time spent in the TLS handshake
+@property (nonatomic, assign) NSTimeInterval secureConnectionDuration;
+/// Time spent sending the request headers and body
+@property (nonatomic, assign) NSTimeInterval requestDuration;
+/// Time between the end of the request and the first byte of the response, mostly spent by the backend
+@property (nonatomic, assign) NSTimeInterval timeToFirstByte;
+/// Time spent receiving the response
+@property (nonatomic, assign) NSTimeInterval responseDuration;
+/// Time between the creation of the task and its completion, including redirects
+@property (nonatomic, assign) NSTimeInterval totalDuration;
+
+@property (nonatomic, assign) int64_t requestHeaderBytes;
+@property (nonatomic, assign) int64_t requestBodyBytes;
+@property (nonatomic, assign) int64_t responseHeaderBytes;
+@property (nonatomic, assign) int64_t responseBodyBytes;
+
+/// The ALPN protocol identifier, e.g. `http/1.1`, `h2` or `h3`
+@property (nullable, nonatomic, copy) NSString *networkProtocolName;
+@property (nonatomic, assign) BOOL isReusedConnection;
+@property (nonatomic, assign) NSUInteger redirectCount;
+
+@end
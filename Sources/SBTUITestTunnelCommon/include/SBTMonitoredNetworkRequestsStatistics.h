@@ -0,0 +1,44 @@
+// SBTMonitoredNetworkRequestsStatistics.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// What happens to the oldest monitored request when the monitored requests buffer is full
+typedef NS_ENUM(NSInteger, SBTMonitoredNetworkRequestsOverflowPolicy) {
+    /// The oldest monitored request is discarded
+    SBTMonitoredNetworkRequestsOverflowPolicyDropOldest = 0,
+    /// The oldest monitored request is moved to an append-only file in the app container and returned when peeking or flushing
+    SBTMonitoredNetworkRequestsOverflowPolicySpillToDisk = 1,
+};
+
+/// Occupancy and overflow counters of the monitored requests buffer
+@interface SBTMonitoredNetworkRequestsStatistics : NSObject<NSSecureCoding, NSCopying>
+
+/// The maximum number of monitored requests kept in memory, 0 if unbounded
+@property (nonatomic, assign) NSUInteger capacity;
+
+@property (nonatomic, assign) SBTMonitoredNetworkRequestsOverflowPolicy overflowPolicy;
+
+/// The number of monitored requests kept in memory
+@property (nonatomic, assign) NSUInteger count;
+
+/// The number of monitored requests discarded because the buffer was full
+@property (nonatomic, assign) NSUInteger droppedCount;
+
+/// The number of monitored requests moved to disk because the buffer was full
+@property (nonatomic, assign) NSUInteger spilledCount;
+
+@end
@@ -0,0 +1,43 @@
+// SBTNetworkEndpointStatistics.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// Counters and latency distribution of the requests sent to the same host and path template.
+///
+/// Latency percentiles are estimated from a log-linear histogram and are accurate to about 6%.
+@interface SBTNetworkEndpointStatistics : NSObject<NSSecureCoding, NSCopying>
+
+@property (nonnull, nonatomic, copy) NSString *host;
+
+/// The request path with identifiers (numbers, UUIDs and long hex strings) replaced by `{id}`, e.g. `/users/{id}/posts`
+@property (nonnull, nonatomic, copy) NSString *pathTemplate;
+
+@property (nonatomic, assign) NSUInteger requestCount;
+
+/// The number of requests that failed or completed with a status code >= 400
+@property (nonatomic, assign) NSUInteger failureCount;
+
+@property (nonatomic, assign) int64_t bytesSent;
+@property (nonatomic, assign) int64_t bytesReceived;
+
+@property (nonatomic, assign) NSTimeInterval meanLatency;
+@property (nonatomic, assign) NSTimeInterval p50Latency;
+@property (nonatomic, assign) NSTimeInterval p90Latency;
+@property (nonatomic, assign) NSTimeInterval p99Latency;
+@property (nonatomic, assign) NSTimeInterval maximumLatency;
+
+@end
@@ -0,0 +1,80 @@
+// SBTRequestNormalization.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// Describes how requests are reduced to a lookup key so that equivalent requests can be found
+/// in constant time (e.g. when replaying a recorded cassette) instead of scanning regex rules.
+///
+/// The key is made of the HTTP method, the lowercased scheme and host, the port, the path and,
+/// depending on the configuration, the query items sorted by name, a set of header values and
+/// a SHA-256 digest of the body.
+@interface SBTRequestNormalization : NSObject<NSSecureCoding, NSCopying>
+
+/// Whether query items are part of the key. Defaults to YES
+@property (nonatomic, assign) BOOL includesQuery;
+
+/// Names of query items that are not part of the key (e.g. cache busters or timestamps)
+@property (nullable, nonatomic, strong) NSArray<NSString *> *ignoredQueryItems;
+
+/// Whether the request body is part of the key. Defaults to YES
+@property (nonatomic, assign) BOOL includesBody;
+
+/// Names of the request headers whose values are part of the key. Defaults to none
+@property (nullable, nonatomic, strong) NSArray<NSString *> *headers;
+
+/// The default normalization: method, url with sorted query items and body
++ (nonnull instancetype)defaultNormalization;
+
+/**
+ *  Initializer
+ *
+ *  @param includesQuery whether query items are part of the key
+ *  @param ignoredQueryItems names of query items that are not part of the key
+ *  @param includesBody whether the request body is part of the key
+ *  @param headers names of the request headers whose values are part of the key
+ */
+- (nonnull instancetype)initWithIncludesQuery:(BOOL)includesQuery
+                            ignoredQueryItems:(nullable NSArray<NSString *> *)ignoredQueryItems
+                                 includesBody:(BOOL)includesBody
+                                      headers:(nullable NSArray<NSString *> *)headers;
+
+/**
+ *  Returns the lookup key of a request
+ *
+ *  @param request the request to normalize
+ *  @param body the request body, pass nil to extract it from the request
+ */
+- (nonnull NSString *)keyForRequest:(nonnull NSURLRequest *)request body:(nullable NSData *)body;
+
+/**
+ *  Returns the lookup key of a request described by its components, used when the request
+ *  comes from a recording (e.g. a cassette or a HAR file) rather than from the URL loading system
+ *
+ *  @param method the HTTP method
+ *  @param url the request url
+ *  @param headers the request headers
+ *  @param bodyDigest the SHA-256 digest of the request body as returned by `digestOfData:`
+ */
+- (nonnull NSString *)keyForMethod:(nullable NSString *)method
+                               url:(nonnull NSURL *)url
+                           headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                        bodyDigest:(nullable NSString *)bodyDigest;
+
+/// Returns the lowercase hex SHA-256 digest of data, used to content address bodies
++ (nonnull NSString *)digestOfData:(nonnull NSData *)data;
+
+@end
@@ -0,0 +1,56 @@
+// SBTTeeInputStream.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// Default number of captured bytes kept in memory before spilling to a temporary file
+extern const NSUInteger SBTTeeInputStreamDefaultMemoryThreshold;
+
+/// An input stream that forwards reads to an underlying body stream while recording the bytes
+/// that go through it. This allows the proxy to send a request's HTTPBodyStream upstream without
+/// draining it beforehand and still expose the body to matchers and monitors once sent.
+///
+/// Captured bytes are kept in memory up to `memoryThreshold`, after which they are spilled to a
+/// file in NSTemporaryDirectory() that is removed when the stream is deallocated.
+@interface SBTTeeInputStream : NSInputStream
+
+- (nonnull instancetype)initWithInputStream:(nonnull NSInputStream *)stream;
+- (nonnull instancetype)initWithInputStream:(nonnull NSInputStream *)stream memoryThreshold:(NSUInteger)memoryThreshold;
+
+/// The number of bytes read so far
+@property (nonatomic, readonly) NSUInteger capturedLength;
+
+/// YES once the underlying stream reached its end
+@property (nonatomic, readonly) BOOL captureCompleted;
+
+/// The temporary file holding the captured bytes, nil if they still fit in memory
+@property (nullable, nonatomic, readonly) NSURL *spillFileURL;
+
+/// The bytes read so far. When spilled to disk the returned data is memory mapped
+- (nullable NSData *)capturedData;
+
+/// Returns the body previously captured for a stream, either by a tee stream wrapping it or by
+/// a full read through `+[NSURLRequest sbt_readFromBodyStream:]`. Streams wrapped by a tee that
+/// did not reach the end yet return nil.
++ (nullable NSData *)capturedDataForStream:(nonnull NSInputStream *)stream;
+
+/// Records the body read from a stream so that subsequent lookups don't need to read it again
++ (void)setCapturedData:(nonnull NSData *)data forStream:(nonnull NSInputStream *)stream;
+
+/// Returns YES if the stream was already fully read or wrapped by a tee stream
++ (BOOL)isCapturingStream:(nonnull NSInputStream *)stream;
+
+@end
@@ -0,0 +1,67 @@
+// SBTTunnelFrame.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// Maximum length of a frame, larger frames are considered malformed
+extern const uint32_t SBTTunnelFrameMaximumLength;
+
+typedef NS_ENUM(uint8_t, SBTTunnelFrameType) {
+    /// A command sent by the test runner, the payload contains the command parameters
+    SBTTunnelFrameTypeCommand = 1,
+    /// The reply to a command, the payload contains the response dictionary
+    SBTTunnelFrameTypeResponse = 2,
+};
+
+/// A message of the framed tunnel transport.
+///
+/// Frames are exchanged over a persistent stream socket, each one preceded by its big endian uint32 length.
+/// A frame is made of a type byte, a big endian uint32 request identifier used to match responses to commands,
+/// a big endian uint16 length followed by the UTF-8 command name and the payload. Payloads are binary property
+/// lists, or JSON for dictionaries that can't be represented as property lists. Binary command parameters, such as
+/// archived objects, are carried as data values rather than base64 strings.
+@interface SBTTunnelFrame : NSObject
+
+@property (nonatomic, readonly) SBTTunnelFrameType type;
+@property (nonatomic, readonly) uint32_t requestId;
+@property (nonnull, nonatomic, readonly) NSString *command;
+@property (nonnull, nonatomic, readonly) NSData *payload;
+
+- (nonnull instancetype)initWithType:(SBTTunnelFrameType)type requestId:(uint32_t)requestId command:(nonnull NSString *)command payload:(nonnull NSData *)payload;
+
+/// Returns a command frame carrying the command parameters
++ (nonnull instancetype)commandFrameWithRequestId:(uint32_t)requestId command:(nonnull NSString *)command parameters:(nullable NSDictionary *)parameters;
+
+/// Returns a response frame replying to a command frame
++ (nonnull instancetype)responseFrameForFrame:(nonnull SBTTunnelFrame *)frame response:(nullable NSDictionary *)response;
+
+/// The payload decoded as a dictionary, nil if the payload is empty or malformed
+- (nullable NSDictionary *)payloadDictionary;
+
+/// The frame serialized together with its length prefix, ready to be written to the socket
+- (nonnull NSData *)data;
+
+/**
+ *  Removes the complete frames at the beginning of a buffer of received bytes
+ *
+ *  @param buffer the bytes received so far, a trailing partial frame is left in the buffer
+ *  @param error set when the buffer contains a malformed frame
+ *
+ *  @return the frames, nil on error
+ */
++ (nullable NSArray<SBTTunnelFrame *> *)framesByConsumingBuffer:(nonnull NSMutableData *)buffer error:(NSError * _Nullable * _Nullable)error;
+
+@end
@@ -0,0 +1,58 @@
+// SBTTunnelFrameConnection.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTTunnelFrame;
+
+/// A connected stream socket exchanging tunnel frames, used on both ends of the framed tunnel transport.
+///
+/// Incoming bytes are read as they become available and delivered as complete frames, in order, on a private
+/// serial queue. Frames are written in the order they are sent.
+@interface SBTTunnelFrameConnection : NSObject
+
+/**
+ *  Initializer, the connection takes ownership of the socket and closes it when cancelled
+ *
+ *  @param fileDescriptor a connected stream socket
+ *  @param frameHandler invoked for every received frame
+ */
+- (nonnull instancetype)initWithFileDescriptor:(int)fileDescriptor frameHandler:(nonnull void (^)(SBTTunnelFrame * _Nonnull frame))frameHandler;
+
+/// Invoked once when the connection is closed by the peer, fails or is cancelled
+@property (nullable, nonatomic, copy) void (^closeHandler)(void);
+
+/// NO once the connection was closed
+@property (nonatomic, readonly, getter=isOpen) BOOL open;
+
+/// Starts receiving frames
+- (void)resume;
+
+/// Asynchronously writes a frame
+- (void)sendFrame:(nonnull SBTTunnelFrame *)frame;
+
+/**
+ *  Asynchronously writes a frame
+ *
+ *  @param frame the frame
+ *  @param willWrite invoked on the write queue right before the frame is written, not invoked if the connection was closed before
+ */
+- (void)sendFrame:(nonnull SBTTunnelFrame *)frame willWrite:(nullable void (^)(void))willWrite;
+
+/// Closes the connection
+- (void)cancel;
+
+@end
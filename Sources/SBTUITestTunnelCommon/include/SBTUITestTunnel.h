@@ -19,6 +19,9 @@
 
 extern NSString * _Nonnull const SBTUITunneledApplicationLaunchEnvironmentIPCKey;
 extern NSString * _Nonnull const SBTUITunneledApplicationLaunchEnvironmentPortKey;
+extern NSString * _Nonnull const SBTUITunneledApplicationLaunchEnvironmentFramePortKey;
+extern NSString * _Nonnull const SBTUITunneledApplicationLaunchEnvironmentFrameSocketPathKey;
+extern NSString * _Nonnull const SBTUITunneledApplicationLaunchEnvironmentReadyPortKey;
 extern NSString * _Nonnull const SBTUITunneledApplicationDefaultHost;
 
 extern const double
@@ -33,6 +36,9 @@ extern NSString * _Nonnull const SBTUITunneledApplicationLaunchOptionResetFilesy
 extern NSString * _Nonnull const SBTUITunneledApplicationLaunchOptionDisableKeepAlive;
 extern NSString * _Nonnull const SBTUITunneledApplicationLaunchOptionDisableUITextFieldAutocomplete;
 extern NSString * _Nonnull const SBTUITunneledApplicationLaunchOptionHasStartupCommands;
+extern NSString * _Nonnull const SBTUITunneledApplicationLaunchOptionEnableHTTPCache;
+extern NSString * _Nonnull const SBTUITunneledApplicationLaunchOptionDisableFrameTunnel;
+extern NSString * _Nonnull const SBTUITunneledApplicationLaunchOptionDisableUnixSocketTunnel;
 
 extern NSString * _Nonnull const SBTUITunnelIPCCommand;
 
@@ -40,6 +46,8 @@ extern NSString * _Nonnull const SBTUITunnelHTTPMethod;
 
 extern NSString * _Nonnull const SBTUITunnelStubMatchRuleKey;
 extern NSString * _Nonnull const SBTUITunnelStubResponseKey;
+extern NSString * _Nonnull const SBTUITunnelStubHARKey;
+extern NSString * _Nonnull const SBTUITunnelStubHARNormalizationKey;
 
 extern NSString * _Nonnull const SBTUITunnelRewriteMatchRuleKey;
 extern NSString * _Nonnull const SBTUITunnelRewriteKey;
@@ -47,6 +55,25 @@ extern NSString * _Nonnull const SBTUITunnelRewriteKey;
 extern NSString * _Nonnull const SBTUITunnelProxyQueryRuleKey;
 extern NSString * _Nonnull const SBTUITunnelProxyQueryResponseTimeKey;
 
+extern NSString * _Nonnull const SBTUITunnelMonitorCapacityKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorOverflowPolicyKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorCursorKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorIterationsKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorTimeoutKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorLossyKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorWindowKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorProjectionKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorProjectionSummary;
+extern NSString * _Nonnull const SBTUITunnelMonitorSequenceNumberKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorBodyKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorBodyRequest;
+extern NSString * _Nonnull const SBTUITunnelMonitorBodyResponse;
+extern NSString * _Nonnull const SBTUITunnelMonitorEncodingKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorEncodingBinary;
+extern NSString * _Nonnull const SBTUITunnelMonitorTraceFileSizeKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorTraceFileCountKey;
+extern NSString * _Nonnull const SBTUITunnelMonitorCapturePolicyKey;
+
 extern NSString * _Nonnull const SBTUITunnelCookieBlockMatchRuleKey;
 extern NSString * _Nonnull const SBTUITunnelCookieBlockQueryIterationsKey;
 
@@ -65,13 +92,23 @@ extern NSString * _Nonnull const SBTUITunnelUploadBasePathKey;
 extern NSString * _Nonnull const SBTUITunnelDownloadPathKey;
 extern NSString * _Nonnull const SBTUITunnelDownloadBasePathKey;
 
+extern NSString * _Nonnull const SBTUITunnelCassetteNameKey;
+extern NSString * _Nonnull const SBTUITunnelCassetteNormalizationKey;
+extern NSString * _Nonnull const SBTUITunnelCassetteDataKey;
+
 extern NSString * _Nonnull const SBTUITunnelResponseResultKey;
 extern NSString * _Nonnull const SBTUITunnelResponseDebugKey;
 
+extern NSString * _Nonnull const SBTUITunnelBinaryParameterContentType;
+
 extern NSString * _Nonnull const SBTUITunnelXCUIExtensionScrollType;
 
 extern NSString * _Nonnull const SBTUITunnelCustomCommandKey;
 
+extern NSString * _Nonnull const SBTUITunnelBatchCommandsKey;
+extern NSString * _Nonnull const SBTUITunnelBatchCommandPathKey;
+extern NSString * _Nonnull const SBTUITunnelBatchCommandParametersKey;
+
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandPing;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandQuit;
 
@@ -79,6 +116,7 @@ extern NSString * _Nonnull const SBTUITunneledApplicationCommandStubMatching;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandStubRequestsRemove;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandStubRequestsRemoveAll;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandStubRequestsAll;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandStubHAR;
 
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandRewriteMatching;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandRewriteRequestsRemove;
@@ -89,6 +127,18 @@ extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorRemove;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorRemoveAll;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorPeek;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorFlush;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorFetchSince;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorWait;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorSubscribe;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorUnsubscribe;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorBody;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorConfigure;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorStatistics;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorTimingByEndpoint;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorTraceStart;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorTraceStop;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorTraceFiles;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandMonitorTraceDownload;
 
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandThrottleMatching;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandThrottleRemove;
@@ -98,6 +148,20 @@ extern NSString * _Nonnull const SBTUITunneledApplicationCommandCookieBlockMatch
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandCookieBlockRemove;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandCookieBlockRemoveAll;
 
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandCassetteRecord;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandCassetteReplay;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandCassetteStop;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandCassetteLoad;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandCassetteExport;
+
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandHTTPCacheEnable;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandHTTPCacheDisable;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandHTTPCacheClear;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandHTTPCacheStatistics;
+
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandNetworkStatistics;
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandNetworkStatisticsReset;
+
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandNSUserDefaultsSetObject;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandNSUserDefaultsRemoveObject;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandNSUserDefaultsObject;
@@ -108,6 +172,8 @@ extern NSString * _Nonnull const SBTUITunneledApplicationCommandMainBundleInfoDi
 
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandCustom;
 
+extern NSString * _Nonnull const SBTUITunneledApplicationCommandBatch;
+
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandSetUserInterfaceAnimations;
 extern NSString * _Nonnull const SBTUITunneledApplicationCommandSetUserInterfaceAnimationSpeed;
 
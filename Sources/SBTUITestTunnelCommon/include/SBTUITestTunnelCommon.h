@@ -16,15 +16,27 @@
 
 #import "NSURLRequest+HTTPBodyFix.h"
 #import "SBTActiveStub.h"
+#import "SBTHTTPCacheStatistics.h"
 #import "SBTIPCTunnel.h"
+#import "SBTMonitorCapturePolicy.h"
+#import "SBTMonitoredNetworkEndpointTiming.h"
 #import "SBTMonitoredNetworkRequest.h"
+#import "SBTMonitoredNetworkRequestBinaryCoder.h"
+#import "SBTMonitoredNetworkRequestSummary.h"
+#import "SBTMonitoredNetworkRequestTiming.h"
+#import "SBTMonitoredNetworkRequestsStatistics.h"
+#import "SBTNetworkEndpointStatistics.h"
 #import "SBTRequestMatch.h"
+#import "SBTRequestNormalization.h"
 #import "SBTRequestPropertyStorage.h"
 #import "SBTRewrite.h"
 #import "SBTRewriteReplacement.h"
 #import "SBTStubFailureResponse.h"
 #import "SBTStubResponse.h"
 #import "SBTSwizzleHelpers.h"
+#import "SBTTeeInputStream.h"
+#import "SBTTunnelFrame.h"
+#import "SBTTunnelFrameConnection.h"
 #import "SBTUITestTunnel.h"
 #import "SBTUITestTunnelNetworkUtility.h"
 
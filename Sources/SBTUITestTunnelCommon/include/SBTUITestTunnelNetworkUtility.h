@@ -30,6 +30,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (NSInteger)reserveSocketPort;
 
+/**
+ *  Open a socket listening on an available loopback port
+ *
+ *  @param port On return the port the socket is listening on
+ *
+ *  @return The listening socket if successful, negative number if error
+ */
++ (int)openLoopbackListenerWithPort:(NSInteger *)port;
+
+/**
+ *  Wait for a peer to connect to a listening socket. The accepted connection is closed right away
+ *
+ *  @param listener A socket returned by +openLoopbackListenerWithPort:
+ *  @param timeout The maximum time to wait
+ *
+ *  @return YES if a peer connected before the timeout
+ */
++ (BOOL)acceptConnectionOnListener:(int)listener timeout:(NSTimeInterval)timeout;
+
+/**
+ *  Connect to a loopback port and close the connection right away, signaling the peer listening on it
+ *
+ *  @param port The port to connect to
+ *
+ *  @return YES if the peer was reached
+ */
++ (BOOL)signalLoopbackPort:(NSInteger)port;
+
 @end
 
 NS_ASSUME_NONNULL_END
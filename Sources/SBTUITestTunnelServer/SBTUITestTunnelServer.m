@@ -21,6 +21,7 @@
 @import SBTUITestTunnelCommon;
 @import CoreLocation;
 @import UserNotifications;
+@import ObjectiveC;
 
 #import "SBTWebServer.h"
 #import "SBTWebServerPrivate.h"
@@ -31,8 +32,15 @@
 #import "private/UNUserNotificationCenter+Swizzles.h"
 #import "private/UITextField+DisableAutocomplete.h"
 #import "private/SBTProxyURLProtocol.h"
+#import "private/SBTNetworkCassette.h"
+#import "private/SBTHARStubTable.h"
+#import "private/SBTHTTPCache.h"
+#import "private/SBTNetworkStatisticsAggregator.h"
+#import "private/SBTMonitoredRequestsTrace.h"
+#import "private/SBTTunnelFrameServer.h"
 #import "private/UIView+Extensions.h"
 #import "WebSocket/SBTWebSocketServer.h"
+#import "WebSocket/SBTMonitoredRequestsEventStream.h"
 
 #if !defined(NS_BLOCK_ASSERTIONS)
 
@@ -61,12 +69,35 @@ void repeating_dispatch_after(int64_t delay, dispatch_queue_t queue, BOOL (^bloc
     }
 }
 
+/// Binary parameters are base64 strings in form encoded HTTP commands and raw data in multipart bodies and frames
+static NSData *SBTDataFromParameter(id value)
+{
+    if ([value isKindOfClass:[NSData class]]) {
+        return value;
+    } else if ([value isKindOfClass:[NSString class]]) {
+        return [[NSData alloc] initWithBase64EncodedString:value options:0];
+    }
+
+    return nil;
+}
+
 @implementation SBTWebServerRequest (Extension)
 
 - (NSDictionary *)parameters
 {
     if ([self isKindOfClass:[SBTWebServerURLEncodedFormRequest class]]) {
         return ((SBTWebServerURLEncodedFormRequest *)self).arguments;
+    } else if ([self isKindOfClass:[SBTWebServerMultiPartFormRequest class]]) {
+        // binary parts carry parameters that the client would otherwise send base64 encoded, see SBTDataFromParameter()
+        NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
+        for (SBTWebServerMultiPartArgument *argument in ((SBTWebServerMultiPartFormRequest *)self).arguments) {
+            if ([argument.mimeType isEqualToString:SBTUITunnelBinaryParameterContentType]) {
+                parameters[argument.controlName] = argument.data;
+            } else {
+                parameters[argument.controlName] = argument.string ?: @"";
+            }
+        }
+        return parameters;
     } else {
         return self.query;
     }
@@ -74,12 +105,23 @@ void repeating_dispatch_after(int64_t delay, dispatch_queue_t queue, BOOL (^bloc
 
 @end
 
+/// A command method resolved once at startup
+typedef struct {
+    SEL selector;
+    IMP implementation;
+    BOOL readOnly;
+} SBTCommandHandler;
+
 @interface SBTUITestTunnelServer() <SBTIPCTunnel>
 
 @property (nonatomic, strong) SBTWebServer *server;
+@property (nonatomic, strong) SBTTunnelFrameServer *frameServer;
 @property (nonatomic, strong) dispatch_queue_t commandDispatchQueue;
+@property (nonatomic, strong) NSDictionary<NSString *, NSValue *> *commandHandlers;
 @property (nonatomic, strong) NSMutableDictionary<NSString *, void (^)(NSObject *)> *customCommands;
 @property (nonatomic, strong) NSMutableDictionary<NSString *, SBTWebSocketServer *> *webSocketServers;
+@property (nonatomic, strong) SBTMonitoredRequestsEventStream *monitoredRequestsEventStream;
+@property (nonatomic, strong) SBTMonitoredRequestsTrace *monitoredRequestsTrace;
 
 @property (nonatomic, assign) BOOL startupCompleted;
 
@@ -104,7 +146,8 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     dispatch_once(&once, ^{
         sharedInstance = [[SBTUITestTunnelServer alloc] init];
         sharedInstance.server = [[SBTWebServer alloc] init];
-        sharedInstance.commandDispatchQueue = dispatch_queue_create("com.sbtuitesttunnel.queue.command", DISPATCH_QUEUE_SERIAL);
+        sharedInstance.commandDispatchQueue = dispatch_queue_create("com.sbtuitesttunnel.queue.command", DISPATCH_QUEUE_CONCURRENT);
+        sharedInstance.commandHandlers = [self commandHandlersRegistry];
         sharedInstance.startupCompleted = NO;
         sharedInstance.coreLocationActiveManagers = NSMapTable.weakToWeakObjectsMapTable;
         sharedInstance.coreLocationStubbedServiceStatus = [NSMutableString string];
@@ -206,27 +249,103 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 {
     NSString *command = parameters[SBTUITunnelIPCCommand];
 
-    NSString *commandString = [command stringByAppendingString:@":"];
-    SEL commandSelector = NSSelectorFromString(commandString);
+    [self performCommand:command parameters:parameters completion:block];
+}
+
++ (NSDictionary<NSString *, NSValue *> *)commandHandlersRegistry
+{
+    // these commands don't change the app state, they can run concurrently with each other
+    NSSet<NSString *> *readOnlyCommands = [NSSet setWithObjects:SBTUITunneledApplicationCommandPing,
+                                           SBTUITunneledApplicationCommandStubRequestsAll,
+                                           SBTUITunneledApplicationCommandMonitorPeek,
+                                           SBTUITunneledApplicationCommandMonitorFetchSince,
+                                           SBTUITunneledApplicationCommandMonitorWait,
+                                           SBTUITunneledApplicationCommandMonitorBody,
+                                           SBTUITunneledApplicationCommandMonitorStatistics,
+                                           SBTUITunneledApplicationCommandMonitorTimingByEndpoint,
+                                           SBTUITunneledApplicationCommandMonitorTraceFiles,
+                                           SBTUITunneledApplicationCommandHTTPCacheStatistics,
+                                           SBTUITunneledApplicationCommandNetworkStatistics,
+                                           SBTUITunneledApplicationCommandNSUserDefaultsObject,
+                                           SBTUITunneledApplicationCommandMainBundleInfoDictionary,
+                                           SBTUITunneledApplicationCommandDownloadData,
+                                           nil];
+
+    NSMutableDictionary<NSString *, NSValue *> *handlers = [NSMutableDictionary dictionary];
+
+    unsigned int methodCount = 0;
+    Method *methods = class_copyMethodList(self, &methodCount);
+    for (unsigned int i = 0; i < methodCount; i++) {
+        SEL selector = method_getName(methods[i]);
+        NSString *selectorName = NSStringFromSelector(selector);
+
+        // commands take the parameters dictionary as their only argument
+        if (![selectorName hasPrefix:@"command"] || [selectorName rangeOfString:@":"].location != selectorName.length - 1) {
+            continue;
+        }
+
+        NSString *command = [selectorName substringToIndex:selectorName.length - 1];
+        SBTCommandHandler handler = { selector, method_getImplementation(methods[i]), [readOnlyCommands containsObject:command] };
+        handlers[command] = [NSValue valueWithBytes:&handler objCType:@encode(SBTCommandHandler)];
+    }
+    free(methods);
 
-    dispatch_async(self.commandDispatchQueue, ^{
-        NSDictionary *response = nil;
+    return handlers;
+}
 
-        if (![self processCustomCommandIfNecessary:command parameters:parameters returnObject:&response]) {
-            if (![self respondsToSelector:commandSelector]) {
-                BlockAssert(NO, @"[UITestTunnelServer] Unhandled/unknown command! %@", command);
-            }
+- (BOOL)commandHandler:(SBTCommandHandler *)handler forCommand:(NSString *)command
+{
+    NSValue *value = self.commandHandlers[command];
+    if (value == nil) {
+        return NO;
+    }
+
+    [value getValue:handler size:sizeof(SBTCommandHandler)];
+    return YES;
+}
 
-            IMP imp = [self methodForSelector:commandSelector];
+- (void)dispatchCommand:(NSString *)command block:(dispatch_block_t)block
+{
+    SBTCommandHandler handler;
+    if ([self commandHandler:&handler forCommand:command] && handler.readOnly) {
+        dispatch_async(self.commandDispatchQueue, block);
+    } else {
+        // anything changing the app state waits for running commands and runs alone
+        dispatch_barrier_async(self.commandDispatchQueue, block);
+    }
+}
+
+- (void)performCommand:(NSString *)command parameters:(NSDictionary *)parameters completion:(void (^)(NSDictionary *))completion
+{
+    if ([command isEqualToString:SBTUITunneledApplicationCommandMonitorWait]) {
+        // doesn't hold a command queue thread while waiting for requests
+        [self monitorWait:parameters completion:completion];
+        return;
+    }
+
+    [self dispatchCommand:command block:^{
+        completion([self executeCommand:command parameters:parameters]);
+    }];
+}
 
-            NSLog(@"[SBTUITestTunnel] Executing command '%@'", command);
+- (NSDictionary *)executeCommand:(NSString *)command parameters:(NSDictionary *)parameters
+{
+    NSDictionary *response = nil;
 
-            NSDictionary * (*func)(id, SEL, NSDictionary *) = (void *)imp;
-            response = func(self, commandSelector, parameters);
+    if (![self processCustomCommandIfNecessary:command parameters:parameters returnObject:&response]) {
+        SBTCommandHandler handler;
+        if (![self commandHandler:&handler forCommand:command]) {
+            BlockAssert(NO, @"[UITestTunnelServer] Unhandled/unknown command! %@", command);
+            return nil;
         }
 
-        block(response);
-    });
+        NSLog(@"[SBTUITestTunnel] Executing command '%@'", command);
+
+        NSDictionary * (*func)(id, SEL, NSDictionary *) = (void *)handler.implementation;
+        response = func(self, handler.selector, parameters);
+    }
+
+    return response;
 }
 
 - (BOOL)takeOffOnceUsingHTTPPort:(NSString *)tunnelPort
@@ -234,38 +353,51 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     Class requestClass = ([SBTUITunnelHTTPMethod isEqualToString:@"POST"]) ? [SBTWebServerURLEncodedFormRequest class] : [SBTWebServerRequest class];
 
     __weak typeof(self) weakSelf = self;
-    [self.server addDefaultHandlerForMethod:SBTUITunnelHTTPMethod requestClass:requestClass processBlock:^SBTWebServerResponse *(SBTWebServerRequest* request) {
+    // no thread is parked while the command waits for its turn on the command queues
+    SBTWebServerAsyncProcessBlock commandProcessBlock = ^(SBTWebServerRequest* request, SBTWebServerCompletionBlock completionBlock) {
         __strong typeof(weakSelf)strongSelf = weakSelf;
-        __block SBTWebServerDataResponse *ret;
 
-        dispatch_semaphore_t sem = dispatch_semaphore_create(0);
-        dispatch_async(strongSelf.commandDispatchQueue, ^{
-            NSString *command = [request.path stringByReplacingOccurrencesOfString:@"/" withString:@""];
-
-            NSString *commandString = [command stringByAppendingString:@":"];
-            SEL commandSelector = NSSelectorFromString(commandString);
-            NSDictionary *response = nil;
-
-            if (![strongSelf processCustomCommandIfNecessary:command parameters:request.parameters returnObject:&response]) {
-                if (![strongSelf respondsToSelector:commandSelector]) {
-                    BlockAssert(NO, @"[UITestTunnelServer] Unhandled/unknown command! %@", command);
+        // completes with an empty response if the command takes too long, like a timed out synchronous handler
+        __block BOOL completed = NO;
+        void (^completeOnce)(SBTWebServerResponse *) = ^(SBTWebServerResponse *response) {
+            @synchronized (request) {
+                if (completed) {
+                    return;
                 }
-
-                IMP imp = [strongSelf methodForSelector:commandSelector];
-
-                NSLog(@"[SBTUITestTunnel] Executing command '%@'", command);
-
-                NSDictionary * (*func)(id, SEL, NSDictionary *) = (void *)imp;
-                response = func(strongSelf, commandSelector, request.parameters);
+                completed = YES;
             }
-
-            ret = [SBTWebServerDataResponse responseWithJSONObject:response];
-
-            dispatch_semaphore_signal(sem);
+            completionBlock(response);
+        };
+
+        // a timer source, unlike dispatch_after, releases the request as soon as it is cancelled
+        dispatch_source_t timeoutTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+        dispatch_source_set_timer(timeoutTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SBTUITunneledServerDefaultTimeout * NSEC_PER_SEC)), DISPATCH_TIME_FOREVER, NSEC_PER_SEC);
+        dispatch_source_set_event_handler(timeoutTimer, ^{
+            completeOnce(nil);
         });
+        dispatch_resume(timeoutTimer);
+
+        NSString *command = [request.path stringByReplacingOccurrencesOfString:@"/" withString:@""];
+        [strongSelf performCommand:command parameters:request.parameters completion:^(NSDictionary *response) {
+            dispatch_source_cancel(timeoutTimer);
+            completeOnce([SBTWebServerDataResponse responseWithJSONObject:response]);
+        }];
+    };
+    [self.server addDefaultHandlerForMethod:SBTUITunnelHTTPMethod requestClass:requestClass asyncProcessBlock:commandProcessBlock];
+
+    // large payloads are sent as multipart bodies so that they travel as raw bytes
+    [self.server addHandlerWithMatchBlock:^SBTWebServerRequest *(NSString *requestMethod, NSURL *requestURL, NSDictionary<NSString *, NSString *> *requestHeaders, NSString *urlPath, NSDictionary<NSString *, NSString *> *urlQuery) {
+        if (![requestMethod isEqualToString:@"POST"] || ![SBTWebServerTruncateHeaderValue(requestHeaders[@"Content-Type"]) isEqualToString:[SBTWebServerMultiPartFormRequest mimeType]]) {
+            return nil;
+        }
+
+        return [[SBTWebServerMultiPartFormRequest alloc] initWithMethod:requestMethod url:requestURL headers:requestHeaders path:urlPath query:urlQuery];
+    } asyncProcessBlock:commandProcessBlock];
 
-        if (dispatch_semaphore_wait(sem, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SBTUITunneledServerDefaultTimeout * NSEC_PER_SEC))) != 0) {}
-        return ret;
+    // the monitored requests trace can be much larger than what fits in a command response
+    NSString *traceDownloadPath = [@"/" stringByAppendingString:SBTUITunneledApplicationCommandMonitorTraceDownload];
+    [self.server addHandlerForMethod:@"GET" path:traceDownloadPath requestClass:[SBTWebServerRequest class] processBlock:^SBTWebServerResponse *(SBTWebServerRequest* request) {
+        return [weakSelf monitoredRequestsTraceDownloadResponse];
     }];
 
     [self processLaunchOptionsIfNeeded];
@@ -292,12 +424,21 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
     [SBTWebServer setLogLevel:3];
 
+    // started before the HTTP server so that it's already listening once the test runner connects
+    [self startFrameServerIfNeeded];
+
     NSError *serverError = nil;
     if (![self.server startWithOptions:serverOptions error:&serverError]) {
         BlockAssert(NO, @"[UITestTunnelServer] Failed to start server on port %d. %@", [tunnelPort intValue], serverError.description);
         return NO;
     }
 
+    // the test runner waits for this instead of polling the server port
+    NSString *readyPort = [NSProcessInfo processInfo].environment[SBTUITunneledApplicationLaunchEnvironmentReadyPortKey];
+    if (readyPort != nil && ![SBTUITestTunnelNetworkUtility signalLoopbackPort:[readyPort integerValue]]) {
+        NSLog(@"[SBTUITestTunnel] Failed signaling readiness on port %@", readyPort);
+    }
+
     NSAssert([NSThread isMainThread], @"We synch startupCompleted on main thread");
     NSTimeInterval start = CFAbsoluteTimeGetCurrent();
     while (CFAbsoluteTimeGetCurrent() - start < SBTUITunneledServerDefaultTimeout) {
@@ -314,11 +455,44 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     return NO;
 }
 
+- (void)startFrameServerIfNeeded
+{
+    NSDictionary<NSString *, NSString *> *environment = [NSProcessInfo processInfo].environment;
+    NSString *framePort = environment[SBTUITunneledApplicationLaunchEnvironmentFramePortKey];
+    NSString *frameSocketPath = environment[SBTUITunneledApplicationLaunchEnvironmentFrameSocketPathKey];
+    if (framePort == nil && frameSocketPath == nil) {
+        return;
+    }
+
+    __weak typeof(self) weakSelf = self;
+    void (^commandHandler)(NSString *, NSDictionary *, void (^)(NSDictionary *)) = ^(NSString *command, NSDictionary *parameters, void (^reply)(NSDictionary *)) {
+        [weakSelf performCommand:command parameters:parameters completion:reply];
+    };
+
+    NSString *endpoint = nil;
+    if (frameSocketPath != nil) {
+        self.frameServer = [[SBTTunnelFrameServer alloc] initWithSocketPath:frameSocketPath commandHandler:commandHandler];
+        endpoint = frameSocketPath;
+    } else {
+        self.frameServer = [[SBTTunnelFrameServer alloc] initWithPort:[framePort intValue] commandHandler:commandHandler];
+        endpoint = [NSString stringWithFormat:@"port %@", framePort];
+    }
+
+    NSError *frameServerError = nil;
+    if ([self.frameServer startWithError:&frameServerError]) {
+        NSLog(@"[SBTUITestTunnel] Starting frame server on %@", endpoint);
+    } else {
+        // the test runner falls back to HTTP when it fails connecting
+        NSLog(@"[SBTUITestTunnel] Failed to start frame server on %@, %@", endpoint, frameServerError.description);
+        self.frameServer = nil;
+    }
+}
+
 - (BOOL)processCustomCommandIfNecessary:(NSString *)command parameters:(NSDictionary *)parameters returnObject:(NSObject **)returnObject
 {
     if ([command isEqualToString:SBTUITunneledApplicationCommandCustom]) {
         NSString *customCommandName = parameters[SBTUITunnelCustomCommandKey];
-        NSData *objData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelObjectKey] options:0];
+        NSData *objData = SBTDataFromParameter(parameters[SBTUITunnelObjectKey]);
 
         // this can't switch to the non-deprecated NSSecureCoding method because the types aren't known ahead of time
         #pragma clang diagnostic push
@@ -368,13 +542,13 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     SBTRequestMatch *requestMatch = nil;
 
     if ([self validStubRequest:parameters]) {
-        NSData *requestMatchData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelStubMatchRuleKey] options:0];
+        NSData *requestMatchData = SBTDataFromParameter(parameters[SBTUITunnelStubMatchRuleKey]);
 
         NSError *unarchiveMatchError;
         requestMatch = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestMatch class] fromData:requestMatchData error:&unarchiveMatchError];
         NSAssert(unarchiveMatchError == nil, @"Error unarchiving SBTRequestMatch");
 
-        NSData *responseData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelStubResponseKey] options:0];
+        NSData *responseData = SBTDataFromParameter(parameters[SBTUITunnelStubResponseKey]);
 
         NSError *unarchiveResponseError;
         SBTStubResponse *response = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTStubResponse class] fromData:responseData error:&unarchiveResponseError];
@@ -386,11 +560,39 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     return @{ SBTUITunnelResponseResultKey: stubId ?: @"", SBTUITunnelResponseDebugKey: [requestMatch description] ?: @"" };
 }
 
+- (NSDictionary *)commandStubHAR:(NSDictionary *)parameters
+{
+    NSData *harData = SBTDataFromParameter(parameters[SBTUITunnelStubHARKey]);
+    if (harData == nil) {
+        return @{ SBTUITunnelResponseResultKey: @"" };
+    }
+
+    SBTRequestNormalization *normalization = [SBTRequestNormalization defaultNormalization];
+    if (parameters[SBTUITunnelStubHARNormalizationKey] != nil) {
+        NSData *normalizationData = SBTDataFromParameter(parameters[SBTUITunnelStubHARNormalizationKey]);
+
+        NSError *unarchiveError;
+        normalization = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestNormalization class] fromData:normalizationData error:&unarchiveError];
+        NSAssert(unarchiveError == nil, @"Error unarchiving SBTRequestNormalization");
+    }
+
+    NSError *error = nil;
+    SBTHARStubTable *harTable = [[SBTHARStubTable alloc] initWithHARData:harData normalization:normalization ?: [SBTRequestNormalization defaultNormalization] error:&error];
+    if (harTable == nil) {
+        return @{ SBTUITunnelResponseResultKey: @"", SBTUITunnelResponseDebugKey: error.description ?: @"" };
+    }
+
+    NSString *stubId = [SBTProxyURLProtocol stubRequestsWithHARTable:harTable];
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Stubbed %ld requests from HAR", (unsigned long)harTable.count];
+    return @{ SBTUITunnelResponseResultKey: stubId, SBTUITunnelResponseDebugKey: debugInfo };
+}
+
 #pragma mark - Stub Remove Commands
 
 - (NSDictionary *)commandStubRequestsRemove:(NSDictionary *)parameters
 {
-    NSData *responseData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelStubMatchRuleKey] options:0];
+    NSData *responseData = SBTDataFromParameter(parameters[SBTUITunnelStubMatchRuleKey]);
 
     NSSet *classes = [NSSet setWithObjects:[NSString class], [SBTRequestMatch class], nil];
     NSError *unarchiveError;
@@ -438,13 +640,13 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     SBTRequestMatch *requestMatch = nil;
 
     if ([self validRewriteRequest:parameters]) {
-        NSData *requestMatchData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelRewriteMatchRuleKey] options:0];
+        NSData *requestMatchData = SBTDataFromParameter(parameters[SBTUITunnelRewriteMatchRuleKey]);
 
         NSError *unarchiveMatchError;
         requestMatch = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestMatch class] fromData:requestMatchData error:&unarchiveMatchError];
         NSAssert(unarchiveMatchError == nil, @"Error unarchiving SBTRequestMatch");
 
-        NSData *rewriteData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelRewriteKey] options:0];
+        NSData *rewriteData = SBTDataFromParameter(parameters[SBTUITunnelRewriteKey]);
 
         NSError *unarchiveRewriteError;
         SBTRewrite *rewrite = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRewrite class] fromData:rewriteData error:&unarchiveRewriteError];
@@ -460,7 +662,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (NSDictionary *)commandRewriteRemove:(NSDictionary *)parameters
 {
-    NSData *responseData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelRewriteMatchRuleKey] options:0];
+    NSData *responseData = SBTDataFromParameter(parameters[SBTUITunnelRewriteMatchRuleKey]);
 
     NSError *unarchiveError;
     NSString *rewriteId = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSString class] fromData:responseData error:&unarchiveError];
@@ -486,13 +688,21 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     SBTRequestMatch *requestMatch = nil;
 
     if ([self validMonitorRequest:parameters]) {
-        NSData *requestMatchData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelProxyQueryRuleKey] options:0];
+        NSData *requestMatchData = SBTDataFromParameter(parameters[SBTUITunnelProxyQueryRuleKey]);
 
         NSError *unarchiveError;
         requestMatch = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestMatch class] fromData:requestMatchData error:&unarchiveError];
         NSAssert(unarchiveError == nil, @"Error unarchiving SBTRequestMatch");
 
-        reqId = [SBTProxyURLProtocol monitorRequestsMatching:requestMatch];
+        SBTMonitorCapturePolicy *capturePolicy = nil;
+        if (parameters[SBTUITunnelMonitorCapturePolicyKey] != nil) {
+            NSData *capturePolicyData = SBTDataFromParameter(parameters[SBTUITunnelMonitorCapturePolicyKey]);
+
+            capturePolicy = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTMonitorCapturePolicy class] fromData:capturePolicyData error:&unarchiveError];
+            NSAssert(unarchiveError == nil, @"Error unarchiving SBTMonitorCapturePolicy");
+        }
+
+        reqId = [SBTProxyURLProtocol monitorRequestsMatching:requestMatch capturePolicy:capturePolicy];
     }
 
     return @{ SBTUITunnelResponseResultKey: reqId ?: @"", SBTUITunnelResponseDebugKey: [requestMatch description] ?: @"" };
@@ -500,7 +710,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (NSDictionary *)commandMonitorRemove:(NSDictionary *)parameters
 {
-    NSData *responseData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelProxyQueryRuleKey] options:0];
+    NSData *responseData = SBTDataFromParameter(parameters[SBTUITunnelProxyQueryRuleKey]);
 
     NSError *unarchiveError;
     NSString *reqId = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSString class] fromData:responseData error:&unarchiveError];
@@ -522,12 +732,24 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 {
     __block NSArray<SBTMonitoredNetworkRequest *> *requestsToFlush = @[];
 
-    requestsToFlush = [SBTProxyURLProtocol monitoredRequestsAll];
-    if (flag) {
-        [SBTProxyURLProtocol monitoredRequestsFlushAll];
+    // draining is atomic so that requests completing in between aren't lost
+    requestsToFlush = flag ? [SBTProxyURLProtocol monitoredRequestsDrainAll] : [SBTProxyURLProtocol monitoredRequestsAll];
+
+    id rootObject = requestsToFlush;
+    if ([parameters[SBTUITunnelMonitorProjectionKey] isEqualToString:SBTUITunnelMonitorProjectionSummary]) {
+        NSMutableArray<SBTMonitoredNetworkRequestSummary *> *summaries = [NSMutableArray arrayWithCapacity:requestsToFlush.count];
+        for (SBTMonitoredNetworkRequest *request in requestsToFlush) {
+            [summaries addObject:[[SBTMonitoredNetworkRequestSummary alloc] initWithMonitoredRequest:request]];
+        }
+        rootObject = summaries;
+
+        if (flag) {
+            // bodies weren't sent, allow retrieving them after the flush
+            [SBTProxyURLProtocol monitoredRequestsKeepFlushedRequests:requestsToFlush];
+        }
     }
 
-    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:requestsToFlush requiringSecureCoding:YES error:nil];
+    NSData *data = rootObject == requestsToFlush ? [self encodedMonitoredRequests:requestsToFlush parameters:parameters] : [NSKeyedArchiver archivedDataWithRootObject:rootObject requiringSecureCoding:YES error:nil];
     NSString *ret = @"";
     if (data) {
         ret = [data base64EncodedStringWithOptions:0];
@@ -538,6 +760,16 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     return @{ SBTUITunnelResponseResultKey: ret ?: @"", SBTUITunnelResponseDebugKey: debugInfo ?: @"" };
 }
 
+- (NSData *)encodedMonitoredRequests:(NSArray<SBTMonitoredNetworkRequest *> *)requests parameters:(NSDictionary *)parameters
+{
+    // clients that don't ask for the binary encoding (older versions) still receive keyed archives
+    if ([parameters[SBTUITunnelMonitorEncodingKey] isEqualToString:SBTUITunnelMonitorEncodingBinary]) {
+        return [SBTMonitoredNetworkRequestBinaryCoder dataWithRequests:requests compressBodies:YES];
+    }
+
+    return [NSKeyedArchiver archivedDataWithRootObject:requests requiringSecureCoding:YES error:nil];
+}
+
 - (NSDictionary *)commandMonitorPeek:(NSDictionary *)parameters
 {
     return [self commandMonitor:parameters flush:NO];
@@ -548,6 +780,277 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     return [self commandMonitor:parameters flush:YES];
 }
 
+- (NSDictionary *)commandMonitorBody:(NSDictionary *)parameters
+{
+    NSUInteger sequenceNumber = (NSUInteger)MAX(0, [parameters[SBTUITunnelMonitorSequenceNumberKey] longLongValue]);
+
+    SBTMonitoredNetworkRequest *request = [SBTProxyURLProtocol monitoredRequestWithSequenceNumber:sequenceNumber];
+    if (request == nil) {
+        NSString *debugInfo = [NSString stringWithFormat:@"Monitored request %lu not found", (unsigned long)sequenceNumber];
+        return @{ SBTUITunnelResponseResultKey: @"", SBTUITunnelResponseDebugKey: debugInfo };
+    }
+
+    NSData *body = [parameters[SBTUITunnelMonitorBodyKey] isEqualToString:SBTUITunnelMonitorBodyRequest] ? request.requestData : request.responseData;
+
+    return @{ SBTUITunnelResponseResultKey: [body base64EncodedStringWithOptions:0] ?: @"" };
+}
+
+- (NSDictionary *)commandMonitorFetchSince:(NSDictionary *)parameters
+{
+    NSUInteger cursor = (NSUInteger)MAX(0, [parameters[SBTUITunnelMonitorCursorKey] longLongValue]);
+
+    NSArray<SBTMonitoredNetworkRequest *> *requests = [SBTProxyURLProtocol monitoredRequestsSinceSequenceNumber:cursor];
+
+    NSData *data = [self encodedMonitoredRequests:requests parameters:parameters];
+    NSString *ret = @"";
+    if (data) {
+        ret = [data base64EncodedStringWithOptions:0];
+    }
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Found %ld monitored requests after cursor %ld", (unsigned long)requests.count, (unsigned long)cursor];
+
+    return @{ SBTUITunnelResponseResultKey: ret ?: @"", SBTUITunnelResponseDebugKey: debugInfo ?: @"" };
+}
+
+- (NSDictionary *)commandMonitorWait:(NSDictionary *)parameters
+{
+    // IPC, frames and HTTP go through monitorWait:completion:, this blocks connectionless commands. Batches reject it
+    SBTRequestMatch *requestMatch = nil;
+    NSUInteger iterations = 0;
+    NSTimeInterval timeout = 0.0;
+    if (![self monitorWaitParameters:parameters requestMatch:&requestMatch iterations:&iterations timeout:&timeout]) {
+        return @{ SBTUITunnelResponseResultKey: @"NO" };
+    }
+
+    BOOL matched = [SBTProxyURLProtocol monitoredRequestsWaitForRequestsMatching:requestMatch iterations:iterations timeout:timeout];
+
+    return [self monitorWaitResponseWithMatched:matched requestMatch:requestMatch iterations:iterations];
+}
+
+- (void)monitorWait:(NSDictionary *)parameters completion:(void (^)(NSDictionary *))completion
+{
+    SBTRequestMatch *requestMatch = nil;
+    NSUInteger iterations = 0;
+    NSTimeInterval timeout = 0.0;
+    if (![self monitorWaitParameters:parameters requestMatch:&requestMatch iterations:&iterations timeout:&timeout]) {
+        completion(@{ SBTUITunnelResponseResultKey: @"NO" });
+        return;
+    }
+
+    NSLog(@"[SBTUITestTunnel] Executing command '%@'", SBTUITunneledApplicationCommandMonitorWait);
+
+    __weak typeof(self) weakSelf = self;
+    [SBTProxyURLProtocol monitoredRequestsWaitForRequestsMatching:requestMatch iterations:iterations timeout:timeout completion:^(BOOL matched) {
+        completion([weakSelf monitorWaitResponseWithMatched:matched requestMatch:requestMatch iterations:iterations]);
+    }];
+}
+
+- (BOOL)monitorWaitParameters:(NSDictionary *)parameters requestMatch:(SBTRequestMatch **)requestMatch iterations:(NSUInteger *)iterations timeout:(NSTimeInterval *)timeout
+{
+    if (![self validMonitorRequest:parameters]) {
+        return NO;
+    }
+
+    NSData *requestMatchData = SBTDataFromParameter(parameters[SBTUITunnelProxyQueryRuleKey]);
+
+    NSError *unarchiveError;
+    *requestMatch = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestMatch class] fromData:requestMatchData error:&unarchiveError];
+    NSAssert(unarchiveError == nil, @"Error unarchiving SBTRequestMatch");
+
+    *iterations = (NSUInteger)MAX(0, [parameters[SBTUITunnelMonitorIterationsKey] integerValue]);
+    // the client splits longer waits, never wait past the tunnel's request timeout
+    *timeout = MIN(MAX(0.0, [parameters[SBTUITunnelMonitorTimeoutKey] doubleValue]), SBTUITunneledServerDefaultTimeout / 2.0);
+
+    return YES;
+}
+
+- (NSDictionary *)monitorWaitResponseWithMatched:(BOOL)matched requestMatch:(SBTRequestMatch *)requestMatch iterations:(NSUInteger)iterations
+{
+    NSString *debugInfo = [NSString stringWithFormat:@"%@ waiting %ld iterations of %@", matched ? @"Matched" : @"Timed out", (unsigned long)iterations, requestMatch];
+
+    return @{ SBTUITunnelResponseResultKey: matched ? @"YES" : @"NO", SBTUITunnelResponseDebugKey: debugInfo };
+}
+
+- (NSDictionary *)commandMonitorSubscribe:(NSDictionary *)parameters
+{
+    [self.monitoredRequestsEventStream stop];
+    self.monitoredRequestsEventStream = nil;
+
+    NSInteger port = [SBTUITestTunnelNetworkUtility reserveSocketPort];
+    if (port < 0) {
+        NSLog(@"[SBTUITestTunnel] Failed to find available port for monitored requests event stream");
+        return @{ SBTUITunnelResponseResultKey: @"0" };
+    }
+
+    BOOL lossy = [parameters[SBTUITunnelMonitorLossyKey] boolValue];
+    NSInteger window = [parameters[SBTUITunnelMonitorWindowKey] integerValue];
+
+    SBTMonitoredRequestsEventStream *eventStream = [[SBTMonitoredRequestsEventStream alloc] initWithPort:port lossy:lossy window:window > 0 ? window : SBTMonitoredRequestsEventStreamDefaultWindow];
+    NSError *error = nil;
+    [eventStream startWithError:&error];
+    if (error) {
+        NSLog(@"[SBTUITestTunnel] Failed to start monitored requests event stream: %@", error.description);
+        return @{ SBTUITunnelResponseResultKey: @"0" };
+    }
+
+    self.monitoredRequestsEventStream = eventStream;
+
+    __weak typeof(eventStream) weakEventStream = eventStream;
+    [SBTProxyURLProtocol monitoredRequestsSetObserver:^(SBTMonitoredNetworkRequest *request) {
+        SBTMonitoredNetworkRequestSummary *summary = [[SBTMonitoredNetworkRequestSummary alloc] initWithMonitoredRequest:request];
+        NSData *event = [NSJSONSerialization dataWithJSONObject:[summary JSONObject] options:0 error:nil];
+        if (event) {
+            [weakEventStream publishEvent:event];
+        }
+    }];
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Publishing monitored requests on port %ld%@", (long)port, lossy ? @" (lossy)" : @""];
+
+    return @{ SBTUITunnelResponseResultKey: [NSString stringWithFormat:@"%ld", (long)port], SBTUITunnelResponseDebugKey: debugInfo };
+}
+
+- (NSDictionary *)commandMonitorUnsubscribe:(NSDictionary *)parameters
+{
+    [SBTProxyURLProtocol monitoredRequestsSetObserver:nil];
+
+    NSUInteger droppedCount = self.monitoredRequestsEventStream.droppedCount;
+    [self.monitoredRequestsEventStream stop];
+    self.monitoredRequestsEventStream = nil;
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Stopped publishing monitored requests, %lu events dropped", (unsigned long)droppedCount];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES", SBTUITunnelResponseDebugKey: debugInfo };
+}
+
+- (NSDictionary *)commandMonitorTraceStart:(NSDictionary *)parameters
+{
+    // zero values fallback to defaults
+    unsigned long long maximumFileSize = (unsigned long long)MAX(0, [parameters[SBTUITunnelMonitorTraceFileSizeKey] longLongValue]);
+    NSUInteger maximumFileCount = (NSUInteger)MAX(0, [parameters[SBTUITunnelMonitorTraceFileCountKey] integerValue]);
+    if (maximumFileCount == 0) {
+        maximumFileCount = SBTMonitoredRequestsTraceDefaultMaximumFileCount;
+    }
+
+    // stop appending to the previous trace before its files get removed
+    [SBTProxyURLProtocol monitoredRequestsSetTrace:nil];
+    [self.monitoredRequestsTrace synchronize];
+
+    NSURL *directoryURL = [SBTMonitoredRequestsTrace defaultDirectoryURL];
+    SBTMonitoredRequestsTrace *trace = [[SBTMonitoredRequestsTrace alloc] initWithDirectoryURL:directoryURL
+                                                                               maximumFileSize:maximumFileSize
+                                                                              maximumFileCount:maximumFileCount];
+    self.monitoredRequestsTrace = trace;
+    [SBTProxyURLProtocol monitoredRequestsSetTrace:trace];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES", SBTUITunnelResponseDebugKey: directoryURL.path };
+}
+
+- (NSDictionary *)commandMonitorTraceStop:(NSDictionary *)parameters
+{
+    // the trace is kept around so that it can still be retrieved
+    [SBTProxyURLProtocol monitoredRequestsSetTrace:nil];
+    [self.monitoredRequestsTrace synchronize];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES" };
+}
+
+- (NSDictionary *)commandMonitorTraceFiles:(NSDictionary *)parameters
+{
+    [self.monitoredRequestsTrace synchronize];
+
+    NSMutableArray<NSString *> *paths = [NSMutableArray array];
+    for (NSURL *fileURL in self.monitoredRequestsTrace.fileURLs) {
+        [paths addObject:fileURL.path];
+    }
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:paths requiringSecureCoding:YES error:nil];
+
+    return @{ SBTUITunnelResponseResultKey: [data base64EncodedStringWithOptions:0] ?: @"" };
+}
+
+- (SBTWebServerResponse *)monitoredRequestsTraceDownloadResponse
+{
+    __block NSArray<NSURL *> *fileURLs = nil;
+    dispatch_barrier_sync(self.commandDispatchQueue, ^{
+        [self.monitoredRequestsTrace synchronize];
+        fileURLs = self.monitoredRequestsTrace.fileURLs ?: @[];
+    });
+
+    // appends keep going while streaming and rotation may delete files, so the download is a snapshot:
+    // files are opened upfront (an open file outlives its removal) and read up to their current length
+    NSMutableArray<NSFileHandle *> *fileHandles = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *remainingLengths = [NSMutableArray array];
+    for (NSURL *fileURL in fileURLs) {
+        NSFileHandle *fileHandle = [NSFileHandle fileHandleForReadingFromURL:fileURL error:nil];
+        if (fileHandle == nil) {
+            continue;
+        }
+        [fileHandles addObject:fileHandle];
+        [remainingLengths addObject:@([fileHandle seekToEndOfFile])];
+        [fileHandle seekToFileOffset:0];
+    }
+
+    // files are streamed one chunk at a time, the whole trace is never loaded in memory
+    __block NSUInteger fileIndex = 0;
+    SBTWebServerStreamedResponse *response = [SBTWebServerStreamedResponse responseWithContentType:@"application/x-ndjson" streamBlock:^NSData *(NSError **error) {
+        while (fileIndex < fileHandles.count) {
+            unsigned long long remainingLength = [remainingLengths[fileIndex] unsignedLongLongValue];
+            NSData *chunk = remainingLength > 0 ? [fileHandles[fileIndex] readDataOfLength:(NSUInteger)MIN(remainingLength, 256 * 1024)] : nil;
+            if (chunk.length > 0) {
+                remainingLengths[fileIndex] = @(remainingLength - chunk.length);
+                return chunk;
+            }
+
+            [fileHandles[fileIndex] closeFile];
+            fileIndex++;
+        }
+
+        return [NSData data];
+    }];
+
+    return response;
+}
+
+- (NSDictionary *)commandMonitorConfigure:(NSDictionary *)parameters
+{
+    NSUInteger capacity = (NSUInteger)MAX(0, [parameters[SBTUITunnelMonitorCapacityKey] integerValue]);
+    SBTMonitoredNetworkRequestsOverflowPolicy overflowPolicy = [parameters[SBTUITunnelMonitorOverflowPolicyKey] integerValue];
+
+    [SBTProxyURLProtocol monitoredRequestsSetCapacity:capacity overflowPolicy:overflowPolicy];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES" };
+}
+
+- (NSDictionary *)commandMonitorStatistics:(NSDictionary *)parameters
+{
+    NSString *ret = nil;
+
+    SBTMonitoredNetworkRequestsStatistics *statistics = [SBTProxyURLProtocol monitoredRequestsStatistics];
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:statistics requiringSecureCoding:YES error:nil];
+    if (data) {
+        ret = [data base64EncodedStringWithOptions:0];
+    }
+
+    return @{ SBTUITunnelResponseResultKey: ret ?: @"", SBTUITunnelResponseDebugKey: statistics.description };
+}
+
+- (NSDictionary *)commandMonitorTimingByEndpoint:(NSDictionary *)parameters
+{
+    NSString *ret = nil;
+
+    NSArray<SBTMonitoredNetworkEndpointTiming *> *endpointTimings = [SBTMonitoredNetworkEndpointTiming endpointTimingsWithRequests:[SBTProxyURLProtocol monitoredRequestsAll]];
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:endpointTimings requiringSecureCoding:YES error:nil];
+    if (data) {
+        ret = [data base64EncodedStringWithOptions:0];
+    }
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Found %ld endpoints", (unsigned long)endpointTimings.count];
+
+    return @{ SBTUITunnelResponseResultKey: ret ?: @"", SBTUITunnelResponseDebugKey: debugInfo };
+}
+
 #pragma mark - Request Throttle Commands
 
 - (NSDictionary *)commandThrottleMatching:(NSDictionary *)parameters
@@ -556,7 +1059,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     SBTRequestMatch *requestMatch = nil;
 
     if ([self validThrottleRequest:parameters]) {
-        NSData *requestMatchData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelProxyQueryRuleKey] options:0];
+        NSData *requestMatchData = SBTDataFromParameter(parameters[SBTUITunnelProxyQueryRuleKey]);
 
         NSError *unarchiveError;
         requestMatch = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestMatch class] fromData:requestMatchData error:&unarchiveError];
@@ -572,7 +1075,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (NSDictionary *)commandThrottleRemove:(NSDictionary *)parameters
 {
-    NSData *responseData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelProxyQueryRuleKey] options:0];
+    NSData *responseData = SBTDataFromParameter(parameters[SBTUITunnelProxyQueryRuleKey]);
 
     NSError *unarchiveError;
     NSString *reqId = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSString class] fromData:responseData error:&unarchiveError];
@@ -597,7 +1100,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     SBTRequestMatch *requestMatch = nil;
 
     if ([self validCookieBlockRequest:parameters]) {
-        NSData *requestMatchData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelCookieBlockMatchRuleKey] options:0];
+        NSData *requestMatchData = SBTDataFromParameter(parameters[SBTUITunnelCookieBlockMatchRuleKey]);
 
         NSError *unarchiveError;
         requestMatch = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestMatch class] fromData:requestMatchData error:&unarchiveError];
@@ -615,7 +1118,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (NSDictionary *)commandCookiesBlockRemove:(NSDictionary *)parameters
 {
-    NSData *responseData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelCookieBlockMatchRuleKey] options:0];
+    NSData *responseData = SBTDataFromParameter(parameters[SBTUITunnelCookieBlockMatchRuleKey]);
 
     NSError *unarchiveError;
     NSString *reqId = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSString class] fromData:responseData error:&unarchiveError];
@@ -632,13 +1135,155 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     return @{ SBTUITunnelResponseResultKey: @"YES" };
 }
 
+#pragma mark - Cassette Commands
+
+- (NSDictionary *)commandCassetteRecord:(NSDictionary *)parameters
+{
+    NSString *cassetteName = [self cassetteNameFromParameters:parameters];
+    if (cassetteName.length == 0) {
+        return @{ SBTUITunnelResponseResultKey: @"NO" };
+    }
+
+    SBTNetworkCassette *cassette = [[SBTNetworkCassette alloc] initWithDirectoryURL:[SBTNetworkCassette directoryURLForCassetteNamed:cassetteName]
+                                                                      normalization:[SBTRequestNormalization defaultNormalization]];
+
+    NSError *error = nil;
+    if (cassette == nil || ![cassette eraseWithError:&error]) {
+        return @{ SBTUITunnelResponseResultKey: @"NO", SBTUITunnelResponseDebugKey: error.description ?: @"" };
+    }
+
+    [SBTProxyURLProtocol cassetteStartRecording:cassette];
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Recording cassette at %@", cassette.directoryURL.path];
+    return @{ SBTUITunnelResponseResultKey: @"YES", SBTUITunnelResponseDebugKey: debugInfo };
+}
+
+- (NSDictionary *)commandCassetteReplay:(NSDictionary *)parameters
+{
+    NSString *cassetteName = [self cassetteNameFromParameters:parameters];
+    if (cassetteName.length == 0) {
+        return @{ SBTUITunnelResponseResultKey: @"NO" };
+    }
+
+    SBTRequestNormalization *normalization = [SBTRequestNormalization defaultNormalization];
+    if (parameters[SBTUITunnelCassetteNormalizationKey] != nil) {
+        NSData *normalizationData = SBTDataFromParameter(parameters[SBTUITunnelCassetteNormalizationKey]);
+
+        NSError *unarchiveError;
+        normalization = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTRequestNormalization class] fromData:normalizationData error:&unarchiveError];
+        NSAssert(unarchiveError == nil, @"Error unarchiving SBTRequestNormalization");
+    }
+
+    SBTNetworkCassette *cassette = [[SBTNetworkCassette alloc] initWithDirectoryURL:[SBTNetworkCassette directoryURLForCassetteNamed:cassetteName]
+                                                                      normalization:normalization ?: [SBTRequestNormalization defaultNormalization]];
+    if (cassette == nil) {
+        return @{ SBTUITunnelResponseResultKey: @"NO" };
+    }
+
+    [SBTProxyURLProtocol cassetteStartReplaying:cassette];
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Replaying %ld requests from cassette %@", (unsigned long)cassette.count, cassetteName];
+    return @{ SBTUITunnelResponseResultKey: @"YES", SBTUITunnelResponseDebugKey: debugInfo };
+}
+
+- (NSDictionary *)commandCassetteStop:(NSDictionary *)parameters
+{
+    [SBTProxyURLProtocol cassetteStop];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES" };
+}
+
+- (NSDictionary *)commandCassetteLoad:(NSDictionary *)parameters
+{
+    NSString *cassetteName = [self cassetteNameFromParameters:parameters];
+    NSData *cassetteData = SBTDataFromParameter(parameters[SBTUITunnelCassetteDataKey]);
+    if (cassetteName.length == 0 || cassetteData == nil) {
+        return @{ SBTUITunnelResponseResultKey: @"NO" };
+    }
+
+    NSString *ret = [SBTNetworkCassette unarchiveCassette:cassetteData toDirectoryURL:[SBTNetworkCassette directoryURLForCassetteNamed:cassetteName]] ? @"YES" : @"NO";
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Loaded %ld bytes into cassette %@", (unsigned long)cassetteData.length, cassetteName];
+    return @{ SBTUITunnelResponseResultKey: ret, SBTUITunnelResponseDebugKey: debugInfo };
+}
+
+- (NSDictionary *)commandCassetteExport:(NSDictionary *)parameters
+{
+    NSString *cassetteName = [self cassetteNameFromParameters:parameters];
+    NSData *cassetteData = cassetteName.length > 0 ? [SBTNetworkCassette archivedCassetteAtDirectoryURL:[SBTNetworkCassette directoryURLForCassetteNamed:cassetteName]] : nil;
+
+    return @{ SBTUITunnelResponseResultKey: [cassetteData base64EncodedStringWithOptions:0] ?: @"" };
+}
+
+#pragma mark - HTTP Cache Commands
+
+- (NSDictionary *)commandHTTPCacheEnable:(NSDictionary *)parameters
+{
+    [SBTProxyURLProtocol httpCacheSetEnabled:YES];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES" };
+}
+
+- (NSDictionary *)commandHTTPCacheDisable:(NSDictionary *)parameters
+{
+    [SBTProxyURLProtocol httpCacheSetEnabled:NO];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES" };
+}
+
+- (NSDictionary *)commandHTTPCacheClear:(NSDictionary *)parameters
+{
+    [[SBTProxyURLProtocol httpCache] removeAll];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES" };
+}
+
+- (NSDictionary *)commandHTTPCacheStatistics:(NSDictionary *)parameters
+{
+    NSString *ret = nil;
+
+    SBTHTTPCacheStatistics *statistics = [SBTProxyURLProtocol httpCache].statistics;
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:statistics requiringSecureCoding:YES error:nil];
+    if (data) {
+        ret = [data base64EncodedStringWithOptions:0];
+    }
+
+    return @{ SBTUITunnelResponseResultKey: ret ?: @"", SBTUITunnelResponseDebugKey: statistics.description };
+}
+
+#pragma mark - Network Statistics Commands
+
+- (NSDictionary *)commandNetworkStatistics:(NSDictionary *)parameters
+{
+    NSString *ret = nil;
+
+    NSArray<SBTNetworkEndpointStatistics *> *statistics = [[SBTProxyURLProtocol networkStatistics] allStatistics];
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:statistics requiringSecureCoding:YES error:nil];
+    if (data) {
+        ret = [data base64EncodedStringWithOptions:0];
+    }
+
+    NSString *debugInfo = [NSString stringWithFormat:@"Found %ld endpoints", (unsigned long)statistics.count];
+
+    return @{ SBTUITunnelResponseResultKey: ret ?: @"", SBTUITunnelResponseDebugKey: debugInfo };
+}
+
+- (NSDictionary *)commandNetworkStatisticsReset:(NSDictionary *)parameters
+{
+    [[SBTProxyURLProtocol networkStatistics] reset];
+
+    return @{ SBTUITunnelResponseResultKey: @"YES" };
+}
+
 #pragma mark - NSUSerDefaults Commands
 
 - (NSDictionary *)commandNSUserDefaultsSetObject:(NSDictionary *)parameters
 {
     NSString *objKey = parameters[SBTUITunnelObjectKeyKey];
     NSString *suiteName = parameters[SBTUITunnelUserDefaultSuiteNameKey];
-    NSData *objData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelObjectKey] options:0];
+    NSData *objData = SBTDataFromParameter(parameters[SBTUITunnelObjectKey]);
 
     // this can't switch to the non-deprecated NSSecureCoding method because the types aren't known ahead of time
     #pragma clang diagnostic push
@@ -708,7 +1353,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (NSDictionary *)commandNSUserDefaultsRegisterDefaults:(NSDictionary *)parameters
 {
-    NSData *objData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelObjectKey] options:0];
+    NSData *objData = SBTDataFromParameter(parameters[SBTUITunnelObjectKey]);
     NSString *suiteName = parameters[SBTUITunnelUserDefaultSuiteNameKey];
 
     // this can't switch to the non-deprecated NSSecureCoding method because the types aren't known ahead of time
@@ -767,8 +1412,8 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (NSDictionary *)commandUpload:(NSDictionary *)parameters
 {
-    NSData *fileData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelUploadDataKey] options:0];
-    NSData *pathData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelUploadDestPathKey] options:0];
+    NSData *fileData = SBTDataFromParameter(parameters[SBTUITunnelUploadDataKey]);
+    NSData *pathData = SBTDataFromParameter(parameters[SBTUITunnelUploadDestPathKey]);
 
     NSError *unarchiveError;
     NSString *destPath = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSString class] fromData:pathData error:&unarchiveError];
@@ -809,7 +1454,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     NSString *basePath = [NSSearchPathForDirectoriesInDomains(basePathDirectory, NSUserDomainMask, YES) firstObject];
 
     NSArray *basePathContent = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:basePath error:nil];
-    NSData *pathData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelDownloadPathKey] options:0];
+    NSData *pathData = SBTDataFromParameter(parameters[SBTUITunnelDownloadPathKey]);
 
     NSError *unarchiveError;
     NSString *filesToMatch = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSString class] fromData:pathData error:&unarchiveError];
@@ -1508,7 +2153,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 - (NSDictionary *)commandCoreLocationStubManagerLocation:(NSDictionary *)parameters
 {
     #if !DISABLE_UITUNNEL_SWIZZLING
-        NSData *locationsData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelObjectKey] options:0];
+        NSData *locationsData = SBTDataFromParameter(parameters[SBTUITunnelObjectKey]);
 
         NSError *unarchiveError;
         NSSet *classes = [NSSet setWithObjects:[NSArray class], [CLLocation class], [NSNull class], nil];
@@ -1582,7 +2227,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     [self commandCoreLocationStubManagerLocation:parameters];
 
     #if !DISABLE_UITUNNEL_SWIZZLING
-        NSData *locationsData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelObjectKey] options:0];
+        NSData *locationsData = SBTDataFromParameter(parameters[SBTUITunnelObjectKey]);
 
         NSError *unarchiveError;
         NSSet *classes = [NSSet setWithObjects:[NSArray class], [CLLocation class], nil];
@@ -1617,7 +2262,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 - (NSDictionary *)commandCoreLocationNotifyFailure:(NSDictionary *)parameters
 {
     #if !DISABLE_UITUNNEL_SWIZZLING
-        NSData *paramData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelObjectKey] options:0];
+        NSData *paramData = SBTDataFromParameter(parameters[SBTUITunnelObjectKey]);
 
         NSError *unarchiveError;
         NSError *error = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSError class] fromData:paramData error:&unarchiveError];
@@ -1704,6 +2349,38 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     [[self customCommands] removeObjectForKey:commandName];
 }
 
+#pragma mark - Batch Commands
+
+- (NSDictionary *)commandBatch:(NSDictionary *)parameters
+{
+    NSData *commandsData = SBTDataFromParameter(parameters[SBTUITunnelBatchCommandsKey]);
+
+    NSSet *classes = [NSSet setWithObjects:[NSArray class], [NSDictionary class], [NSString class], nil];
+    NSError *unarchiveError;
+    NSArray<NSDictionary *> *commands = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:commandsData error:&unarchiveError];
+    NSAssert(unarchiveError == nil, @"Error unarchiving batch commands");
+
+    // already running on the command dispatch queue, sub-commands are executed in order without interleaving with other commands
+    NSMutableArray *results = [NSMutableArray arrayWithCapacity:commands.count];
+    for (NSDictionary *command in commands) {
+        NSString *commandPath = command[SBTUITunnelBatchCommandPathKey];
+        if ([commandPath isEqualToString:SBTUITunneledApplicationCommandMonitorWait]) {
+            // waiting would hold the command dispatch queue (batches run behind a barrier) for up to the wait timeout
+            NSLog(@"[SBTUITestTunnel] Command '%@' is not supported in batches", commandPath);
+            [results addObject:[NSNull null]];
+            continue;
+        }
+
+        NSDictionary *response = [self executeCommand:commandPath parameters:command[SBTUITunnelBatchCommandParametersKey] ?: @{}];
+        [results addObject:response[SBTUITunnelResponseResultKey] ?: [NSNull null]];
+    }
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:results requiringSecureCoding:YES error:nil];
+    NSString *ret = [data base64EncodedStringWithOptions:0];
+
+    return @{ SBTUITunnelResponseResultKey: ret ?: @"", SBTUITunnelResponseDebugKey: [NSString stringWithFormat:@"%ld commands", (long)commands.count] };
+}
+
 #pragma mark - Helper Methods
 
 - (void)processLaunchOptionsIfNeeded
@@ -1715,11 +2392,14 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     if ([[NSProcessInfo processInfo].arguments containsObject:SBTUITunneledApplicationLaunchOptionDisableUITextFieldAutocomplete]) {
         [UITextField disableAutocompleteOnce];
     }
+    if ([[NSProcessInfo processInfo].arguments containsObject:SBTUITunneledApplicationLaunchOptionEnableHTTPCache]) {
+        [SBTProxyURLProtocol httpCacheSetEnabled:YES];
+    }
 }
 
 - (BOOL)validStubRequest:(NSDictionary *)parameters
 {
-    if (![[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelStubMatchRuleKey] options:0]) {
+    if (!SBTDataFromParameter(parameters[SBTUITunnelStubMatchRuleKey])) {
         NSLog(@"[SBTUITestTunnel] Invalid stubRequest received!");
 
         return NO;
@@ -1730,7 +2410,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (BOOL)validRewriteRequest:(NSDictionary *)parameters
 {
-    if (![[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelRewriteMatchRuleKey] options:0]) {
+    if (!SBTDataFromParameter(parameters[SBTUITunnelRewriteMatchRuleKey])) {
         NSLog(@"[SBTUITestTunnel] Invalid rewriteRequest received!");
 
         return NO;
@@ -1741,7 +2421,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (BOOL)validMonitorRequest:(NSDictionary *)parameters
 {
-    if (![[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelProxyQueryRuleKey] options:0]) {
+    if (!SBTDataFromParameter(parameters[SBTUITunnelProxyQueryRuleKey])) {
         NSLog(@"[SBTUITestTunnel] Invalid monitorRequest received!");
 
         return NO;
@@ -1752,7 +2432,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (BOOL)validThrottleRequest:(NSDictionary *)parameters
 {
-    if (parameters[SBTUITunnelProxyQueryResponseTimeKey] != nil && ![[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelProxyQueryRuleKey] options:0]) {
+    if (parameters[SBTUITunnelProxyQueryResponseTimeKey] != nil && !SBTDataFromParameter(parameters[SBTUITunnelProxyQueryRuleKey])) {
         NSLog(@"[SBTUITestTunnel] Invalid throttleRequest received!");
 
         return NO;
@@ -1763,7 +2443,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 - (BOOL)validCookieBlockRequest:(NSDictionary *)parameters
 {
-    if (![[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelCookieBlockMatchRuleKey] options:0]) {
+    if (!SBTDataFromParameter(parameters[SBTUITunnelCookieBlockMatchRuleKey])) {
         NSLog(@"[SBTUITestTunnel] Invalid cookieBlockRequest received!");
 
         return NO;
@@ -1772,6 +2452,22 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
     return YES;
 }
 
+- (NSString *)cassetteNameFromParameters:(NSDictionary *)parameters
+{
+    NSData *nameData = SBTDataFromParameter(parameters[SBTUITunnelCassetteNameKey]);
+    if (nameData == nil) {
+        NSLog(@"[SBTUITestTunnel] Invalid cassette request received!");
+
+        return nil;
+    }
+
+    NSError *unarchiveError;
+    NSString *cassetteName = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSString class] fromData:nameData error:&unarchiveError];
+    NSAssert(unarchiveError == nil, @"Error unarchiving NSString");
+
+    return cassetteName;
+}
+
 #pragma mark - Helper Functions
 
 // https://gist.github.com/michalzelinka/67adfa0142767575194f
@@ -1795,28 +2491,12 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
 + (NSString *)performCommand:(NSString *)commandName params:(NSDictionary<NSString *, NSString *> *)params
 {
-    NSString *commandString = [commandName stringByAppendingString:@":"];
-    SEL commandSelector = NSSelectorFromString(commandString);
-
     NSMutableDictionary *unescapedParams = [params mutableCopy];
     for (NSString *key in params) {
         unescapedParams[key] = [unescapedParams[key] stringByRemovingPercentEncoding];
     }
 
-    NSDictionary *response = nil;
-
-    if (![self.sharedInstance processCustomCommandIfNecessary:commandName parameters:unescapedParams returnObject:&response]) {
-        if (![self.sharedInstance respondsToSelector:commandSelector]) {
-            NSAssert(NO, @"[UITestTunnelServer] Unhandled/unknown command! %@", commandName);
-        }
-
-        IMP imp = [self.sharedInstance methodForSelector:commandSelector];
-
-        NSLog(@"[SBTUITestTunnel] Executing command '%@'", commandName);
-
-        NSDictionary * (*func)(id, SEL, NSDictionary *) = (void *)imp;
-        response = func(self.sharedInstance, commandSelector, unescapedParams);
-    }
+    NSDictionary *response = [self.sharedInstance executeCommand:commandName parameters:unescapedParams];
 
     return response[SBTUITunnelResponseResultKey];
 }
@@ -1833,6 +2513,9 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 
     [self.webSocketServers removeAllObjects];
 
+    [self.monitoredRequestsEventStream stop];
+    self.monitoredRequestsEventStream = nil;
+
     [[self customCommands] removeAllObjects];
 }
 
@@ -1908,7 +2591,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
 - (NSDictionary *)commandStubWebSocket:(NSDictionary *)parameters
 {
     NSString *identifier = parameters[SBTUITunnelObjectKey];
-    NSData *responseData = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelStubResponseKey] options:0];
+    NSData *responseData = SBTDataFromParameter(parameters[SBTUITunnelStubResponseKey]);
 
     if ([identifier length] == 0) {
         NSLog(@"[SBTUITestTunnel] Invalid WebSocket identifier received!");
@@ -1961,7 +2644,7 @@ static NSTimeInterval SBTUITunneledServerDefaultTimeout = 60.0;
         return @{ SBTUITunnelResponseResultKey: @"NO" };
     }
 
-    NSData *message = [[NSData alloc] initWithBase64EncodedString:parameters[SBTUITunnelObjectValueKey] options:0];
+    NSData *message = SBTDataFromParameter(parameters[SBTUITunnelObjectValueKey]);
 
     SBTWebSocketServer *webSocketServer = self.webSocketServers[identifier];
     if (!webSocketServer) {
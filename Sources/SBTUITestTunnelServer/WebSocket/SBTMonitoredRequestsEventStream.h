@@ -0,0 +1,65 @@
+// SBTMonitoredRequestsEventStream.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+@import Network;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Default number of events sent to a subscriber and not yet acknowledged by the network stack
+extern const NSUInteger SBTMonitoredRequestsEventStreamDefaultWindow;
+
+/// Maximum number of events queued for a subscriber that fell behind, the oldest ones are dropped past this limit
+extern const NSUInteger SBTMonitoredRequestsEventStreamMaximumPendingEvents;
+
+/// A WebSocket server pushing monitored request events to the test runner as binary messages.
+///
+/// Every subscriber has a window of in-flight events. When a subscriber falls behind, events exceeding the
+/// window are either queued and sent as soon as previous sends complete, or dropped when the stream is lossy.
+/// Queues are bounded, a stalled subscriber loses its oldest queued events instead of growing the app memory.
+/// Dropped events can be detected by the subscriber as gaps in the events' sequence numbers.
+@interface SBTMonitoredRequestsEventStream : NSObject
+
+/**
+ *  Initializer
+ *
+ *  @param port The port on which the server will listen for subscribers
+ *  @param lossy `YES` to drop events when a subscriber's window is full, `NO` to queue them
+ *  @param window The maximum number of in-flight events per subscriber
+ */
+- (instancetype)initWithPort:(NSInteger)port lossy:(BOOL)lossy window:(NSUInteger)window;
+
+/**
+ *  Starts listening and accepting subscribers.
+ *
+ *  @param error An error object that will be set if the server fails to start
+ */
+- (void)startWithError:(NSError **)error;
+
+/// Disconnects all subscribers and stops listening
+- (void)stop;
+
+/// Asynchronously sends an event to all subscribers
+- (void)publishEvent:(NSData *)event;
+
+@property (nonatomic, assign, readonly) NSInteger port;
+
+/// The number of events dropped because a subscriber's window or queue was full
+@property (nonatomic, assign, readonly) NSUInteger droppedCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
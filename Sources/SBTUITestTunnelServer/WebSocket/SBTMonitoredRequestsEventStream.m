@@ -0,0 +1,210 @@
+// SBTMonitoredRequestsEventStream.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "SBTMonitoredRequestsEventStream.h"
+
+const NSUInteger SBTMonitoredRequestsEventStreamDefaultWindow = 64;
+const NSUInteger SBTMonitoredRequestsEventStreamMaximumPendingEvents = 4096;
+
+@interface SBTMonitoredRequestsEventSubscriber : NSObject
+
+@property (nonatomic, strong) nw_connection_t connection;
+@property (nonatomic, assign) BOOL ready;
+@property (nonatomic, assign) NSUInteger inFlightCount;
+@property (nonatomic, strong) NSMutableArray<NSData *> *pendingEvents;
+
+@end
+
+@implementation SBTMonitoredRequestsEventSubscriber
+@end
+
+@interface SBTMonitoredRequestsEventStream ()
+
+@property (nonatomic, assign, readwrite) NSInteger port;
+@property (nonatomic, assign) BOOL lossy;
+@property (nonatomic, assign) NSUInteger window;
+@property (nonatomic, strong) nw_listener_t listener;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableArray<SBTMonitoredRequestsEventSubscriber *> *subscribers;
+@property (atomic, assign, readwrite) NSUInteger droppedCount;
+
+@end
+
+@implementation SBTMonitoredRequestsEventStream
+
+- (instancetype)initWithPort:(NSInteger)port lossy:(BOOL)lossy window:(NSUInteger)window
+{
+    self = [super init];
+    if (self) {
+        _port = port;
+        _lossy = lossy;
+        _window = MAX(1, window);
+        _subscribers = [NSMutableArray array];
+        // not the main queue, commands waiting for monitored requests may block it in connectionless mode
+        _queue = dispatch_queue_create("com.sbtuitesttunnel.monitor.events", DISPATCH_QUEUE_SERIAL);
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_listener) {
+        nw_listener_cancel(_listener);
+    }
+
+    for (SBTMonitoredRequestsEventSubscriber *subscriber in _subscribers) {
+        nw_connection_cancel(subscriber.connection);
+    }
+}
+
+- (void)startWithError:(NSError **)error
+{
+    nw_parameters_t parameters = nw_parameters_create_secure_tcp(NW_PARAMETERS_DISABLE_PROTOCOL, NW_PARAMETERS_DEFAULT_CONFIGURATION);
+    nw_parameters_set_reuse_local_address(parameters, true);
+
+    nw_protocol_options_t wsOptions = nw_ws_create_options(nw_ws_version_13);
+    nw_ws_options_set_auto_reply_ping(wsOptions, true);
+
+    nw_protocol_stack_t stack = nw_parameters_copy_default_protocol_stack(parameters);
+    nw_protocol_stack_prepend_application_protocol(stack, wsOptions);
+
+    const char *portCString = [[NSString stringWithFormat:@"%ld", self.port] UTF8String];
+    nw_endpoint_t endpoint = nw_endpoint_create_host("127.0.0.1", portCString);
+    nw_parameters_set_local_endpoint(parameters, endpoint);
+
+    self.listener = nw_listener_create(parameters);
+    if (!self.listener) {
+        if (error) {
+            *error = [NSError errorWithDomain:@"SBTMonitoredRequestsEventStream"
+                                         code:-1
+                                     userInfo:@{ NSLocalizedDescriptionKey: @"nw_listener_create failed" }];
+        }
+
+        return;
+    }
+
+    __weak typeof(self) weakSelf = self;
+    nw_listener_set_new_connection_handler(self.listener, ^(nw_connection_t connection) {
+        [weakSelf acceptConnection:connection];
+    });
+
+    nw_listener_set_queue(self.listener, self.queue);
+    nw_listener_start(self.listener);
+
+    NSLog(@"[SBTUITestTunnel] Monitored requests event stream listening on port %ld", self.port);
+}
+
+- (void)stop
+{
+    dispatch_sync(self.queue, ^{
+        if (self.listener) {
+            nw_listener_cancel(self.listener);
+            self.listener = nil;
+        }
+
+        for (SBTMonitoredRequestsEventSubscriber *subscriber in self.subscribers) {
+            nw_connection_cancel(subscriber.connection);
+        }
+        [self.subscribers removeAllObjects];
+    });
+}
+
+#pragma mark - Subscribers
+
+// called on self.queue
+- (void)acceptConnection:(nw_connection_t)connection
+{
+    SBTMonitoredRequestsEventSubscriber *subscriber = [[SBTMonitoredRequestsEventSubscriber alloc] init];
+    subscriber.connection = connection;
+    subscriber.pendingEvents = [NSMutableArray array];
+    [self.subscribers addObject:subscriber];
+
+    __weak typeof(self) weakSelf = self;
+    __weak typeof(subscriber) weakSubscriber = subscriber;
+    nw_connection_set_state_changed_handler(connection, ^(nw_connection_state_t state, nw_error_t _Nullable err) {
+        __strong typeof(weakSubscriber) strongSubscriber = weakSubscriber;
+        if (state == nw_connection_state_ready) {
+            NSLog(@"[SBTUITestTunnel] Monitored requests event stream subscriber connected");
+            strongSubscriber.ready = YES;
+            [weakSelf sendPendingEventsToSubscriber:strongSubscriber];
+        } else if (state == nw_connection_state_failed || state == nw_connection_state_cancelled) {
+            NSLog(@"[SBTUITestTunnel] Monitored requests event stream subscriber disconnected %@", err ?: @"");
+            if (strongSubscriber) {
+                [weakSelf.subscribers removeObject:strongSubscriber];
+            }
+        }
+    });
+
+    nw_connection_set_queue(connection, self.queue);
+    nw_connection_start(connection);
+}
+
+- (void)publishEvent:(NSData *)event
+{
+    dispatch_async(self.queue, ^{
+        for (SBTMonitoredRequestsEventSubscriber *subscriber in self.subscribers) {
+            if (subscriber.ready && subscriber.inFlightCount < self.window && subscriber.pendingEvents.count == 0) {
+                [self sendEvent:event toSubscriber:subscriber];
+            } else if (self.lossy) {
+                self.droppedCount++;
+            } else {
+                if (subscriber.pendingEvents.count >= SBTMonitoredRequestsEventStreamMaximumPendingEvents) {
+                    [subscriber.pendingEvents removeObjectAtIndex:0];
+                    self.droppedCount++;
+                }
+                [subscriber.pendingEvents addObject:event];
+            }
+        }
+    });
+}
+
+// called on self.queue
+- (void)sendPendingEventsToSubscriber:(SBTMonitoredRequestsEventSubscriber *)subscriber
+{
+    while (subscriber.ready && subscriber.inFlightCount < self.window && subscriber.pendingEvents.count > 0) {
+        NSData *event = subscriber.pendingEvents.firstObject;
+        [subscriber.pendingEvents removeObjectAtIndex:0];
+        [self sendEvent:event toSubscriber:subscriber];
+    }
+}
+
+// called on self.queue
+- (void)sendEvent:(NSData *)event toSubscriber:(SBTMonitoredRequestsEventSubscriber *)subscriber
+{
+    dispatch_data_t content = dispatch_data_create(event.bytes, event.length, self.queue, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
+
+    nw_protocol_metadata_t metadata = nw_ws_create_metadata(nw_ws_opcode_binary);
+    nw_content_context_t context = nw_content_context_create("monitored-request-event");
+    nw_content_context_set_metadata_for_protocol(context, metadata);
+
+    subscriber.inFlightCount++;
+
+    __weak typeof(self) weakSelf = self;
+    nw_connection_send(subscriber.connection, content, context, true, ^(nw_error_t _Nullable sendErr) {
+        // completions are delivered on self.queue once the network stack consumed the event
+        subscriber.inFlightCount--;
+
+        if (sendErr) {
+            NSLog(@"[SBTUITestTunnel] Monitored requests event stream send failed: %@", sendErr);
+            return;
+        }
+
+        [weakSelf sendPendingEventsToSubscriber:subscriber];
+    });
+}
+
+@end
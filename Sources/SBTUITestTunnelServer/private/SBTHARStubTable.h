@@ -0,0 +1,51 @@
+// SBTHARStubTable.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTRequestNormalization;
+@class SBTStubResponse;
+
+/// A table of stub responses built from a HAR (HTTP Archive) file.
+///
+/// Entries are indexed by their normalized request key, so finding the stub of a request is a
+/// dictionary lookup instead of a linear scan of regular-expression rules. When the archive contains
+/// the same request multiple times, responses are returned in archive order. Once they run out, the
+/// last one is repeated.
+@interface SBTHARStubTable : NSObject
+
+@property (nonnull, nonatomic, readonly) NSString *identifier;
+@property (nonnull, nonatomic, readonly) SBTRequestNormalization *normalization;
+
+/// The number of stubbed exchanges
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  Parses a HAR file into a stub table
+ *
+ *  @param harData the JSON content of the HAR file
+ *  @param normalization how requests are reduced to lookup keys
+ *  @param error set when the HAR file is not valid
+ */
+- (nullable instancetype)initWithHARData:(nonnull NSData *)harData normalization:(nonnull SBTRequestNormalization *)normalization error:(NSError * _Nullable * _Nullable)error;
+
+/// Returns YES if the table contains a stub for the request
+- (BOOL)containsRequest:(nonnull NSURLRequest *)request;
+
+/// Returns the stub response of a request, nil if the request isn't part of the archive
+- (nullable SBTStubResponse *)responseForRequest:(nonnull NSURLRequest *)request;
+
+@end
@@ -0,0 +1,199 @@
+// SBTHARStubTable.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import SBTUITestTunnelCommon;
+
+#import "SBTHARStubTable.h"
+
+@interface SBTHARStubTable()
+
+@property (nonatomic, strong) NSString *identifier;
+@property (nonatomic, strong) SBTRequestNormalization *normalization;
+@property (nonatomic, strong) NSDictionary<NSString *, NSArray<SBTStubResponse *> *> *responsesByKey;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *cursors;
+@property (nonatomic, assign) NSUInteger count;
+
+@end
+
+@implementation SBTHARStubTable
+
+- (instancetype)initWithHARData:(NSData *)harData normalization:(SBTRequestNormalization *)normalization error:(NSError **)error
+{
+    NSDictionary *har = [NSJSONSerialization JSONObjectWithData:harData options:0 error:error];
+    NSArray<NSDictionary *> *harEntries = [har isKindOfClass:[NSDictionary class]] ? har[@"log"][@"entries"] : nil;
+
+    if (![harEntries isKindOfClass:[NSArray class]]) {
+        if (error != NULL && *error == nil) {
+            *error = [NSError errorWithDomain:@"com.subito.sbtuitesttunnel.har"
+                                         code:1
+                                     userInfo:@{NSLocalizedDescriptionKey: @"Invalid HAR file, missing log.entries"}];
+        }
+        return nil;
+    }
+
+    if (self = [super init]) {
+        self.identifier = [@"har-" stringByAppendingString:[[NSUUID UUID] UUIDString]];
+        self.normalization = normalization;
+        self.cursors = [NSMutableDictionary dictionary];
+
+        NSMutableDictionary<NSString *, NSMutableArray<SBTStubResponse *> *> *responsesByKey = [NSMutableDictionary dictionary];
+        for (NSDictionary *harEntry in harEntries) {
+            if (![harEntry isKindOfClass:[NSDictionary class]]) {
+                continue;
+            }
+
+            NSString *key = [self keyForHAREntry:harEntry];
+            SBTStubResponse *response = [self stubResponseForHAREntry:harEntry];
+            if (key == nil || response == nil) {
+                continue;
+            }
+
+            NSMutableArray<SBTStubResponse *> *responses = responsesByKey[key];
+            if (responses == nil) {
+                responses = [NSMutableArray array];
+                responsesByKey[key] = responses;
+            }
+
+            [responses addObject:response];
+            self.count++;
+        }
+
+        self.responsesByKey = responsesByKey;
+    }
+
+    return self;
+}
+
+#pragma mark - Parsing
+
+- (NSString *)keyForHAREntry:(NSDictionary *)harEntry
+{
+    NSDictionary *harRequest = harEntry[@"request"];
+    NSURL *url = [harRequest isKindOfClass:[NSDictionary class]] ? [NSURL URLWithString:harRequest[@"url"]] : nil;
+    if (url == nil) {
+        return nil;
+    }
+
+    NSString *bodyDigest = nil;
+    NSString *postText = harRequest[@"postData"][@"text"];
+    if ([postText isKindOfClass:[NSString class]] && postText.length > 0) {
+        bodyDigest = [SBTRequestNormalization digestOfData:[postText dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+
+    return [self.normalization keyForMethod:harRequest[@"method"]
+                                        url:url
+                                    headers:[self headersFromHARHeaders:harRequest[@"headers"]]
+                                 bodyDigest:bodyDigest];
+}
+
+- (SBTStubResponse *)stubResponseForHAREntry:(NSDictionary *)harEntry
+{
+    NSDictionary *harResponse = harEntry[@"response"];
+    if (![harResponse isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    NSInteger status = [harResponse[@"status"] integerValue];
+    if (status <= 0) {
+        // requests that were blocked or aborted while capturing have no response
+        return nil;
+    }
+
+    NSDictionary *content = harResponse[@"content"];
+    NSString *text = [content isKindOfClass:[NSDictionary class]] ? content[@"text"] : nil;
+
+    NSData *body = [NSData data];
+    if ([text isKindOfClass:[NSString class]]) {
+        if ([content[@"encoding"] isEqual:@"base64"]) {
+            body = [[NSData alloc] initWithBase64EncodedString:text options:NSDataBase64DecodingIgnoreUnknownCharacters] ?: [NSData data];
+        } else {
+            body = [text dataUsingEncoding:NSUTF8StringEncoding] ?: [NSData data];
+        }
+    }
+
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary dictionary];
+    __block NSString *contentType = nil;
+    [[self headersFromHARHeaders:harResponse[@"headers"]] enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        if ([key caseInsensitiveCompare:@"Content-Type"] == NSOrderedSame) {
+            // SBTStubResponse sets the Content-Type header itself
+            contentType = value;
+        } else if ([key caseInsensitiveCompare:@"Content-Encoding"] != NSOrderedSame &&
+                   [key caseInsensitiveCompare:@"Transfer-Encoding"] != NSOrderedSame &&
+                   [key caseInsensitiveCompare:@"Content-Length"] != NSOrderedSame) {
+            // HAR content is stored decoded, the original transfer headers don't describe it anymore
+            headers[key] = value;
+        }
+    }];
+    headers[@"Content-Length"] = [@(body.length) stringValue];
+
+    if (contentType == nil && [content[@"mimeType"] isKindOfClass:[NSString class]]) {
+        contentType = content[@"mimeType"];
+    }
+
+    return [[SBTStubResponse alloc] initWithResponse:body
+                                             headers:headers
+                                         contentType:contentType
+                                          returnCode:status
+                                        responseTime:0.0
+                                    activeIterations:0];
+}
+
+/// HAR headers are an array of name/value pairs, repeated headers are joined as in NSHTTPURLResponse
+- (NSDictionary<NSString *, NSString *> *)headersFromHARHeaders:(NSArray<NSDictionary *> *)harHeaders
+{
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary dictionary];
+    if (![harHeaders isKindOfClass:[NSArray class]]) {
+        return headers;
+    }
+
+    for (NSDictionary *harHeader in harHeaders) {
+        NSString *name = harHeader[@"name"];
+        NSString *value = harHeader[@"value"];
+        if (![name isKindOfClass:[NSString class]] || ![value isKindOfClass:[NSString class]] || [name hasPrefix:@":"]) {
+            // skip HTTP/2 pseudo headers (e.g. :authority)
+            continue;
+        }
+
+        headers[name] = headers[name] != nil ? [NSString stringWithFormat:@"%@, %@", headers[name], value] : value;
+    }
+
+    return headers;
+}
+
+#pragma mark - Lookup
+
+- (BOOL)containsRequest:(NSURLRequest *)request
+{
+    return self.responsesByKey[[self.normalization keyForRequest:request body:nil]] != nil;
+}
+
+- (SBTStubResponse *)responseForRequest:(NSURLRequest *)request
+{
+    NSString *key = [self.normalization keyForRequest:request body:nil];
+    NSArray<SBTStubResponse *> *responses = self.responsesByKey[key];
+    if (responses.count == 0) {
+        return nil;
+    }
+
+    @synchronized (self) {
+        NSUInteger cursor = [self.cursors[key] unsignedIntegerValue];
+        self.cursors[key] = @(cursor + 1);
+
+        return responses[MIN(cursor, responses.count - 1)];
+    }
+}
+
+@end
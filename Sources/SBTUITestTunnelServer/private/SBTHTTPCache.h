@@ -0,0 +1,78 @@
+// SBTHTTPCache.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTHTTPCacheStatistics;
+@class SBTStubResponse;
+
+/// A response stored in the HTTP cache
+@interface SBTHTTPCacheEntry : NSObject
+
+@property (nonnull, nonatomic, readonly) NSHTTPURLResponse *response;
+@property (nonnull, nonatomic, readonly) NSData *data;
+@property (nonnull, nonatomic, readonly) NSDate *storedAt;
+
+/// YES if the response can be served without revalidation according to its Cache-Control, Expires and Last-Modified headers
+@property (nonatomic, readonly) BOOL isFresh;
+
+/// YES if the response carries an ETag or a Last-Modified validator
+@property (nonatomic, readonly) BOOL canBeRevalidated;
+
+/// Adds the If-None-Match and If-Modified-Since headers needed to revalidate the entry
+- (void)addValidatorsToRequest:(nonnull NSMutableURLRequest *)request;
+
+/// The entry as a stub response
+- (nonnull SBTStubResponse *)stubResponse;
+
+@end
+
+/// A read-through HTTP cache for passthrough GET requests, persisted in the app container so that
+/// identical requests performed by different tests (and different launches) hit the network once.
+///
+/// Entries are keyed on the normalized url and, as specified by the Vary header of the response, on the
+/// values of the request headers that selected the representation. Stale entries carrying an ETag or a
+/// Last-Modified header are revalidated with a conditional request.
+@interface SBTHTTPCache : NSObject
+
+/// Cumulative counters since the cache was created or cleared
+@property (nonnull, nonatomic, readonly) SBTHTTPCacheStatistics *statistics;
+
+/// Returns the cache stored in the default folder of the app container
++ (nonnull instancetype)sharedCache;
+
+- (nonnull instancetype)initWithDirectoryURL:(nonnull NSURL *)directoryURL;
+
+/// Returns YES if the request can be served by the cache
++ (BOOL)canCacheRequest:(nonnull NSURLRequest *)request;
+
+/// Returns the entry matching the request, nil if none
+- (nullable SBTHTTPCacheEntry *)entryForRequest:(nonnull NSURLRequest *)request;
+
+/// Stores a response fetched from the network if its headers allow so
+- (void)storeResponse:(nonnull NSHTTPURLResponse *)response data:(nonnull NSData *)data forRequest:(nonnull NSURLRequest *)request;
+
+/// Refreshes an entry after a 304 Not Modified response, returns the updated entry
+- (nonnull SBTHTTPCacheEntry *)updateEntry:(nonnull SBTHTTPCacheEntry *)entry withNotModifiedResponse:(nonnull NSHTTPURLResponse *)response forRequest:(nonnull NSURLRequest *)request;
+
+- (void)recordHit;
+- (void)recordRevalidation;
+- (void)recordMiss;
+
+/// Removes all entries and resets counters
+- (void)removeAll;
+
+@end
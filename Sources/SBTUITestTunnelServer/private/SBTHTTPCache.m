@@ -0,0 +1,454 @@
+// SBTHTTPCache.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import SBTUITestTunnelCommon;
+
+#import "SBTHTTPCache.h"
+
+static NSString * const SBTHTTPCacheBodiesFolder = @"bodies";
+
+static NSString * const SBTHTTPCacheVaryKey = @"vary";
+static NSString * const SBTHTTPCacheStatusKey = @"status";
+static NSString * const SBTHTTPCacheHeadersKey = @"headers";
+static NSString * const SBTHTTPCacheBodyKey = @"body";
+static NSString * const SBTHTTPCacheStoredAtKey = @"storedAt";
+
+/// Case insensitive header lookup, NSHTTPURLResponse's valueForHTTPHeaderField: requires iOS 13
+static NSString *SBTHTTPCacheHeaderValue(NSDictionary<NSString *, NSString *> *headers, NSString *name)
+{
+    for (NSString *header in headers) {
+        if ([header caseInsensitiveCompare:name] == NSOrderedSame) {
+            return headers[header];
+        }
+    }
+
+    return nil;
+}
+
+static NSDate *SBTHTTPCacheDateFromHeader(NSString *value)
+{
+    if (value.length == 0) {
+        return nil;
+    }
+
+    static NSDateFormatter *formatter;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formatter = [[NSDateFormatter alloc] init];
+        formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+        formatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+    });
+
+    @synchronized (formatter) {
+        return [formatter dateFromString:value];
+    }
+}
+
+/// Returns the Cache-Control directives of a response, lowercased, with their value (or an empty string)
+static NSDictionary<NSString *, NSString *> *SBTHTTPCacheControlDirectives(NSDictionary<NSString *, NSString *> *headers)
+{
+    NSMutableDictionary<NSString *, NSString *> *directives = [NSMutableDictionary dictionary];
+    NSString *cacheControl = SBTHTTPCacheHeaderValue(headers, @"Cache-Control");
+
+    for (NSString *component in [cacheControl componentsSeparatedByString:@","]) {
+        NSArray<NSString *> *parts = [component componentsSeparatedByString:@"="];
+        NSString *name = [[parts.firstObject stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] lowercaseString];
+        if (name.length == 0) {
+            continue;
+        }
+
+        NSString *value = parts.count > 1 ? [parts[1] stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@" \""]] : @"";
+        directives[name] = value;
+    }
+
+    return directives;
+}
+
+#pragma mark - SBTHTTPCacheEntry
+
+@interface SBTHTTPCacheEntry()
+
+@property (nonatomic, strong) NSHTTPURLResponse *response;
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, strong) NSDate *storedAt;
+
+@end
+
+@implementation SBTHTTPCacheEntry
+
+- (instancetype)initWithResponse:(NSHTTPURLResponse *)response data:(NSData *)data storedAt:(NSDate *)storedAt
+{
+    if (self = [super init]) {
+        self.response = response;
+        self.data = data;
+        self.storedAt = storedAt;
+    }
+
+    return self;
+}
+
+- (NSTimeInterval)freshnessLifetime
+{
+    NSDictionary<NSString *, NSString *> *headers = self.response.allHeaderFields;
+    NSDictionary<NSString *, NSString *> *directives = SBTHTTPCacheControlDirectives(headers);
+
+    if (directives[@"no-cache"] != nil) {
+        return 0.0;
+    }
+    if (directives[@"max-age"] != nil) {
+        return [directives[@"max-age"] doubleValue];
+    }
+
+    NSDate *date = SBTHTTPCacheDateFromHeader(SBTHTTPCacheHeaderValue(headers, @"Date")) ?: self.storedAt;
+    NSDate *expires = SBTHTTPCacheDateFromHeader(SBTHTTPCacheHeaderValue(headers, @"Expires"));
+    if (expires != nil) {
+        return [expires timeIntervalSinceDate:date];
+    }
+
+    // heuristic freshness as suggested by RFC 9111, 10% of the time since the last modification
+    NSDate *lastModified = SBTHTTPCacheDateFromHeader(SBTHTTPCacheHeaderValue(headers, @"Last-Modified"));
+    if (lastModified != nil) {
+        return MAX(0.0, [date timeIntervalSinceDate:lastModified] * 0.1);
+    }
+
+    return 0.0;
+}
+
+- (BOOL)isFresh
+{
+    NSTimeInterval age = [SBTHTTPCacheHeaderValue(self.response.allHeaderFields, @"Age") doubleValue] - [self.storedAt timeIntervalSinceNow];
+
+    return age < [self freshnessLifetime];
+}
+
+- (BOOL)canBeRevalidated
+{
+    NSDictionary<NSString *, NSString *> *headers = self.response.allHeaderFields;
+
+    return SBTHTTPCacheHeaderValue(headers, @"ETag") != nil || SBTHTTPCacheHeaderValue(headers, @"Last-Modified") != nil;
+}
+
+- (void)addValidatorsToRequest:(NSMutableURLRequest *)request
+{
+    NSDictionary<NSString *, NSString *> *headers = self.response.allHeaderFields;
+
+    NSString *etag = SBTHTTPCacheHeaderValue(headers, @"ETag");
+    if (etag != nil) {
+        [request setValue:etag forHTTPHeaderField:@"If-None-Match"];
+    }
+
+    NSString *lastModified = SBTHTTPCacheHeaderValue(headers, @"Last-Modified");
+    if (lastModified != nil) {
+        [request setValue:lastModified forHTTPHeaderField:@"If-Modified-Since"];
+    }
+}
+
+- (SBTStubResponse *)stubResponse
+{
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary dictionary];
+    __block NSString *contentType = nil;
+    [self.response.allHeaderFields enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        if ([key caseInsensitiveCompare:@"Content-Type"] == NSOrderedSame) {
+            contentType = value;
+        } else {
+            headers[key] = value;
+        }
+    }];
+
+    return [[SBTStubResponse alloc] initWithResponse:self.data
+                                             headers:headers
+                                         contentType:contentType
+                                          returnCode:self.response.statusCode
+                                        responseTime:0.0
+                                    activeIterations:0];
+}
+
+@end
+
+#pragma mark - SBTHTTPCache
+
+@interface SBTHTTPCache()
+
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) SBTRequestNormalization *normalization;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<NSDictionary *> *> *variantsByKey;
+@property (nonatomic, strong) SBTHTTPCacheStatistics *statistics;
+
+@end
+
+@implementation SBTHTTPCache
+
++ (instancetype)sharedCache
+{
+    static dispatch_once_t once;
+    static SBTHTTPCache *sharedCache;
+    dispatch_once(&once, ^{
+        NSString *basePath = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+        NSURL *directoryURL = [NSURL fileURLWithPath:[basePath stringByAppendingPathComponent:@"SBTUITestTunnel/HTTPCache"] isDirectory:YES];
+
+        sharedCache = [[SBTHTTPCache alloc] initWithDirectoryURL:directoryURL];
+    });
+    return sharedCache;
+}
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL
+{
+    if (self = [super init]) {
+        self.directoryURL = directoryURL;
+        // the body of GET requests is not part of the key, Vary headers are matched separately
+        self.normalization = [[SBTRequestNormalization alloc] initWithIncludesQuery:YES ignoredQueryItems:nil includesBody:NO headers:nil];
+        self.variantsByKey = [NSMutableDictionary dictionary];
+        self.statistics = [[SBTHTTPCacheStatistics alloc] init];
+
+        [[NSFileManager defaultManager] createDirectoryAtURL:[directoryURL URLByAppendingPathComponent:SBTHTTPCacheBodiesFolder] withIntermediateDirectories:YES attributes:nil error:nil];
+    }
+
+    return self;
+}
+
++ (BOOL)canCacheRequest:(NSURLRequest *)request
+{
+    if (![(request.HTTPMethod ?: @"GET") isEqualToString:@"GET"]) {
+        return NO;
+    }
+
+    NSDictionary<NSString *, NSString *> *headers = request.allHTTPHeaderFields;
+    if (SBTHTTPCacheHeaderValue(headers, @"If-None-Match") != nil ||
+        SBTHTTPCacheHeaderValue(headers, @"If-Modified-Since") != nil ||
+        SBTHTTPCacheHeaderValue(headers, @"Range") != nil) {
+        // the app is validating its own cache or asking for partial content, let the server answer
+        return NO;
+    }
+
+    return SBTHTTPCacheControlDirectives(@{@"Cache-Control": SBTHTTPCacheHeaderValue(headers, @"Cache-Control") ?: @""})[@"no-store"] == nil;
+}
+
+#pragma mark - Lookup
+
+- (SBTHTTPCacheEntry *)entryForRequest:(NSURLRequest *)request
+{
+    NSString *key = [self keyForRequest:request];
+
+    NSDictionary *variant = nil;
+    @synchronized (self) {
+        for (NSDictionary *candidate in [self variantsForKey:key]) {
+            if ([self variant:candidate matchesRequest:request]) {
+                variant = candidate;
+                break;
+            }
+        }
+    }
+
+    if (variant == nil) {
+        return nil;
+    }
+
+    NSData *data = [NSData data];
+    NSString *bodyDigest = variant[SBTHTTPCacheBodyKey];
+    if (bodyDigest.length > 0) {
+        data = [NSData dataWithContentsOfURL:[self bodyURLForDigest:bodyDigest] options:NSDataReadingMappedIfSafe error:nil];
+        if (data == nil) {
+            return nil;
+        }
+    }
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL
+                                                              statusCode:[variant[SBTHTTPCacheStatusKey] integerValue]
+                                                             HTTPVersion:nil
+                                                            headerFields:variant[SBTHTTPCacheHeadersKey]];
+
+    return [[SBTHTTPCacheEntry alloc] initWithResponse:response data:data storedAt:variant[SBTHTTPCacheStoredAtKey]];
+}
+
+- (BOOL)variant:(NSDictionary *)variant matchesRequest:(NSURLRequest *)request
+{
+    NSDictionary<NSString *, NSString *> *vary = variant[SBTHTTPCacheVaryKey];
+    for (NSString *header in vary) {
+        NSString *requestValue = SBTHTTPCacheHeaderValue(request.allHTTPHeaderFields, header) ?: @"";
+        if (![requestValue isEqualToString:vary[header]]) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+#pragma mark - Storing
+
+- (void)storeResponse:(NSHTTPURLResponse *)response data:(NSData *)data forRequest:(NSURLRequest *)request
+{
+    NSDictionary<NSString *, NSString *> *responseHeaders = response.allHeaderFields;
+    NSDictionary<NSString *, NSString *> *directives = SBTHTTPCacheControlDirectives(responseHeaders);
+    NSString *varyHeader = SBTHTTPCacheHeaderValue(responseHeaders, @"Vary");
+
+    if (response.statusCode != 200 || directives[@"no-store"] != nil || [varyHeader containsString:@"*"]) {
+        return;
+    }
+
+    NSMutableDictionary<NSString *, NSString *> *vary = [NSMutableDictionary dictionary];
+    for (NSString *component in [varyHeader componentsSeparatedByString:@","]) {
+        NSString *header = [[component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] lowercaseString];
+        if (header.length > 0) {
+            vary[header] = SBTHTTPCacheHeaderValue(request.allHTTPHeaderFields, header) ?: @"";
+        }
+    }
+
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary dictionary];
+    [responseHeaders enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        // the URL loading system already decoded the payload, the body is stored as received by the app
+        if ([key caseInsensitiveCompare:@"Content-Encoding"] != NSOrderedSame &&
+            [key caseInsensitiveCompare:@"Transfer-Encoding"] != NSOrderedSame &&
+            [key caseInsensitiveCompare:@"Content-Length"] != NSOrderedSame) {
+            headers[key] = value;
+        }
+    }];
+    headers[@"Content-Length"] = [@(data.length) stringValue];
+
+    NSString *bodyDigest = @"";
+    if (data.length > 0) {
+        bodyDigest = [SBTRequestNormalization digestOfData:data];
+        NSURL *bodyURL = [self bodyURLForDigest:bodyDigest];
+        if (![[NSFileManager defaultManager] fileExistsAtPath:bodyURL.path] && ![data writeToURL:bodyURL atomically:YES]) {
+            NSLog(@"[SBTUITestTunnel] Failed to store cached body for %@", request.URL);
+            return;
+        }
+    }
+
+    NSDictionary *variant = @{ SBTHTTPCacheVaryKey: vary,
+                               SBTHTTPCacheStatusKey: @(response.statusCode),
+                               SBTHTTPCacheHeadersKey: headers,
+                               SBTHTTPCacheBodyKey: bodyDigest,
+                               SBTHTTPCacheStoredAtKey: [NSDate date] };
+
+    NSString *key = [self keyForRequest:request];
+    @synchronized (self) {
+        NSMutableArray<NSDictionary *> *variants = [self variantsForKey:key];
+        NSIndexSet *replaced = [variants indexesOfObjectsPassingTest:^BOOL(NSDictionary *candidate, NSUInteger idx, BOOL *stop) {
+            return [candidate[SBTHTTPCacheVaryKey] isEqualToDictionary:vary];
+        }];
+        [variants removeObjectsAtIndexes:replaced];
+        [variants insertObject:variant atIndex:0];
+
+        [self persistVariants:variants forKey:key];
+    }
+}
+
+- (SBTHTTPCacheEntry *)updateEntry:(SBTHTTPCacheEntry *)entry withNotModifiedResponse:(NSHTTPURLResponse *)response forRequest:(NSURLRequest *)request
+{
+    // a 304 carries the up-to-date caching headers of the stored representation
+    NSMutableDictionary<NSString *, NSString *> *headers = [entry.response.allHeaderFields mutableCopy];
+    for (NSString *header in @[@"Cache-Control", @"Date", @"Expires", @"ETag", @"Last-Modified", @"Vary"]) {
+        NSString *value = SBTHTTPCacheHeaderValue(response.allHeaderFields, header);
+        if (value != nil) {
+            for (NSString *existing in [headers allKeys]) {
+                if ([existing caseInsensitiveCompare:header] == NSOrderedSame) {
+                    [headers removeObjectForKey:existing];
+                }
+            }
+            headers[header] = value;
+        }
+    }
+
+    NSHTTPURLResponse *updatedResponse = [[NSHTTPURLResponse alloc] initWithURL:entry.response.URL statusCode:entry.response.statusCode HTTPVersion:nil headerFields:headers];
+    [self storeResponse:updatedResponse data:entry.data forRequest:request];
+
+    return [[SBTHTTPCacheEntry alloc] initWithResponse:updatedResponse data:entry.data storedAt:[NSDate date]];
+}
+
+#pragma mark - Statistics
+
+- (SBTHTTPCacheStatistics *)statistics
+{
+    @synchronized (self) {
+        return [_statistics copy];
+    }
+}
+
+- (void)recordHit
+{
+    @synchronized (self) {
+        _statistics.hits++;
+    }
+}
+
+- (void)recordRevalidation
+{
+    @synchronized (self) {
+        _statistics.revalidations++;
+    }
+}
+
+- (void)recordMiss
+{
+    @synchronized (self) {
+        _statistics.misses++;
+    }
+}
+
+- (void)removeAll
+{
+    @synchronized (self) {
+        [self.variantsByKey removeAllObjects];
+        self.statistics = [[SBTHTTPCacheStatistics alloc] init];
+
+        NSFileManager *fm = [NSFileManager defaultManager];
+        [fm removeItemAtURL:self.directoryURL error:nil];
+        [fm createDirectoryAtURL:[self.directoryURL URLByAppendingPathComponent:SBTHTTPCacheBodiesFolder] withIntermediateDirectories:YES attributes:nil error:nil];
+    }
+}
+
+#pragma mark - Persistence
+
+- (NSString *)keyForRequest:(NSURLRequest *)request
+{
+    NSString *key = [self.normalization keyForMethod:@"GET" url:request.URL headers:nil bodyDigest:nil];
+
+    return [SBTRequestNormalization digestOfData:[key dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+- (NSURL *)bodyURLForDigest:(NSString *)digest
+{
+    return [[self.directoryURL URLByAppendingPathComponent:SBTHTTPCacheBodiesFolder] URLByAppendingPathComponent:digest];
+}
+
+- (NSURL *)variantsURLForKey:(NSString *)key
+{
+    return [self.directoryURL URLByAppendingPathComponent:[key stringByAppendingPathExtension:@"plist"]];
+}
+
+/// Returns the variants stored for a key, loading them from disk the first time. Must be called while synchronized
+- (NSMutableArray<NSDictionary *> *)variantsForKey:(NSString *)key
+{
+    NSMutableArray<NSDictionary *> *variants = self.variantsByKey[key];
+    if (variants == nil) {
+        NSArray *stored = [NSArray arrayWithContentsOfURL:[self variantsURLForKey:key]];
+        variants = [stored isKindOfClass:[NSArray class]] ? [stored mutableCopy] : [NSMutableArray array];
+        self.variantsByKey[key] = variants;
+    }
+
+    return variants;
+}
+
+- (void)persistVariants:(NSArray<NSDictionary *> *)variants forKey:(NSString *)key
+{
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:variants format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+    if (![data writeToURL:[self variantsURLForKey:key] atomically:YES]) {
+        NSLog(@"[SBTUITestTunnel] Failed to persist HTTP cache entry %@", key);
+    }
+}
+
+@end
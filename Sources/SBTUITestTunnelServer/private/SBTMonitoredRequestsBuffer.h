@@ -0,0 +1,69 @@
+// SBTMonitoredRequestsBuffer.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+@import SBTUITestTunnelCommon;
+
+/// A ring buffer holding monitored requests.
+///
+/// When the buffer is full the oldest request is either dropped or spilled to an append-only file,
+/// depending on the overflow policy. Spilled requests are read back, oldest first, when peeking or
+/// draining the buffer. The buffer is not thread safe, callers serialize access.
+@interface SBTMonitoredRequestsBuffer : NSObject
+
+/**
+ *  Initializer
+ *
+ *  @param capacity the maximum number of requests kept in memory, 0 for unbounded
+ *  @param overflowPolicy what happens to the oldest request when the buffer is full
+ *  @param spillFileURL the file where requests are spilled, removed when the buffer is created
+ */
+- (nonnull instancetype)initWithCapacity:(NSUInteger)capacity
+                          overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy
+                            spillFileURL:(nonnull NSURL *)spillFileURL;
+
+/// Returns the default spill file in the app container
++ (nonnull NSURL *)defaultSpillFileURL;
+
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) SBTMonitoredNetworkRequestsOverflowPolicy overflowPolicy;
+
+/// Assigns the next sequence number to the request and appends it to the buffer
+- (void)appendRequest:(nonnull SBTMonitoredNetworkRequest *)request;
+
+/// The sequence number of the last appended request, 0 if none. Sequence numbers are not reset when the buffer is drained
+@property (nonatomic, readonly) NSUInteger lastSequenceNumber;
+
+/// Returns spilled and in-memory requests, oldest first
+- (nonnull NSArray<SBTMonitoredNetworkRequest *> *)allRequests;
+
+/// Returns spilled and in-memory requests with a sequence number greater than the specified one, oldest first
+- (nonnull NSArray<SBTMonitoredNetworkRequest *> *)requestsSinceSequenceNumber:(NSUInteger)sequenceNumber;
+
+/// Returns the spilled or in-memory request with the specified sequence number, nil if not in the buffer
+- (nullable SBTMonitoredNetworkRequest *)requestWithSequenceNumber:(NSUInteger)sequenceNumber;
+
+/// Returns spilled and in-memory requests, oldest first, and removes them from the buffer
+- (nonnull NSArray<SBTMonitoredNetworkRequest *> *)drainAllRequests;
+
+- (void)removeAllRequests;
+
+/// Changes capacity and overflow policy, applying the overflow policy to requests exceeding the new capacity
+- (void)setCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy;
+
+- (nonnull SBTMonitoredNetworkRequestsStatistics *)statistics;
+
+@end
@@ -0,0 +1,308 @@
+// SBTMonitoredRequestsBuffer.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "SBTMonitoredRequestsBuffer.h"
+
+@interface SBTMonitoredRequestsBuffer()
+
+@property (nonatomic, assign) NSUInteger capacity;
+@property (nonatomic, assign) SBTMonitoredNetworkRequestsOverflowPolicy overflowPolicy;
+@property (nonatomic, strong) NSURL *spillFileURL;
+@property (nonatomic, strong) NSFileHandle *spillFileHandle;
+
+// slots of the ring, when unbounded requests are appended without wrapping
+@property (nonatomic, strong) NSMutableArray<SBTMonitoredNetworkRequest *> *slots;
+@property (nonatomic, assign) NSUInteger head;
+@property (nonatomic, assign) NSUInteger count;
+
+@property (nonatomic, assign) NSUInteger droppedCount;
+@property (nonatomic, assign) NSUInteger spilledCount;
+@property (nonatomic, assign) NSUInteger pendingSpilledCount;
+@property (nonatomic, assign) NSUInteger lastSpilledSequenceNumber;
+
+@property (nonatomic, assign) NSUInteger lastSequenceNumber;
+
+@end
+
+@implementation SBTMonitoredRequestsBuffer
+
++ (NSURL *)defaultSpillFileURL
+{
+    NSString *basePath = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+
+    return [NSURL fileURLWithPath:[basePath stringByAppendingPathComponent:@"SBTUITestTunnel/MonitoredRequests.spill"]];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy spillFileURL:(NSURL *)spillFileURL
+{
+    if (self = [super init]) {
+        self.capacity = capacity;
+        self.overflowPolicy = overflowPolicy;
+        self.spillFileURL = spillFileURL;
+        self.slots = [NSMutableArray array];
+
+        // spilled requests of a previous launch are stale
+        [[NSFileManager defaultManager] removeItemAtURL:spillFileURL error:nil];
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [_spillFileHandle closeFile];
+}
+
+#pragma mark - Ring
+
+- (void)appendRequest:(SBTMonitoredNetworkRequest *)request
+{
+    request.sequenceNumber = ++self.lastSequenceNumber;
+
+    [self storeRequest:request];
+}
+
+- (void)storeRequest:(SBTMonitoredNetworkRequest *)request
+{
+    if (self.capacity == 0) {
+        [self.slots addObject:request];
+        self.count++;
+        return;
+    }
+
+    if (self.count == self.capacity) {
+        [self overflowRequest:[self removeOldestRequest]];
+    }
+
+    NSUInteger tail = (self.head + self.count) % self.capacity;
+    if (tail < self.slots.count) {
+        self.slots[tail] = request;
+    } else {
+        [self.slots addObject:request];
+    }
+    self.count++;
+}
+
+- (SBTMonitoredNetworkRequest *)removeOldestRequest
+{
+    SBTMonitoredNetworkRequest *oldest = self.slots[self.head];
+    // the slot stays occupied to preserve ring indexes, it will be overwritten by the next append
+    self.head = (self.head + 1) % self.capacity;
+    self.count--;
+
+    return oldest;
+}
+
+- (SBTMonitoredNetworkRequest *)inMemoryRequestAtIndex:(NSUInteger)index
+{
+    return self.capacity == 0 ? self.slots[index] : self.slots[(self.head + index) % self.capacity];
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)inMemoryRequests
+{
+    if (self.capacity == 0) {
+        return [self.slots copy];
+    }
+
+    NSMutableArray<SBTMonitoredNetworkRequest *> *requests = [NSMutableArray arrayWithCapacity:self.count];
+    for (NSUInteger i = 0; i < self.count; i++) {
+        [requests addObject:self.slots[(self.head + i) % self.capacity]];
+    }
+
+    return requests;
+}
+
+- (void)setCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy
+{
+    NSArray<SBTMonitoredNetworkRequest *> *requests = [self inMemoryRequests];
+
+    self.overflowPolicy = overflowPolicy;
+    self.capacity = capacity;
+    self.slots = [NSMutableArray array];
+    self.head = 0;
+    self.count = 0;
+
+    for (SBTMonitoredNetworkRequest *request in requests) {
+        [self storeRequest:request];
+    }
+}
+
+#pragma mark - Overflow
+
+- (void)overflowRequest:(SBTMonitoredNetworkRequest *)request
+{
+    if (self.overflowPolicy == SBTMonitoredNetworkRequestsOverflowPolicySpillToDisk && [self spillRequest:request]) {
+        self.spilledCount++;
+        self.pendingSpilledCount++;
+        self.lastSpilledSequenceNumber = request.sequenceNumber;
+    } else {
+        self.droppedCount++;
+    }
+}
+
+/// Appends the request to the spill file as a 4 byte big endian length followed by the archived request
+- (BOOL)spillRequest:(SBTMonitoredNetworkRequest *)request
+{
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:request requiringSecureCoding:YES error:nil];
+    if (data == nil) {
+        return NO;
+    }
+
+    if (self.spillFileHandle == nil) {
+        NSFileManager *fm = [NSFileManager defaultManager];
+        [fm createDirectoryAtURL:[self.spillFileURL URLByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:nil];
+        if (![fm fileExistsAtPath:self.spillFileURL.path] && ![fm createFileAtPath:self.spillFileURL.path contents:nil attributes:nil]) {
+            NSLog(@"[SBTUITestTunnel] Failed to create monitored requests spill file at %@", self.spillFileURL.path);
+            return NO;
+        }
+
+        self.spillFileHandle = [NSFileHandle fileHandleForWritingToURL:self.spillFileURL error:nil];
+        [self.spillFileHandle seekToEndOfFile];
+    }
+
+    uint32_t length = CFSwapInt32HostToBig((uint32_t)data.length);
+    NSMutableData *record = [NSMutableData dataWithBytes:&length length:sizeof(length)];
+    [record appendData:data];
+    [self.spillFileHandle writeData:record];
+
+    return YES;
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)spilledRequests
+{
+    if (self.pendingSpilledCount == 0) {
+        return @[];
+    }
+
+    [self.spillFileHandle synchronizeFile];
+    NSData *content = [NSData dataWithContentsOfURL:self.spillFileURL options:NSDataReadingMappedIfSafe error:nil];
+
+    NSMutableArray<SBTMonitoredNetworkRequest *> *requests = [NSMutableArray arrayWithCapacity:self.pendingSpilledCount];
+    NSUInteger offset = 0;
+    while (offset + sizeof(uint32_t) <= content.length) {
+        uint32_t length = 0;
+        [content getBytes:&length range:NSMakeRange(offset, sizeof(length))];
+        length = CFSwapInt32BigToHost(length);
+        offset += sizeof(length);
+
+        if (offset + length > content.length) {
+            break;
+        }
+
+        NSData *data = [content subdataWithRange:NSMakeRange(offset, length)];
+        SBTMonitoredNetworkRequest *request = [NSKeyedUnarchiver unarchivedObjectOfClass:[SBTMonitoredNetworkRequest class] fromData:data error:nil];
+        if (request != nil) {
+            [requests addObject:request];
+        }
+        offset += length;
+    }
+
+    return requests;
+}
+
+#pragma mark - Access
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)allRequests
+{
+    return [[self spilledRequests] arrayByAddingObjectsFromArray:[self inMemoryRequests]];
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)requestsSinceSequenceNumber:(NSUInteger)sequenceNumber
+{
+    NSMutableArray<SBTMonitoredNetworkRequest *> *requests = [NSMutableArray array];
+
+    if (self.pendingSpilledCount > 0 && self.lastSpilledSequenceNumber > sequenceNumber) {
+        for (SBTMonitoredNetworkRequest *request in [self spilledRequests]) {
+            if (request.sequenceNumber > sequenceNumber) {
+                [requests addObject:request];
+            }
+        }
+    }
+
+    // in-memory requests are sorted by sequence number, walk back from the newest one
+    NSUInteger firstNewIndex = self.count;
+    while (firstNewIndex > 0 && [self inMemoryRequestAtIndex:firstNewIndex - 1].sequenceNumber > sequenceNumber) {
+        firstNewIndex--;
+    }
+    for (NSUInteger i = firstNewIndex; i < self.count; i++) {
+        [requests addObject:[self inMemoryRequestAtIndex:i]];
+    }
+
+    return requests;
+}
+
+- (SBTMonitoredNetworkRequest *)requestWithSequenceNumber:(NSUInteger)sequenceNumber
+{
+    // in-memory requests are sorted by sequence number
+    NSUInteger low = 0;
+    NSUInteger high = self.count;
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        SBTMonitoredNetworkRequest *request = [self inMemoryRequestAtIndex:mid];
+        if (request.sequenceNumber == sequenceNumber) {
+            return request;
+        } else if (request.sequenceNumber < sequenceNumber) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (self.pendingSpilledCount > 0 && sequenceNumber <= self.lastSpilledSequenceNumber) {
+        for (SBTMonitoredNetworkRequest *request in [self spilledRequests]) {
+            if (request.sequenceNumber == sequenceNumber) {
+                return request;
+            }
+        }
+    }
+
+    return nil;
+}
+
+- (NSArray<SBTMonitoredNetworkRequest *> *)drainAllRequests
+{
+    NSArray<SBTMonitoredNetworkRequest *> *requests = [self allRequests];
+    [self removeAllRequests];
+
+    return requests;
+}
+
+- (void)removeAllRequests
+{
+    self.slots = [NSMutableArray array];
+    self.head = 0;
+    self.count = 0;
+
+    if (self.pendingSpilledCount > 0) {
+        [self.spillFileHandle truncateFileAtOffset:0];
+        self.pendingSpilledCount = 0;
+    }
+}
+
+- (SBTMonitoredNetworkRequestsStatistics *)statistics
+{
+    SBTMonitoredNetworkRequestsStatistics *statistics = [[SBTMonitoredNetworkRequestsStatistics alloc] init];
+
+    statistics.capacity = self.capacity;
+    statistics.overflowPolicy = self.overflowPolicy;
+    statistics.count = self.count;
+    statistics.droppedCount = self.droppedCount;
+    statistics.spilledCount = self.spilledCount;
+
+    return statistics;
+}
+
+@end
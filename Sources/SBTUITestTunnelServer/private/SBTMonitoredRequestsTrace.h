@@ -0,0 +1,59 @@
+// SBTMonitoredRequestsTrace.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+@import SBTUITestTunnelCommon;
+
+/// Default size after which the trace moves to a new file
+extern const unsigned long long SBTMonitoredRequestsTraceDefaultMaximumFileSize;
+
+/// Default number of trace files kept, older files are deleted when rotating
+extern const NSUInteger SBTMonitoredRequestsTraceDefaultMaximumFileCount;
+
+/// An append-only trace of monitored requests written to the app container.
+///
+/// Every monitored request is converted to a HAR 1.2 entry and appended as one JSON line (NDJSON) as soon
+/// as it completes, so memory usage doesn't depend on the length of the trace. Entries are written to numbered
+/// files that are rotated by size. Reading the trace returns the lines of all files, oldest first.
+@interface SBTMonitoredRequestsTrace : NSObject
+
+/// Returns the default trace folder in the app container
++ (nonnull NSURL *)defaultDirectoryURL;
+
+/**
+ *  Initializer, removes files of a previous trace stored in the same folder
+ *
+ *  @param directoryURL the folder holding the trace files
+ *  @param maximumFileSize the size after which the trace moves to a new file
+ *  @param maximumFileCount the number of files kept
+ */
+- (nonnull instancetype)initWithDirectoryURL:(nonnull NSURL *)directoryURL
+                             maximumFileSize:(unsigned long long)maximumFileSize
+                            maximumFileCount:(NSUInteger)maximumFileCount;
+
+/// Asynchronously appends the HAR entry of a request
+- (void)appendRequest:(nonnull SBTMonitoredNetworkRequest *)request;
+
+/// Waits for pending appends to be written
+- (void)synchronize;
+
+/// The trace files, oldest first
+- (nonnull NSArray<NSURL *> *)fileURLs;
+
+/// Returns a HAR 1.2 entry describing a monitored request
++ (nonnull NSDictionary *)harEntryForRequest:(nonnull SBTMonitoredNetworkRequest *)request;
+
+@end
@@ -0,0 +1,257 @@
+// SBTMonitoredRequestsTrace.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "SBTMonitoredRequestsTrace.h"
+
+const unsigned long long SBTMonitoredRequestsTraceDefaultMaximumFileSize = 16 * 1024 * 1024;
+const NSUInteger SBTMonitoredRequestsTraceDefaultMaximumFileCount = 4;
+
+static NSString * const SBTMonitoredRequestsTraceFileExtension = @"ndjson";
+
+@interface SBTMonitoredRequestsTrace()
+
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, assign) unsigned long long maximumFileSize;
+@property (nonatomic, assign) NSUInteger maximumFileCount;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSFileHandle *fileHandle;
+@property (nonatomic, assign) NSUInteger fileIndex;
+@property (nonatomic, assign) unsigned long long fileSize;
+
+@end
+
+@implementation SBTMonitoredRequestsTrace
+
++ (NSURL *)defaultDirectoryURL
+{
+    NSString *basePath = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+
+    return [NSURL fileURLWithPath:[basePath stringByAppendingPathComponent:@"SBTUITestTunnel/MonitoredRequestsTrace"] isDirectory:YES];
+}
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL maximumFileSize:(unsigned long long)maximumFileSize maximumFileCount:(NSUInteger)maximumFileCount
+{
+    if ((self = [super init])) {
+        _directoryURL = directoryURL;
+        _maximumFileSize = maximumFileSize > 0 ? maximumFileSize : SBTMonitoredRequestsTraceDefaultMaximumFileSize;
+        _maximumFileCount = MAX(maximumFileCount, 1);
+        _queue = dispatch_queue_create("com.sbtuitesttunnel.monitor.trace", DISPATCH_QUEUE_SERIAL);
+
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        [fileManager removeItemAtURL:directoryURL error:nil];
+        [fileManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [_fileHandle closeFile];
+}
+
+- (NSURL *)fileURLAtIndex:(NSUInteger)index
+{
+    NSString *filename = [NSString stringWithFormat:@"trace-%06lu.%@", (unsigned long)index, SBTMonitoredRequestsTraceFileExtension];
+
+    return [self.directoryURL URLByAppendingPathComponent:filename];
+}
+
+- (void)appendRequest:(SBTMonitoredNetworkRequest *)request
+{
+    dispatch_async(self.queue, ^{
+        NSError *error = nil;
+        NSMutableData *line = [[NSJSONSerialization dataWithJSONObject:[SBTMonitoredRequestsTrace harEntryForRequest:request] options:0 error:&error] mutableCopy];
+        if (line == nil) {
+            NSLog(@"[SBTUITestTunnel] Failed to serialize trace entry for %@: %@", request, error);
+            return;
+        }
+        [line appendBytes:"\n" length:1];
+
+        if (self.fileHandle == nil || (self.fileSize > 0 && self.fileSize + line.length > self.maximumFileSize)) {
+            [self rotate];
+        }
+
+        [self.fileHandle writeData:line];
+        self.fileSize += line.length;
+    });
+}
+
+- (void)rotate
+{
+    [self.fileHandle closeFile];
+
+    self.fileIndex++;
+    NSURL *fileURL = [self fileURLAtIndex:self.fileIndex];
+    [[NSFileManager defaultManager] createFileAtPath:fileURL.path contents:nil attributes:nil];
+    self.fileHandle = [NSFileHandle fileHandleForWritingToURL:fileURL error:nil];
+    self.fileSize = 0;
+
+    if (self.fileIndex > self.maximumFileCount) {
+        [[NSFileManager defaultManager] removeItemAtURL:[self fileURLAtIndex:self.fileIndex - self.maximumFileCount] error:nil];
+    }
+}
+
+- (void)synchronize
+{
+    dispatch_sync(self.queue, ^{
+        [self.fileHandle synchronizeFile];
+    });
+}
+
+- (NSArray<NSURL *> *)fileURLs
+{
+    __block NSArray<NSURL *> *fileURLs = nil;
+    dispatch_sync(self.queue, ^{
+        NSMutableArray<NSURL *> *urls = [NSMutableArray array];
+        NSUInteger firstIndex = self.fileIndex > self.maximumFileCount ? self.fileIndex - self.maximumFileCount + 1 : 1;
+        for (NSUInteger index = firstIndex; index <= self.fileIndex; index++) {
+            [urls addObject:[self fileURLAtIndex:index]];
+        }
+        fileURLs = urls;
+    });
+
+    return fileURLs;
+}
+
+#pragma mark - HAR
+
++ (NSDictionary *)harEntryForRequest:(SBTMonitoredNetworkRequest *)request
+{
+    static NSISO8601DateFormatter *dateFormatter;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dateFormatter = [[NSISO8601DateFormatter alloc] init];
+        dateFormatter.formatOptions = NSISO8601DateFormatWithInternetDateTime | NSISO8601DateFormatWithFractionalSeconds;
+    });
+
+    NSURLRequest *urlRequest = request.originalRequest ?: request.request;
+    NSHTTPURLResponse *response = request.response;
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceReferenceDate:request.timestamp - request.requestTime];
+
+    NSMutableDictionary *harRequest = [@{ @"method": urlRequest.HTTPMethod ?: @"GET",
+                                          @"url": urlRequest.URL.absoluteString ?: @"",
+                                          @"httpVersion": @"HTTP/1.1",
+                                          @"headers": [self harHeaders:urlRequest.allHTTPHeaderFields],
+                                          @"queryString": [self harQueryString:urlRequest.URL],
+                                          @"cookies": @[],
+                                          @"headersSize": @(-1),
+                                          @"bodySize": @(request.requestDataOriginalLength) } mutableCopy];
+    NSData *requestData = request.requestData;
+    if (requestData.length > 0) {
+        NSMutableDictionary *postData = [self harContent:requestData mimeType:[urlRequest valueForHTTPHeaderField:@"Content-Type"]];
+        [postData removeObjectForKey:@"size"];
+        harRequest[@"postData"] = postData;
+    }
+
+    NSMutableDictionary *content = [self harContent:request.responseData mimeType:response.MIMEType];
+    // size is the length of the whole body, which may differ from the captured text when the monitor truncates bodies
+    content[@"size"] = @(request.responseDataOriginalLength);
+
+    NSDictionary *harResponse = @{ @"status": @(response.statusCode),
+                                   @"statusText": [NSHTTPURLResponse localizedStringForStatusCode:response.statusCode] ?: @"",
+                                   @"httpVersion": @"HTTP/1.1",
+                                   @"headers": [self harHeaders:response.allHeaderFields],
+                                   @"cookies": @[],
+                                   @"content": content,
+                                   @"redirectURL": [self headerValueForName:@"Location" inHeaders:response.allHeaderFields] ?: @"",
+                                   @"headersSize": @(-1),
+                                   @"bodySize": @(request.responseDataOriginalLength) };
+
+    SBTMonitoredNetworkRequestTiming *timing = request.timing;
+    NSDictionary *harTimings = nil;
+    if (timing != nil) {
+        harTimings = @{ @"blocked": @(-1),
+                        @"dns": @(timing.domainLookupDuration * 1000.0),
+                        @"connect": @((timing.connectDuration + timing.secureConnectionDuration) * 1000.0),
+                        @"ssl": @(timing.secureConnectionDuration * 1000.0),
+                        @"send": @(timing.requestDuration * 1000.0),
+                        @"wait": @(timing.timeToFirstByte * 1000.0),
+                        @"receive": @(timing.responseDuration * 1000.0) };
+    } else {
+        harTimings = @{ @"send": @0, @"wait": @(request.requestTime * 1000.0), @"receive": @0 };
+    }
+
+    NSMutableDictionary *entry = [@{ @"startedDateTime": [dateFormatter stringFromDate:startDate],
+                                     @"time": @(request.requestTime * 1000.0),
+                                     @"request": harRequest,
+                                     @"response": harResponse,
+                                     @"cache": @{},
+                                     @"timings": harTimings,
+                                     @"_sequenceNumber": @(request.sequenceNumber),
+                                     @"_isStubbed": @(request.isStubbed),
+                                     @"_isRewritten": @(request.isRewritten) } mutableCopy];
+    if (timing.networkProtocolName != nil) {
+        entry[@"_protocol"] = timing.networkProtocolName;
+    }
+    if (request.isRequestDataTruncated || request.isResponseDataTruncated) {
+        entry[@"_bodySampling"] = request.bodySampling == SBTMonitorCaptureSamplingHeadAndTail ? @"headAndTail" : @"head";
+    }
+
+    return entry;
+}
+
+/// Case insensitive header lookup, NSHTTPURLResponse's valueForHTTPHeaderField: requires iOS 13
++ (NSString *)headerValueForName:(NSString *)name inHeaders:(NSDictionary *)headers
+{
+    for (NSString *header in headers) {
+        if ([header caseInsensitiveCompare:name] == NSOrderedSame) {
+            return [headers[header] description];
+        }
+    }
+
+    return nil;
+}
+
++ (NSArray<NSDictionary *> *)harHeaders:(NSDictionary *)headers
+{
+    NSMutableArray<NSDictionary *> *harHeaders = [NSMutableArray arrayWithCapacity:headers.count];
+    [headers enumerateKeysAndObjectsUsingBlock:^(id name, id value, BOOL *stop) {
+        [harHeaders addObject:@{ @"name": [name description], @"value": [value description] }];
+    }];
+
+    return harHeaders;
+}
+
++ (NSArray<NSDictionary *> *)harQueryString:(NSURL *)url
+{
+    NSMutableArray<NSDictionary *> *harQueryString = [NSMutableArray array];
+    for (NSURLQueryItem *item in [NSURLComponents componentsWithURL:url resolvingAgainstBaseURL:NO].queryItems) {
+        [harQueryString addObject:@{ @"name": item.name, @"value": item.value ?: @"" }];
+    }
+
+    return harQueryString;
+}
+
++ (NSMutableDictionary *)harContent:(NSData *)data mimeType:(NSString *)mimeType
+{
+    NSMutableDictionary *content = [@{ @"size": @(data.length), @"mimeType": mimeType ?: @"" } mutableCopy];
+    if (data.length == 0) {
+        return content;
+    }
+
+    NSString *text = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    if (text != nil) {
+        content[@"text"] = text;
+    } else {
+        content[@"text"] = [data base64EncodedStringWithOptions:0];
+        content[@"encoding"] = @"base64";
+    }
+
+    return content;
+}
+
+@end
@@ -0,0 +1,67 @@
+// SBTNetworkCassette.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+@class SBTRequestNormalization;
+@class SBTStubResponse;
+
+/// A recording of network exchanges stored in the app container.
+///
+/// A cassette is a folder containing an `entries.ndjson` file, where every recorded exchange is appended as
+/// one JSON line, and a `bodies` folder where request and response bodies are stored by their SHA-256 digest
+/// so that identical payloads are written only once. Entries are indexed by their normalized request key
+/// so that replaying a request is a dictionary lookup. When the same request was recorded multiple times
+/// responses are replayed in recording order, the last one being repeated once exhausted.
+@interface SBTNetworkCassette : NSObject
+
+@property (nonnull, nonatomic, readonly) NSURL *directoryURL;
+@property (nonnull, nonatomic, readonly) SBTRequestNormalization *normalization;
+
+/// The number of recorded exchanges
+@property (nonatomic, readonly) NSUInteger count;
+
+/// Returns the folder in the app container holding the cassette with the specified name
++ (nonnull NSURL *)directoryURLForCassetteNamed:(nonnull NSString *)name;
+
+/**
+ *  Opens (creating it if needed) the cassette stored in a folder, indexing existing entries
+ *
+ *  @param directoryURL the folder of the cassette
+ *  @param normalization how requests are reduced to lookup keys
+ */
+- (nullable instancetype)initWithDirectoryURL:(nonnull NSURL *)directoryURL normalization:(nonnull SBTRequestNormalization *)normalization;
+
+/// Appends an exchange to the cassette
+- (void)recordRequest:(nonnull NSURLRequest *)request
+                 body:(nullable NSData *)body
+             response:(nonnull NSHTTPURLResponse *)response
+         responseData:(nullable NSData *)responseData
+         responseTime:(NSTimeInterval)responseTime;
+
+/// Returns the recorded response of a request, nil if the request wasn't recorded
+- (nullable SBTStubResponse *)responseForRequest:(nonnull NSURLRequest *)request body:(nullable NSData *)body;
+
+/// Removes all entries and bodies of the cassette
+- (BOOL)eraseWithError:(NSError * _Nullable * _Nullable)error;
+
+/// Serializes the cassette stored in a folder into a single binary property list, suitable to be sent through the tunnel in one go
++ (nullable NSData *)archivedCassetteAtDirectoryURL:(nonnull NSURL *)directoryURL;
+
+/// Replaces the content of a cassette folder with a cassette previously serialized with `archivedCassetteAtDirectoryURL:`
++ (BOOL)unarchiveCassette:(nonnull NSData *)archive toDirectoryURL:(nonnull NSURL *)directoryURL;
+
+@end
@@ -0,0 +1,330 @@
+// SBTNetworkCassette.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import SBTUITestTunnelCommon;
+
+#import "SBTNetworkCassette.h"
+
+static NSString * const SBTNetworkCassetteEntriesFilename = @"entries.ndjson";
+static NSString * const SBTNetworkCassetteBodiesFolder = @"bodies";
+
+static NSString * const SBTNetworkCassetteMethodKey = @"method";
+static NSString * const SBTNetworkCassetteURLKey = @"url";
+static NSString * const SBTNetworkCassetteRequestHeadersKey = @"requestHeaders";
+static NSString * const SBTNetworkCassetteRequestBodyKey = @"requestBody";
+static NSString * const SBTNetworkCassetteStatusKey = @"status";
+static NSString * const SBTNetworkCassetteResponseHeadersKey = @"headers";
+static NSString * const SBTNetworkCassetteResponseBodyKey = @"body";
+static NSString * const SBTNetworkCassetteResponseTimeKey = @"time";
+
+static NSString * const SBTNetworkCassetteArchiveEntriesKey = @"entries";
+static NSString * const SBTNetworkCassetteArchiveBodiesKey = @"bodies";
+
+@interface SBTNetworkCassette()
+
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) SBTRequestNormalization *normalization;
+@property (nonatomic, strong) NSFileHandle *entriesFileHandle;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<NSDictionary *> *> *entriesByKey;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *replayCursors;
+@property (nonatomic, assign) NSUInteger count;
+
+@end
+
+@implementation SBTNetworkCassette
+
++ (NSURL *)directoryURLForCassetteNamed:(NSString *)name
+{
+    NSString *basePath = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+    NSString *path = [[basePath stringByAppendingPathComponent:@"SBTUITestTunnel/Cassettes"] stringByAppendingPathComponent:name.lastPathComponent];
+
+    return [NSURL fileURLWithPath:path isDirectory:YES];
+}
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL normalization:(SBTRequestNormalization *)normalization
+{
+    if (self = [super init]) {
+        self.directoryURL = directoryURL;
+        self.normalization = normalization;
+        self.entriesByKey = [NSMutableDictionary dictionary];
+        self.replayCursors = [NSMutableDictionary dictionary];
+
+        NSFileManager *fm = [NSFileManager defaultManager];
+        NSError *error = nil;
+        if (![fm createDirectoryAtURL:[directoryURL URLByAppendingPathComponent:SBTNetworkCassetteBodiesFolder] withIntermediateDirectories:YES attributes:nil error:&error]) {
+            NSLog(@"[SBTUITestTunnel] Failed to create cassette at %@, %@", directoryURL.path, error);
+            return nil;
+        }
+
+        NSURL *entriesURL = [directoryURL URLByAppendingPathComponent:SBTNetworkCassetteEntriesFilename];
+        if (![fm fileExistsAtPath:entriesURL.path]) {
+            [fm createFileAtPath:entriesURL.path contents:nil attributes:nil];
+        }
+
+        [self indexEntriesAtURL:entriesURL];
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [_entriesFileHandle closeFile];
+}
+
+- (void)indexEntriesAtURL:(NSURL *)entriesURL
+{
+    NSString *content = [NSString stringWithContentsOfURL:entriesURL encoding:NSUTF8StringEncoding error:nil];
+
+    [content enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+        NSData *lineData = [line dataUsingEncoding:NSUTF8StringEncoding];
+        if (lineData.length == 0) {
+            return;
+        }
+
+        NSDictionary *entry = [NSJSONSerialization JSONObjectWithData:lineData options:0 error:nil];
+        if ([entry isKindOfClass:[NSDictionary class]]) {
+            [self indexEntry:entry];
+        }
+    }];
+}
+
+- (void)indexEntry:(NSDictionary *)entry
+{
+    NSURL *url = [NSURL URLWithString:entry[SBTNetworkCassetteURLKey]];
+    if (url == nil) {
+        return;
+    }
+
+    NSString *key = [self.normalization keyForMethod:entry[SBTNetworkCassetteMethodKey]
+                                                 url:url
+                                             headers:entry[SBTNetworkCassetteRequestHeadersKey]
+                                          bodyDigest:entry[SBTNetworkCassetteRequestBodyKey]];
+
+    NSMutableArray<NSDictionary *> *entries = self.entriesByKey[key];
+    if (entries == nil) {
+        entries = [NSMutableArray array];
+        self.entriesByKey[key] = entries;
+    }
+
+    [entries addObject:entry];
+    self.count++;
+}
+
+#pragma mark - Recording
+
+- (void)recordRequest:(NSURLRequest *)request body:(NSData *)body response:(NSHTTPURLResponse *)response responseData:(NSData *)responseData responseTime:(NSTimeInterval)responseTime
+{
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary dictionary];
+    [response.allHeaderFields enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        // the URL loading system already decoded the payload, recorded bodies are stored as received by the app
+        if ([key caseInsensitiveCompare:@"Content-Encoding"] != NSOrderedSame &&
+            [key caseInsensitiveCompare:@"Transfer-Encoding"] != NSOrderedSame &&
+            [key caseInsensitiveCompare:@"Content-Length"] != NSOrderedSame) {
+            headers[key] = value;
+        }
+    }];
+    headers[@"Content-Length"] = [@(responseData.length) stringValue];
+
+    NSMutableDictionary *entry = [NSMutableDictionary dictionary];
+    entry[SBTNetworkCassetteMethodKey] = request.HTTPMethod ?: @"GET";
+    entry[SBTNetworkCassetteURLKey] = request.URL.absoluteString;
+    entry[SBTNetworkCassetteRequestHeadersKey] = request.allHTTPHeaderFields ?: @{};
+    entry[SBTNetworkCassetteStatusKey] = @(response.statusCode);
+    entry[SBTNetworkCassetteResponseHeadersKey] = headers;
+    entry[SBTNetworkCassetteResponseTimeKey] = @(responseTime);
+
+    @synchronized (self) {
+        entry[SBTNetworkCassetteRequestBodyKey] = [self storeBody:body];
+        entry[SBTNetworkCassetteResponseBodyKey] = [self storeBody:responseData];
+
+        NSMutableData *line = [[NSJSONSerialization dataWithJSONObject:entry options:0 error:nil] mutableCopy];
+        if (line == nil) {
+            NSLog(@"[SBTUITestTunnel] Failed to serialize cassette entry for %@", request.URL);
+            return;
+        }
+        [line appendBytes:"\n" length:1];
+
+        if (self.entriesFileHandle == nil) {
+            NSURL *entriesURL = [self.directoryURL URLByAppendingPathComponent:SBTNetworkCassetteEntriesFilename];
+            self.entriesFileHandle = [NSFileHandle fileHandleForWritingToURL:entriesURL error:nil];
+            [self.entriesFileHandle seekToEndOfFile];
+        }
+        [self.entriesFileHandle writeData:line];
+
+        [self indexEntry:entry];
+    }
+}
+
+/// Writes a body to the cassette using its digest as filename, returns the digest
+- (NSString *)storeBody:(NSData *)body
+{
+    if (body.length == 0) {
+        return nil;
+    }
+
+    NSString *digest = [SBTRequestNormalization digestOfData:body];
+    NSURL *bodyURL = [[self.directoryURL URLByAppendingPathComponent:SBTNetworkCassetteBodiesFolder] URLByAppendingPathComponent:digest];
+
+    if (![[NSFileManager defaultManager] fileExistsAtPath:bodyURL.path]) {
+        [body writeToURL:bodyURL atomically:YES];
+    }
+
+    return digest;
+}
+
+#pragma mark - Replaying
+
+- (SBTStubResponse *)responseForRequest:(NSURLRequest *)request body:(NSData *)body
+{
+    NSString *key = [self.normalization keyForRequest:request body:body];
+
+    NSDictionary *entry = nil;
+    @synchronized (self) {
+        NSArray<NSDictionary *> *entries = self.entriesByKey[key];
+        if (entries.count == 0) {
+            return nil;
+        }
+
+        NSUInteger cursor = [self.replayCursors[key] unsignedIntegerValue];
+        entry = entries[MIN(cursor, entries.count - 1)];
+        self.replayCursors[key] = @(cursor + 1);
+    }
+
+    NSData *responseData = [NSData data];
+    NSString *responseBodyDigest = entry[SBTNetworkCassetteResponseBodyKey];
+    if (responseBodyDigest.length > 0) {
+        NSURL *bodyURL = [[self.directoryURL URLByAppendingPathComponent:SBTNetworkCassetteBodiesFolder] URLByAppendingPathComponent:responseBodyDigest];
+        responseData = [NSData dataWithContentsOfURL:bodyURL options:NSDataReadingMappedIfSafe error:nil];
+
+        if (responseData == nil) {
+            NSLog(@"[SBTUITestTunnel] Cassette body %@ missing for %@", responseBodyDigest, request.URL);
+            return nil;
+        }
+    }
+
+    NSDictionary<NSString *, NSString *> *headers = entry[SBTNetworkCassetteResponseHeadersKey];
+    NSString *contentType = nil;
+    for (NSString *header in headers) {
+        if ([header caseInsensitiveCompare:@"Content-Type"] == NSOrderedSame) {
+            contentType = headers[header];
+        }
+    }
+
+    return [[SBTStubResponse alloc] initWithResponse:responseData
+                                             headers:headers
+                                         contentType:contentType
+                                          returnCode:[entry[SBTNetworkCassetteStatusKey] integerValue]
+                                        responseTime:0.0
+                                    activeIterations:0];
+}
+
+- (BOOL)eraseWithError:(NSError **)error
+{
+    @synchronized (self) {
+        [self.entriesFileHandle closeFile];
+        self.entriesFileHandle = nil;
+
+        [self.entriesByKey removeAllObjects];
+        [self.replayCursors removeAllObjects];
+        self.count = 0;
+
+        NSFileManager *fm = [NSFileManager defaultManager];
+        NSURL *bodiesURL = [self.directoryURL URLByAppendingPathComponent:SBTNetworkCassetteBodiesFolder];
+        if (![fm removeItemAtURL:self.directoryURL error:error] ||
+            ![fm createDirectoryAtURL:bodiesURL withIntermediateDirectories:YES attributes:nil error:error]) {
+            return NO;
+        }
+
+        return [fm createFileAtPath:[self.directoryURL URLByAppendingPathComponent:SBTNetworkCassetteEntriesFilename].path contents:nil attributes:nil];
+    }
+}
+
+#pragma mark - Archiving
+
++ (NSData *)archivedCassetteAtDirectoryURL:(NSURL *)directoryURL
+{
+    NSURL *entriesURL = [directoryURL URLByAppendingPathComponent:SBTNetworkCassetteEntriesFilename];
+    NSString *content = [NSString stringWithContentsOfURL:entriesURL encoding:NSUTF8StringEncoding error:nil];
+    if (content == nil) {
+        return nil;
+    }
+
+    NSMutableArray<NSDictionary *> *entries = [NSMutableArray array];
+    NSMutableDictionary<NSString *, NSData *> *bodies = [NSMutableDictionary dictionary];
+    NSURL *bodiesURL = [directoryURL URLByAppendingPathComponent:SBTNetworkCassetteBodiesFolder];
+
+    [content enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+        NSData *lineData = [line dataUsingEncoding:NSUTF8StringEncoding];
+        NSDictionary *entry = lineData.length > 0 ? [NSJSONSerialization JSONObjectWithData:lineData options:0 error:nil] : nil;
+        if (![entry isKindOfClass:[NSDictionary class]]) {
+            return;
+        }
+
+        [entries addObject:entry];
+        for (NSString *digest in @[entry[SBTNetworkCassetteRequestBodyKey] ?: @"", entry[SBTNetworkCassetteResponseBodyKey] ?: @""]) {
+            if (digest.length > 0 && bodies[digest] == nil) {
+                NSData *body = [NSData dataWithContentsOfURL:[bodiesURL URLByAppendingPathComponent:digest] options:NSDataReadingMappedIfSafe error:nil];
+                if (body != nil) {
+                    bodies[digest] = body;
+                }
+            }
+        }
+    }];
+
+    NSDictionary *archive = @{ SBTNetworkCassetteArchiveEntriesKey: entries, SBTNetworkCassetteArchiveBodiesKey: bodies };
+
+    return [NSPropertyListSerialization dataWithPropertyList:archive format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+}
+
++ (BOOL)unarchiveCassette:(NSData *)archive toDirectoryURL:(NSURL *)directoryURL
+{
+    NSDictionary *cassette = [NSPropertyListSerialization propertyListWithData:archive options:NSPropertyListImmutable format:nil error:nil];
+    NSArray<NSDictionary *> *entries = cassette[SBTNetworkCassetteArchiveEntriesKey];
+    NSDictionary<NSString *, NSData *> *bodies = cassette[SBTNetworkCassetteArchiveBodiesKey];
+
+    if (![entries isKindOfClass:[NSArray class]] || ![bodies isKindOfClass:[NSDictionary class]]) {
+        NSLog(@"[SBTUITestTunnel] Invalid cassette archive");
+        return NO;
+    }
+
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSURL *bodiesURL = [directoryURL URLByAppendingPathComponent:SBTNetworkCassetteBodiesFolder];
+
+    [fm removeItemAtURL:directoryURL error:nil];
+    if (![fm createDirectoryAtURL:bodiesURL withIntermediateDirectories:YES attributes:nil error:nil]) {
+        return NO;
+    }
+
+    for (NSString *digest in bodies) {
+        if (![bodies[digest] writeToURL:[bodiesURL URLByAppendingPathComponent:digest.lastPathComponent] atomically:NO]) {
+            return NO;
+        }
+    }
+
+    NSMutableData *entriesData = [NSMutableData data];
+    for (NSDictionary *entry in entries) {
+        NSData *line = [NSJSONSerialization dataWithJSONObject:entry options:0 error:nil];
+        if (line != nil) {
+            [entriesData appendData:line];
+            [entriesData appendBytes:"\n" length:1];
+        }
+    }
+
+    return [entriesData writeToURL:[directoryURL URLByAppendingPathComponent:SBTNetworkCassetteEntriesFilename] atomically:YES];
+}
+
+@end
@@ -0,0 +1,44 @@
+// SBTNetworkStatisticsAggregator.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+@import SBTUITestTunnelCommon;
+
+/// Maximum number of endpoints tracked separately, further endpoints are accounted under a single `*` host
+extern const NSUInteger SBTNetworkStatisticsAggregatorMaximumEndpoints;
+
+/// Aggregates counters, transferred bytes and latency histograms of network requests per host and path template.
+///
+/// Memory usage is bounded: every endpoint uses a fixed size log-linear histogram and the number of endpoints is capped.
+/// Only lengths of request and response bodies are recorded. The aggregator is thread safe.
+@interface SBTNetworkStatisticsAggregator : NSObject
+
+/// Returns the path with identifiers (numbers, UUIDs and long hex strings) replaced by `{id}`
++ (nonnull NSString *)pathTemplateForPath:(nullable NSString *)path;
+
+- (void)recordRequest:(nonnull NSURLRequest *)request
+             response:(nullable NSURLResponse *)response
+                error:(nullable NSError *)error
+              latency:(NSTimeInterval)latency
+            bytesSent:(int64_t)bytesSent
+        bytesReceived:(int64_t)bytesReceived;
+
+/// Returns the statistics of every endpoint, sorted by descending request count
+- (nonnull NSArray<SBTNetworkEndpointStatistics *> *)allStatistics;
+
+- (void)reset;
+
+@end
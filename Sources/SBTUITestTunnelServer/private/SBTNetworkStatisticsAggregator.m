@@ -0,0 +1,216 @@
+// SBTNetworkStatisticsAggregator.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "SBTNetworkStatisticsAggregator.h"
+
+const NSUInteger SBTNetworkStatisticsAggregatorMaximumEndpoints = 256;
+
+// Latencies are recorded in microseconds in a log-linear histogram, HDR histogram style: values below 16 have
+// their own bucket, larger values are grouped by power of two, each power being split in 16 linear sub-buckets.
+// This bounds the relative error to 1/16 up to 2^36 microseconds (about 19 hours), with a fixed 2KB per endpoint.
+static const NSUInteger SBTHistogramSubBucketBits = 4;
+static const NSUInteger SBTHistogramSubBucketCount = 1 << SBTHistogramSubBucketBits;
+static const NSUInteger SBTHistogramMaximumExponent = 35;
+static const NSUInteger SBTHistogramBucketCount = (SBTHistogramMaximumExponent - SBTHistogramSubBucketBits + 2) * SBTHistogramSubBucketCount;
+
+static NSUInteger SBTHistogramBucketIndex(uint64_t value)
+{
+    if (value < SBTHistogramSubBucketCount) {
+        return (NSUInteger)value;
+    }
+
+    NSUInteger exponent = MIN((NSUInteger)(63 - __builtin_clzll(value)), SBTHistogramMaximumExponent);
+    NSUInteger subBucket = (NSUInteger)(MIN(value >> (exponent - SBTHistogramSubBucketBits), 2 * SBTHistogramSubBucketCount - 1) - SBTHistogramSubBucketCount);
+
+    return (exponent - SBTHistogramSubBucketBits + 1) * SBTHistogramSubBucketCount + subBucket;
+}
+
+static uint64_t SBTHistogramBucketMidpoint(NSUInteger index)
+{
+    if (index < SBTHistogramSubBucketCount) {
+        return index;
+    }
+
+    NSUInteger shift = index / SBTHistogramSubBucketCount - 1;
+    uint64_t lowerBound = (uint64_t)(SBTHistogramSubBucketCount + index % SBTHistogramSubBucketCount) << shift;
+
+    return lowerBound + ((1ull << shift) >> 1);
+}
+
+@interface SBTNetworkEndpointAccumulator : NSObject {
+@public
+    uint32_t histogram[SBTHistogramBucketCount];
+}
+
+@property (nonatomic, copy) NSString *host;
+@property (nonatomic, copy) NSString *pathTemplate;
+@property (nonatomic, assign) NSUInteger requestCount;
+@property (nonatomic, assign) NSUInteger failureCount;
+@property (nonatomic, assign) int64_t bytesSent;
+@property (nonatomic, assign) int64_t bytesReceived;
+@property (nonatomic, assign) uint64_t totalLatency;
+@property (nonatomic, assign) uint64_t maximumLatency;
+
+@end
+
+@implementation SBTNetworkEndpointAccumulator
+
+- (NSTimeInterval)latencyAtPercentile:(double)percentile
+{
+    uint64_t target = (uint64_t)ceil(self.requestCount * percentile);
+    uint64_t cumulative = 0;
+    for (NSUInteger i = 0; i < SBTHistogramBucketCount; i++) {
+        cumulative += histogram[i];
+        if (cumulative >= MAX(target, 1ull)) {
+            return MIN(SBTHistogramBucketMidpoint(i), self.maximumLatency) / 1e6;
+        }
+    }
+
+    return self.maximumLatency / 1e6;
+}
+
+- (SBTNetworkEndpointStatistics *)statistics
+{
+    SBTNetworkEndpointStatistics *statistics = [[SBTNetworkEndpointStatistics alloc] init];
+
+    statistics.host = self.host;
+    statistics.pathTemplate = self.pathTemplate;
+    statistics.requestCount = self.requestCount;
+    statistics.failureCount = self.failureCount;
+    statistics.bytesSent = self.bytesSent;
+    statistics.bytesReceived = self.bytesReceived;
+    statistics.meanLatency = self.requestCount > 0 ? (self.totalLatency / 1e6) / self.requestCount : 0.0;
+    statistics.p50Latency = [self latencyAtPercentile:0.50];
+    statistics.p90Latency = [self latencyAtPercentile:0.90];
+    statistics.p99Latency = [self latencyAtPercentile:0.99];
+    statistics.maximumLatency = self.maximumLatency / 1e6;
+
+    return statistics;
+}
+
+@end
+
+@interface SBTNetworkStatisticsAggregator()
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, SBTNetworkEndpointAccumulator *> *accumulators;
+
+@end
+
+@implementation SBTNetworkStatisticsAggregator
+
+- (instancetype)init
+{
+    if ((self = [super init])) {
+        _accumulators = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (NSString *)pathTemplateForPath:(NSString *)path
+{
+    if (path.length == 0) {
+        return @"/";
+    }
+
+    static NSRegularExpression *identifierRegex;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        identifierRegex = [NSRegularExpression regularExpressionWithPattern:@"^([0-9]+|[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}|[0-9a-fA-F]{16,})$" options:0 error:nil];
+    });
+
+    NSMutableArray<NSString *> *components = [[path componentsSeparatedByString:@"/"] mutableCopy];
+    for (NSUInteger i = 0; i < components.count; i++) {
+        NSString *component = components[i];
+        if ([identifierRegex numberOfMatchesInString:component options:0 range:NSMakeRange(0, component.length)] > 0) {
+            components[i] = @"{id}";
+        }
+    }
+
+    return [components componentsJoinedByString:@"/"];
+}
+
+- (void)recordRequest:(NSURLRequest *)request
+             response:(NSURLResponse *)response
+                error:(NSError *)error
+              latency:(NSTimeInterval)latency
+            bytesSent:(int64_t)bytesSent
+        bytesReceived:(int64_t)bytesReceived
+{
+    NSString *host = request.URL.host ?: @"";
+    NSString *pathTemplate = [SBTNetworkStatisticsAggregator pathTemplateForPath:request.URL.path];
+    uint64_t latencyMicroseconds = (uint64_t)(MAX(0.0, latency) * 1e6);
+
+    BOOL failed = (error != nil);
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        failed = failed || ((NSHTTPURLResponse *)response).statusCode >= 400;
+    }
+
+    @synchronized (self) {
+        NSString *key = [host stringByAppendingString:pathTemplate];
+        SBTNetworkEndpointAccumulator *accumulator = self.accumulators[key];
+        if (accumulator == nil) {
+            if (self.accumulators.count >= SBTNetworkStatisticsAggregatorMaximumEndpoints - 1) {
+                // keep memory bounded when paths contain identifiers that aren't recognized
+                host = @"*";
+                pathTemplate = @"*";
+                key = @"**";
+                accumulator = self.accumulators[key];
+            }
+
+            if (accumulator == nil) {
+                accumulator = [[SBTNetworkEndpointAccumulator alloc] init];
+                accumulator.host = host;
+                accumulator.pathTemplate = pathTemplate;
+                self.accumulators[key] = accumulator;
+            }
+        }
+
+        accumulator.requestCount++;
+        accumulator.failureCount += failed ? 1 : 0;
+        accumulator.bytesSent += MAX(0, bytesSent);
+        accumulator.bytesReceived += MAX(0, bytesReceived);
+        accumulator.totalLatency += latencyMicroseconds;
+        accumulator.maximumLatency = MAX(accumulator.maximumLatency, latencyMicroseconds);
+        accumulator->histogram[SBTHistogramBucketIndex(latencyMicroseconds)]++;
+    }
+}
+
+- (NSArray<SBTNetworkEndpointStatistics *> *)allStatistics
+{
+    NSMutableArray<SBTNetworkEndpointStatistics *> *statistics = [NSMutableArray array];
+
+    @synchronized (self) {
+        for (SBTNetworkEndpointAccumulator *accumulator in self.accumulators.allValues) {
+            [statistics addObject:[accumulator statistics]];
+        }
+    }
+
+    [statistics sortUsingComparator:^NSComparisonResult(SBTNetworkEndpointStatistics *lhs, SBTNetworkEndpointStatistics *rhs) {
+        return lhs.requestCount > rhs.requestCount ? NSOrderedAscending : (lhs.requestCount < rhs.requestCount ? NSOrderedDescending : NSOrderedSame);
+    }];
+
+    return statistics;
+}
+
+- (void)reset
+{
+    @synchronized (self) {
+        [self.accumulators removeAllObjects];
+    }
+}
+
+@end
@@ -0,0 +1,44 @@
+// SBTOriginalRequestTable.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+
+/// An in-memory table of the original requests of redirect chains.
+///
+/// Redirected requests only carry a short token (a plist-safe NSURLProtocol property) that
+/// points to the original request. This avoids archiving the whole request, body included,
+/// on every hop. Proxy instances loading a request retain its token while in flight. Tokens
+/// that are no longer retained are kept for a bounded number of insertions, so that a
+/// redirected request that was not started yet can still find its original request.
+@interface SBTOriginalRequestTable : NSObject
+
++ (nonnull instancetype)sharedTable;
+
+- (nonnull instancetype)initWithUnreferencedCapacity:(NSUInteger)unreferencedCapacity;
+
+/// Adds a request to the table, returns the token to associate with redirected requests
+- (nonnull NSString *)insertRequest:(nonnull NSURLRequest *)request;
+
+/// Returns the request associated to a token, nil if the token was evicted
+- (nullable NSURLRequest *)requestForToken:(nonnull NSString *)token;
+
+- (void)retainToken:(nonnull NSString *)token;
+- (void)releaseToken:(nonnull NSString *)token;
+
+/// The number of requests in the table
+@property (nonatomic, readonly) NSUInteger count;
+
+@end
@@ -0,0 +1,123 @@
+// SBTOriginalRequestTable.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "SBTOriginalRequestTable.h"
+
+static const NSUInteger SBTOriginalRequestTableDefaultUnreferencedCapacity = 64;
+
+@interface SBTOriginalRequestTable()
+
+@property (nonatomic, assign) NSUInteger unreferencedCapacity;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSURLRequest *> *requests;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *referenceCounts;
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *unreferencedTokens;
+
+@end
+
+@implementation SBTOriginalRequestTable
+
++ (instancetype)sharedTable
+{
+    static dispatch_once_t once;
+    static SBTOriginalRequestTable *sharedTable;
+    dispatch_once(&once, ^{
+        sharedTable = [[SBTOriginalRequestTable alloc] initWithUnreferencedCapacity:SBTOriginalRequestTableDefaultUnreferencedCapacity];
+    });
+    return sharedTable;
+}
+
+- (instancetype)initWithUnreferencedCapacity:(NSUInteger)unreferencedCapacity
+{
+    if (self = [super init]) {
+        self.unreferencedCapacity = unreferencedCapacity;
+        self.requests = [NSMutableDictionary dictionary];
+        self.referenceCounts = [NSMutableDictionary dictionary];
+        self.unreferencedTokens = [NSMutableOrderedSet orderedSet];
+    }
+
+    return self;
+}
+
+- (NSString *)insertRequest:(NSURLRequest *)request
+{
+    NSString *token = [[NSUUID UUID] UUIDString];
+
+    @synchronized (self) {
+        self.requests[token] = [request copy];
+        [self markUnreferenced:token];
+    }
+
+    return token;
+}
+
+- (NSURLRequest *)requestForToken:(NSString *)token
+{
+    @synchronized (self) {
+        return self.requests[token];
+    }
+}
+
+- (void)retainToken:(NSString *)token
+{
+    @synchronized (self) {
+        if (self.requests[token] == nil) {
+            return;
+        }
+
+        self.referenceCounts[token] = @([self.referenceCounts[token] unsignedIntegerValue] + 1);
+        [self.unreferencedTokens removeObject:token];
+    }
+}
+
+- (void)releaseToken:(NSString *)token
+{
+    @synchronized (self) {
+        NSUInteger referenceCount = [self.referenceCounts[token] unsignedIntegerValue];
+        if (referenceCount == 0) {
+            return;
+        }
+
+        if (referenceCount > 1) {
+            self.referenceCounts[token] = @(referenceCount - 1);
+        } else {
+            [self.referenceCounts removeObjectForKey:token];
+            // following hops of the redirect chain may still need it
+            [self markUnreferenced:token];
+        }
+    }
+}
+
+- (NSUInteger)count
+{
+    @synchronized (self) {
+        return self.requests.count;
+    }
+}
+
+/// Must be called while synchronized
+- (void)markUnreferenced:(NSString *)token
+{
+    [self.unreferencedTokens removeObject:token];
+    [self.unreferencedTokens addObject:token];
+
+    while (self.unreferencedTokens.count > self.unreferencedCapacity) {
+        NSString *evictedToken = self.unreferencedTokens.firstObject;
+        [self.unreferencedTokens removeObjectAtIndex:0];
+        [self.requests removeObjectForKey:evictedToken];
+    }
+}
+
+@end
@@ -15,12 +15,19 @@
 // limitations under the License.
 
 @import Foundation;
+@import SBTUITestTunnelCommon;
 
 @class SBTRewrite;
 @class SBTRequestMatch;
 @class SBTStubResponse;
 @class SBTMonitoredNetworkRequest;
 @class SBTActiveStub;
+@class SBTNetworkCassette;
+@class SBTHARStubTable;
+@class SBTHTTPCache;
+@class SBTMonitoredNetworkRequestsStatistics;
+@class SBTNetworkStatisticsAggregator;
+@class SBTMonitoredRequestsTrace;
 
 @interface SBTProxyURLProtocol : NSURLProtocol
 
@@ -35,10 +42,28 @@
 #pragma mark - Monitored Requests
 
 + (nullable NSString *)monitorRequestsMatching:(nonnull SBTRequestMatch *)match;
++ (nullable NSString *)monitorRequestsMatching:(nonnull SBTRequestMatch *)match capturePolicy:(nullable SBTMonitorCapturePolicy *)capturePolicy;
 + (BOOL)monitorRequestsRemoveWithId:(nonnull NSString *)reqId;
 + (void)monitorRequestsRemoveAll;
 + (nullable NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsAll;
 + (void)monitoredRequestsFlushAll;
++ (nonnull NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsDrainAll;
++ (nonnull NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsSinceSequenceNumber:(NSUInteger)sequenceNumber;
+/// Blocks until `iterations` monitored requests match or the timeout expires. With 0 iterations returns immediately, `YES` if no request matches
++ (BOOL)monitoredRequestsWaitForRequestsMatching:(nonnull SBTRequestMatch *)match iterations:(NSUInteger)iterations timeout:(NSTimeInterval)timeout;
+/// Like `monitoredRequestsWaitForRequestsMatching:iterations:timeout:` without blocking, the completion is invoked on a background queue
++ (void)monitoredRequestsWaitForRequestsMatching:(nonnull SBTRequestMatch *)match iterations:(NSUInteger)iterations timeout:(NSTimeInterval)timeout completion:(nonnull void (^)(BOOL matched))completion;
++ (void)monitoredRequestsSetCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy;
++ (nonnull SBTMonitoredNetworkRequestsStatistics *)monitoredRequestsStatistics;
+/// Returns a collected request, or a recently flushed one previously passed to `monitoredRequestsKeepFlushedRequests:`
++ (nullable SBTMonitoredNetworkRequest *)monitoredRequestWithSequenceNumber:(NSUInteger)sequenceNumber;
+/// Keeps flushed requests around for a while so that their bodies can still be retrieved by sequence number
++ (void)monitoredRequestsKeepFlushedRequests:(nonnull NSArray<SBTMonitoredNetworkRequest *> *)requests;
+/// Sets a block invoked every time a monitored request completes, in sequence number order. The block runs while monitored requests are locked and must not access them
++ (void)monitoredRequestsSetObserver:(nullable void (^)(SBTMonitoredNetworkRequest * _Nonnull request))observer;
+/// Sets the trace where monitored requests are appended as they complete, nil to stop tracing
++ (void)monitoredRequestsSetTrace:(nullable SBTMonitoredRequestsTrace *)trace;
++ (nullable SBTMonitoredRequestsTrace *)monitoredRequestsTrace;
 
 #pragma mark - Stubbing Requests
 
@@ -47,6 +72,7 @@
 + (BOOL)stubRequestsRemoveWithRequestMatch:(nonnull SBTRequestMatch *)match;
 + (void)stubRequestsRemoveAll;
 + (nonnull NSArray<SBTActiveStub *> *)stubRequestsAll;
++ (nonnull NSString *)stubRequestsWithHARTable:(nonnull SBTHARStubTable *)harTable;
 
 #pragma mark - Rewrite Requests
 
@@ -60,4 +86,20 @@
 + (BOOL)cookieBlockRequestsRemoveWithId:(nonnull NSString *)reqId;
 + (void)cookieBlockRequestsRemoveAll;
 
+#pragma mark - Cassettes
+
++ (void)cassetteStartRecording:(nonnull SBTNetworkCassette *)cassette;
++ (void)cassetteStartReplaying:(nonnull SBTNetworkCassette *)cassette;
++ (void)cassetteStop;
+
+#pragma mark - HTTP Cache
+
++ (void)httpCacheSetEnabled:(BOOL)enabled;
++ (nonnull SBTHTTPCache *)httpCache;
+
+#pragma mark - Network Statistics
+
+/// Counters and latency histograms of every request going through the proxy, including stubbed ones
++ (nonnull SBTNetworkStatisticsAggregator *)networkStatistics;
+
 @end
@@ -17,6 +17,13 @@
 @import SBTUITestTunnelCommon;
 
 #import "SBTProxyURLProtocol.h"
+#import "SBTNetworkCassette.h"
+#import "SBTHARStubTable.h"
+#import "SBTHTTPCache.h"
+#import "SBTOriginalRequestTable.h"
+#import "SBTMonitoredRequestsBuffer.h"
+#import "SBTNetworkStatisticsAggregator.h"
+#import "SBTMonitoredRequestsTrace.h"
 
 static NSString * const SBTProxyURLOriginalRequestKey = @"SBTProxyURLOriginalRequestKey";
 static NSString * const SBTProxyURLProtocolHandledKey = @"SBTProxyURLProtocolHandledKey";
@@ -27,20 +34,46 @@ static NSString * const SBTProxyURLProtocolRewriteResponse = @"SBTProxyURLProtoc
 static NSString * const SBTProxyURLProtocolBlockCookiesKey = @"SBTProxyURLProtocolBlockCookiesKey";
 static NSString * const SBTProxyURLProtocolBlockCookiesActiveIterationsKey  = @"SBTProxyURLProtocolBlockCookiesActiveIterationsKey";
 static NSString * const SBTProxyURLProtocolMatchingRuleIdentifierKey = @"SBTProxyURLProtocolMatchingRuleIdentifierKey";
+static NSString * const SBTProxyURLProtocolCapturePolicyKey = @"SBTProxyURLProtocolCapturePolicyKey";
 
 typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
 
+/// Where a response served without reaching the network comes from, only stubs are reported as stubbed to monitors
+typedef NS_ENUM(NSInteger, SBTProxyURLProtocolLocalResponseSource) {
+    SBTProxyURLProtocolLocalResponseSourceStub,
+    SBTProxyURLProtocolLocalResponseSourceHAR,
+    SBTProxyURLProtocolLocalResponseSourceCassette,
+    SBTProxyURLProtocolLocalResponseSourceHTTPCache,
+};
+
 @interface SBTProxyURLProtocol() <NSURLSessionDataDelegate,NSURLSessionTaskDelegate,NSURLSessionDelegate>
 
 @property (nonatomic, strong) NSURLSessionDataTask *connection;
+@property (nonatomic, strong) SBTTeeInputStream *bodyTee;
+@property (nonatomic, strong) SBTNetworkCassette *recordingCassette;
+@property (nonatomic, strong) SBTNetworkCassette *replayingCassette;
+@property (nonatomic, strong) SBTHTTPCache *httpCache;
+@property (nonatomic, strong) SBTHTTPCacheEntry *staleCacheEntry;
+@property (nonatomic, assign) BOOL httpCacheEnabled;
+@property (nonatomic, assign) BOOL notModified;
+@property (nonatomic, assign) BOOL redirected;
+@property (nonatomic, strong) NSString *originalRequestToken;
 @property (nonatomic, strong) NSMutableDictionary<NSURLSessionTask *, NSMutableData *> *tasksData;
 @property (nonatomic, strong) NSMutableDictionary<NSURLSessionTask *, NSDate *> *tasksTime;
 
 @property (nonatomic, strong) NSMutableArray<NSDictionary *> *matchingRules;
-@property (nonatomic, strong) NSMutableArray<SBTMonitoredNetworkRequest *> *monitoredRequests;
+@property (nonatomic, strong) NSMutableArray<SBTHARStubTable *> *harStubTables;
+@property (nonatomic, strong) SBTMonitoredRequestsBuffer *monitoredRequests;
 @property (nonatomic, strong) dispatch_queue_t monitoredRequestsSyncQueue;
+@property (nonatomic, strong) NSCondition *monitoredRequestsCondition;
+@property (nonatomic, copy) void (^monitoredRequestsObserver)(SBTMonitoredNetworkRequest *);
+@property (nonatomic, strong) NSMutableArray<BOOL (^)(void)> *monitoredRequestsWaiters;
+@property (nonatomic, strong) SBTMonitoredRequestsTrace *monitoredRequestsTrace;
+@property (nonatomic, strong) NSCache<NSNumber *, SBTMonitoredNetworkRequest *> *flushedMonitoredRequests;
+@property (nonatomic, strong) SBTNetworkStatisticsAggregator *networkStatistics;
 
 @property (nonatomic, strong) NSURLResponse *response;
+@property (nonatomic, strong) NSURLSessionTaskMetrics *taskMetrics;
 
 @end
 
@@ -65,10 +98,25 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
 - (void)reset
 {
     self.matchingRules = [NSMutableArray array];
+    self.harStubTables = [NSMutableArray array];
     self.tasksData = [NSMutableDictionary dictionary];
     self.tasksTime = [NSMutableDictionary dictionary];
-    self.monitoredRequests = [NSMutableArray array];
+    self.monitoredRequests = [[SBTMonitoredRequestsBuffer alloc] initWithCapacity:0
+                                                                   overflowPolicy:SBTMonitoredNetworkRequestsOverflowPolicyDropOldest
+                                                                     spillFileURL:[SBTMonitoredRequestsBuffer defaultSpillFileURL]];
     self.monitoredRequestsSyncQueue = dispatch_queue_create("com.sbtuitesttunnel.protocol.queue", DISPATCH_QUEUE_SERIAL);
+    // kept across resets so that pending waits are still woken up
+    self.monitoredRequestsCondition = self.monitoredRequestsCondition ?: [[NSCondition alloc] init];
+    self.monitoredRequestsObserver = nil;
+    // waiters registered before the reset time out
+    self.monitoredRequestsWaiters = [NSMutableArray array];
+    self.monitoredRequestsTrace = nil;
+    self.flushedMonitoredRequests = [[NSCache alloc] init];
+    self.flushedMonitoredRequests.countLimit = 256;
+    self.networkStatistics = [[SBTNetworkStatisticsAggregator alloc] init];
+    self.recordingCassette = nil;
+    self.replayingCassette = nil;
+    self.httpCacheEnabled = NO;
 }
 
 # pragma mark - Throttling
@@ -121,7 +169,13 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
 
 + (NSString *)monitorRequestsMatching:(SBTRequestMatch *)match;
 {
-    NSDictionary *rule = [self makeRuleWithAttributes:@{SBTProxyURLProtocolMatchingRuleKey: match}];
+    return [self monitorRequestsMatching:match capturePolicy:nil];
+}
+
++ (NSString *)monitorRequestsMatching:(SBTRequestMatch *)match capturePolicy:(SBTMonitorCapturePolicy *)capturePolicy
+{
+    NSDictionary *rule = [self makeRuleWithAttributes:@{SBTProxyURLProtocolMatchingRuleKey: match,
+                                                        SBTProxyURLProtocolCapturePolicyKey: capturePolicy ?: [SBTMonitorCapturePolicy defaultPolicy]}];
     
     @synchronized (self.sharedInstance) {
         [self.sharedInstance.matchingRules insertObject:rule atIndex:0];
@@ -166,7 +220,7 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
 {
     __block NSArray<SBTMonitoredNetworkRequest *> *ret;
     dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
-        ret = [self.sharedInstance.monitoredRequests copy];
+        ret = [self.sharedInstance.monitoredRequests allRequests];
     });
     
     return ret;
@@ -175,8 +229,211 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
 + (void)monitoredRequestsFlushAll
 {
     dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
-        [self.sharedInstance.monitoredRequests removeAllObjects];
+        [self.sharedInstance.monitoredRequests removeAllRequests];
+    });
+}
+
++ (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsDrainAll
+{
+    __block NSArray<SBTMonitoredNetworkRequest *> *ret;
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        ret = [self.sharedInstance.monitoredRequests drainAllRequests];
+    });
+
+    return ret;
+}
+
++ (NSArray<SBTMonitoredNetworkRequest *> *)monitoredRequestsSinceSequenceNumber:(NSUInteger)sequenceNumber
+{
+    __block NSArray<SBTMonitoredNetworkRequest *> *ret;
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        ret = [self.sharedInstance.monitoredRequests requestsSinceSequenceNumber:sequenceNumber];
+    });
+
+    return ret;
+}
+
++ (BOOL)monitoredRequestsWaitForRequestsMatching:(SBTRequestMatch *)match iterations:(NSUInteger)iterations timeout:(NSTimeInterval)timeout
+{
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    NSCondition *condition = self.sharedInstance.monitoredRequestsCondition;
+    // in connectionless mode commands run on the main thread, which also delivers stubbed and throttled responses
+    BOOL waitOnRunLoop = [NSThread isMainThread];
+
+    NSUInteger cursor = 0;
+    NSUInteger matchCount = 0;
+
+    [condition lock];
+    while (YES) {
+        for (SBTMonitoredNetworkRequest *request in [self monitoredRequestsSinceSequenceNumber:cursor]) {
+            cursor = request.sequenceNumber;
+            if ([request matches:match]) {
+                matchCount++;
+            }
+        }
+
+        if (iterations == 0 || matchCount >= iterations || [deadline timeIntervalSinceNow] <= 0) {
+            break;
+        }
+
+        if (waitOnRunLoop) {
+            [condition unlock];
+            [NSRunLoop.mainRunLoop runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+            [condition lock];
+        } else {
+            [condition waitUntilDate:deadline];
+        }
+    }
+    [condition unlock];
+
+    return iterations == 0 ? matchCount == 0 : matchCount >= iterations;
+}
+
++ (void)monitoredRequestsWaitForRequestsMatching:(SBTRequestMatch *)match iterations:(NSUInteger)iterations timeout:(NSTimeInterval)timeout completion:(void (^)(BOOL))completion
+{
+    SBTProxyURLProtocol *sharedInstance = self.sharedInstance;
+    dispatch_queue_t syncQueue = sharedInstance.monitoredRequestsSyncQueue;
+
+    dispatch_async(syncQueue, ^{
+        NSMutableArray<BOOL (^)(void)> *waiters = sharedInstance.monitoredRequestsWaiters;
+        SBTMonitoredRequestsBuffer *monitoredRequests = sharedInstance.monitoredRequests;
+
+        __block NSUInteger cursor = 0;
+        __block NSUInteger matchCount = 0;
+        void (^matchNewRequests)(void) = ^{
+            for (SBTMonitoredNetworkRequest *request in [monitoredRequests requestsSinceSequenceNumber:cursor]) {
+                cursor = request.sequenceNumber;
+                if ([request matches:match]) {
+                    matchCount++;
+                }
+            }
+        };
+
+        matchNewRequests();
+        if (iterations == 0 || matchCount >= iterations || timeout <= 0) {
+            BOOL matched = iterations == 0 ? matchCount == 0 : matchCount >= iterations;
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                completion(matched);
+            });
+            return;
+        }
+
+        // both the waiter and the timeout run on the sync queue, whichever removes the waiter completes the wait
+        dispatch_source_t timeoutTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, syncQueue);
+
+        BOOL (^waiter)(void) = ^BOOL{
+            matchNewRequests();
+            if (matchCount < iterations) {
+                return NO;
+            }
+
+            dispatch_source_cancel(timeoutTimer);
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                completion(YES);
+            });
+            return YES;
+        };
+        [waiters addObject:waiter];
+
+        dispatch_source_set_timer(timeoutTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)), DISPATCH_TIME_FOREVER, NSEC_PER_SEC / 10);
+        dispatch_source_set_event_handler(timeoutTimer, ^{
+            dispatch_source_cancel(timeoutTimer);
+            if ([waiters indexOfObjectIdenticalTo:waiter] == NSNotFound) {
+                return;
+            }
+            [waiters removeObjectIdenticalTo:waiter];
+
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                completion(NO);
+            });
+        });
+        dispatch_resume(timeoutTimer);
+    });
+}
+
++ (void)monitoredRequestsAppend:(SBTMonitoredNetworkRequest *)request
+{
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        [self.sharedInstance.monitoredRequests appendRequest:request];
+        // appended while serialized so that trace entries are in sequence number order
+        [self.sharedInstance.monitoredRequestsTrace appendRequest:request];
+        // published while serialized as well, subscribers detect dropped events as gaps in sequence numbers
+        void (^observer)(SBTMonitoredNetworkRequest *) = self.sharedInstance.monitoredRequestsObserver;
+        if (observer) {
+            observer(request);
+        }
+
+        NSMutableArray<BOOL (^)(void)> *waiters = self.sharedInstance.monitoredRequestsWaiters;
+        for (BOOL (^waiter)(void) in [waiters copy]) {
+            if (waiter()) {
+                [waiters removeObjectIdenticalTo:waiter];
+            }
+        }
     });
+
+    NSCondition *condition = self.sharedInstance.monitoredRequestsCondition;
+    [condition lock];
+    [condition broadcast];
+    [condition unlock];
+}
+
++ (SBTMonitoredNetworkRequest *)monitoredRequestWithSequenceNumber:(NSUInteger)sequenceNumber
+{
+    __block SBTMonitoredNetworkRequest *ret;
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        ret = [self.sharedInstance.monitoredRequests requestWithSequenceNumber:sequenceNumber];
+    });
+
+    return ret ?: [self.sharedInstance.flushedMonitoredRequests objectForKey:@(sequenceNumber)];
+}
+
++ (void)monitoredRequestsKeepFlushedRequests:(NSArray<SBTMonitoredNetworkRequest *> *)requests
+{
+    NSCache<NSNumber *, SBTMonitoredNetworkRequest *> *flushedMonitoredRequests = self.sharedInstance.flushedMonitoredRequests;
+    for (SBTMonitoredNetworkRequest *request in requests) {
+        [flushedMonitoredRequests setObject:request forKey:@(request.sequenceNumber)];
+    }
+}
+
++ (void)monitoredRequestsSetObserver:(void (^)(SBTMonitoredNetworkRequest *))observer
+{
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        self.sharedInstance.monitoredRequestsObserver = observer;
+    });
+}
+
++ (void)monitoredRequestsSetTrace:(SBTMonitoredRequestsTrace *)trace
+{
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        self.sharedInstance.monitoredRequestsTrace = trace;
+    });
+}
+
++ (SBTMonitoredRequestsTrace *)monitoredRequestsTrace
+{
+    __block SBTMonitoredRequestsTrace *trace = nil;
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        trace = self.sharedInstance.monitoredRequestsTrace;
+    });
+
+    return trace;
+}
+
++ (void)monitoredRequestsSetCapacity:(NSUInteger)capacity overflowPolicy:(SBTMonitoredNetworkRequestsOverflowPolicy)overflowPolicy
+{
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        [self.sharedInstance.monitoredRequests setCapacity:capacity overflowPolicy:overflowPolicy];
+    });
+}
+
++ (SBTMonitoredNetworkRequestsStatistics *)monitoredRequestsStatistics
+{
+    __block SBTMonitoredNetworkRequestsStatistics *ret;
+    dispatch_sync(self.sharedInstance.monitoredRequestsSyncQueue, ^{
+        ret = [self.sharedInstance.monitoredRequests statistics];
+    });
+
+    return ret;
 }
 
 #pragma mark - Stubbing
@@ -205,6 +462,14 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
         }
         
         [self.sharedInstance.matchingRules removeObjectsInArray:itemsToDelete];
+        
+        for (SBTHARStubTable *harTable in self.sharedInstance.harStubTables) {
+            if ([harTable.identifier isEqualToString:reqId]) {
+                [itemsToDelete addObject:harTable];
+            }
+        }
+        
+        [self.sharedInstance.harStubTables removeObjectsInArray:itemsToDelete];
     }
     
     return itemsToDelete.count > 0;
@@ -238,6 +503,7 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
         }
         
         [self.sharedInstance.matchingRules removeObjectsInArray:itemsToDelete];
+        [self.sharedInstance.harStubTables removeAllObjects];
         NSLog(@"[SBTUITestTunnel] %ld matching rules left", (long)self.sharedInstance.matchingRules.count);
     }
 }
@@ -261,6 +527,49 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     return activeStubs;
 }
 
++ (NSString *)stubRequestsWithHARTable:(SBTHARStubTable *)harTable
+{
+    @synchronized (self.sharedInstance) {
+        // like regular stubs, tables added last take precedence
+        [self.sharedInstance.harStubTables insertObject:harTable atIndex:0];
+    }
+    
+    return harTable.identifier;
+}
+
++ (SBTStubResponse *)harStubResponseForRequest:(NSURLRequest *)request
+{
+    NSArray<SBTHARStubTable *> *harTables;
+    @synchronized (self.sharedInstance) {
+        harTables = [self.sharedInstance.harStubTables copy];
+    }
+    
+    for (SBTHARStubTable *harTable in harTables) {
+        SBTStubResponse *response = [harTable responseForRequest:request];
+        if (response != nil) {
+            return response;
+        }
+    }
+    
+    return nil;
+}
+
++ (BOOL)harStubTablesContainRequest:(NSURLRequest *)request
+{
+    NSArray<SBTHARStubTable *> *harTables;
+    @synchronized (self.sharedInstance) {
+        harTables = [self.sharedInstance.harStubTables copy];
+    }
+    
+    for (SBTHARStubTable *harTable in harTables) {
+        if ([harTable containsRequest:request]) {
+            return YES;
+        }
+    }
+    
+    return NO;
+}
+
 #pragma mark - Rewrite
 
 + (NSString *)rewriteRequestsMatching:(SBTRequestMatch *)match rewrite:(SBTRewrite *)rewrite
@@ -353,6 +662,53 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     }
 }
 
+#pragma mark - Cassettes
+
++ (void)cassetteStartRecording:(SBTNetworkCassette *)cassette
+{
+    @synchronized (self.sharedInstance) {
+        self.sharedInstance.replayingCassette = nil;
+        self.sharedInstance.recordingCassette = cassette;
+    }
+}
+
++ (void)cassetteStartReplaying:(SBTNetworkCassette *)cassette
+{
+    @synchronized (self.sharedInstance) {
+        self.sharedInstance.recordingCassette = nil;
+        self.sharedInstance.replayingCassette = cassette;
+    }
+}
+
++ (void)cassetteStop
+{
+    @synchronized (self.sharedInstance) {
+        self.sharedInstance.recordingCassette = nil;
+        self.sharedInstance.replayingCassette = nil;
+    }
+}
+
+#pragma mark - HTTP Cache
+
++ (void)httpCacheSetEnabled:(BOOL)enabled
+{
+    @synchronized (self.sharedInstance) {
+        self.sharedInstance.httpCacheEnabled = enabled;
+    }
+}
+
++ (SBTHTTPCache *)httpCache
+{
+    return [SBTHTTPCache sharedCache];
+}
+
+#pragma mark - Network Statistics
+
++ (SBTNetworkStatisticsAggregator *)networkStatistics
+{
+    return self.sharedInstance.networkStatistics;
+}
+
 #pragma mark - NSURLProtocol
 
 + (BOOL)canInitWithRequest:(NSURLRequest *)request
@@ -371,8 +727,17 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
         return NO;
     }
     
+    if (self.sharedInstance.recordingCassette != nil || self.sharedInstance.replayingCassette != nil) {
+        // when recording or replaying a cassette all traffic goes through the proxy
+        return YES;
+    }
+    
+    if (self.sharedInstance.httpCacheEnabled && [SBTHTTPCache canCacheRequest:request]) {
+        return YES;
+    }
+    
     NSArray *matchingRules = [self matchingRulesForRequest:request];
-    return (matchingRules != nil);
+    return (matchingRules != nil) || [self harStubTablesContainRequest:request];
 }
 
 + (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
@@ -386,8 +751,21 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     return isCacheEquivalent;
 }
 
+- (void)dealloc
+{
+    if (_originalRequestToken != nil) {
+        [[SBTOriginalRequestTable sharedTable] releaseToken:_originalRequestToken];
+    }
+}
+
 - (void)startLoading
 {
+    // keep the original request of a redirect chain around while this hop is in flight
+    self.originalRequestToken = [SBTRequestPropertyStorage propertyForKey:SBTProxyURLOriginalRequestKey inRequest:self.request];
+    if (self.originalRequestToken != nil) {
+        [[SBTOriginalRequestTable sharedTable] retainToken:self.originalRequestToken];
+    }
+    
     NSArray<NSDictionary *> *matchingRules = [SBTProxyURLProtocol matchingRulesForRequest:self.request];
     NSDictionary *stubRule = [self stubRuleFromMatchingRules:matchingRules];
     NSDictionary *throttleRule = [self throttleRuleFromMatchingRules:matchingRules];
@@ -400,87 +778,79 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     
     if (stubRule && !stubbingHeaders) {
         // STUB REQUEST
-        SBTStubResponse *stubResponse = stubRule[SBTProxyURLProtocolStubResponse];
-        NSInteger stubbingStatusCode = stubResponse.returnCode;
-                
-        NSTimeInterval stubbingResponseTime = stubResponse.responseTime;
-        if (stubbingResponseTime == 0.0 && throttleRule) {
-            // if response time is not set in stub but set in proxy
-            stubbingResponseTime = [throttleRule[SBTProxyURLProtocolDelayResponseTimeKey] doubleValue];
-        }
+        [self loadStubResponse:stubRule[SBTProxyURLProtocolStubResponse] stubRuleId:stubRule[SBTProxyURLProtocolMatchingRuleIdentifierKey] source:SBTProxyURLProtocolLocalResponseSourceStub matchingRules:matchingRules throttleRule:throttleRule];
         
-        if (stubbingResponseTime < 0) {
-            // When negative delayResponseTime is the faked response time expressed in KB/s
-            stubbingResponseTime = stubResponse.data.length / (1024 * ABS(stubbingResponseTime));
-        }
+        return;
+    }
+    
+    SBTStubResponse *harStubResponse = stubbingHeaders ? nil : [SBTProxyURLProtocol harStubResponseForRequest:self.request];
+    if (harStubResponse != nil) {
+        // STUB REQUEST FROM HAR
+        [self loadStubResponse:harStubResponse stubRuleId:nil source:SBTProxyURLProtocolLocalResponseSourceHAR matchingRules:matchingRules throttleRule:throttleRule];
         
-        __weak typeof(self)weakSelf = self;
-        id<NSURLProtocolClient>client = self.client;
-        NSURLRequest *request = self.request;
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(stubbingResponseTime * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-            __strong typeof(weakSelf)strongSelf = weakSelf;
-            
-            strongSelf.response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:stubbingStatusCode HTTPVersion:nil headerFields:stubResponse.headers];
-            
-            if ([strongSelf monitorRuleFromMatchingRules:matchingRules] != nil) {
-                SBTMonitoredNetworkRequest *monitoredRequest = [[SBTMonitoredNetworkRequest alloc] init];
-                
-                monitoredRequest.timestamp = [[NSDate date] timeIntervalSinceReferenceDate];
-                monitoredRequest.requestTime = stubbingResponseTime;
-                monitoredRequest.request = strongSelf.request;
-                monitoredRequest.originalRequest = strongSelf.request;
-                
-                monitoredRequest.response = (NSHTTPURLResponse *)strongSelf.response;
-                
-                monitoredRequest.responseData = stubResponse.data;
-                
-                monitoredRequest.isStubbed = YES;
-                monitoredRequest.isRewritten = NO;
-            
-                
-                monitoredRequest.requestData = [monitoredRequest.originalRequest sbt_extractHTTPBody];
-                
-                dispatch_sync([SBTProxyURLProtocol sharedInstance].monitoredRequestsSyncQueue, ^{
-                    [[SBTProxyURLProtocol sharedInstance].monitoredRequests addObject:monitoredRequest];
-                });
-            }
-            
-            if ([stubResponse isKindOfClass:[SBTStubFailureResponse class]]) {
-                SBTStubFailureResponse *failureStubResponse = (SBTStubFailureResponse *)stubResponse;
-                NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:failureStubResponse.failureCode userInfo:nil];
-                
-                [client URLProtocol:strongSelf didFailWithError:error];
-                [client URLProtocolDidFinishLoading:strongSelf];
-            } else {
-                if (stubResponse.headers[@"Location"] != nil) {
-                    NSURL *redirectionUrl = [NSURL URLWithString:stubResponse.headers[@"Location"]];
-                    NSMutableURLRequest *redirectionRequest = [NSMutableURLRequest requestWithURL:redirectionUrl];
-                    
-                    [NSURLProtocol removePropertyForKey:SBTProxyURLProtocolHandledKey inRequest:redirectionRequest];
-                    if (![SBTRequestPropertyStorage propertyForKey:SBTProxyURLOriginalRequestKey inRequest:redirectionRequest]) {
-                        // don't handle double (or more) redirects
-                        [[self class] associateOriginalRequest:request withRequest:redirectionRequest];
-                    }
-                    
-                    [client URLProtocol:strongSelf wasRedirectedToRequest:redirectionRequest redirectResponse:strongSelf.response];
-                } else {
-                    [client URLProtocol:strongSelf didReceiveResponse:strongSelf.response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
-                    [client URLProtocol:strongSelf didLoadData:stubResponse.data];
-                    [client URLProtocolDidFinishLoading:strongSelf];
-                }
-            }
-            
+        return;
+    }
+    
+    SBTNetworkCassette *replayingCassette = [SBTProxyURLProtocol sharedInstance].replayingCassette;
+    if (replayingCassette != nil) {
+        // REPLAY REQUEST, never reaching the network
+        SBTStubResponse *cassetteResponse = [replayingCassette responseForRequest:self.request body:nil];
+        NSString *stubRuleId = nil;
+        SBTProxyURLProtocolLocalResponseSource source = SBTProxyURLProtocolLocalResponseSourceCassette;
+        if (cassetteResponse == nil) {
+            NSLog(@"[SBTUITestTunnel] Request %@ %@ not found in cassette %@, failing", [self.request HTTPMethod], [self.request URL], replayingCassette.directoryURL.lastPathComponent);
+            cassetteResponse = [[SBTStubFailureResponse alloc] initWithFailureCode:NSURLErrorNotConnectedToInternet responseTime:0.0 activeIterations:0];
+        } else if (stubbingHeaders) {
+            // the replayed response stands in for the network one header stubs are matched against
+            SBTStubResponse *stubResponse = stubRule[SBTProxyURLProtocolStubResponse];
             if (stubResponse.activeIterations > 0) {
                 if (--stubResponse.activeIterations == 0) {
                     [SBTProxyURLProtocol stubRequestsRemoveWithId:stubRule[SBTProxyURLProtocolMatchingRuleIdentifierKey]];
                 }
             }
-        });
+            
+            BOOL headersMatch = YES;
+            if (requestMatch.requestHeaders.count > 0) {
+                headersMatch &= [requestMatch matchesRequestHeaders:self.request.allHTTPHeaderFields ?: @{}];
+            }
+            headersMatch &= [requestMatch matchesResponseHeaders:cassetteResponse.headers];
+            
+            if (headersMatch) {
+                cassetteResponse = [[SBTStubResponse alloc] initWithResponse:stubResponse.data
+                                                                     headers:cassetteResponse.headers
+                                                                 contentType:cassetteResponse.contentType
+                                                                  returnCode:cassetteResponse.returnCode
+                                                                responseTime:cassetteResponse.responseTime
+                                                            activeIterations:0];
+                stubRuleId = stubRule[SBTProxyURLProtocolMatchingRuleIdentifierKey];
+                source = SBTProxyURLProtocolLocalResponseSourceStub;
+            }
+        }
+        
+        [self loadStubResponse:cassetteResponse stubRuleId:stubRuleId source:source matchingRules:matchingRules throttleRule:throttleRule];
         
         return;
     }
     
-    if (monitorRule != nil || throttleRule != nil || rewriteRule != nil || cookieBlockRule != nil || stubbingHeaders) {
+    self.recordingCassette = [SBTProxyURLProtocol sharedInstance].recordingCassette;
+    
+    if ([SBTProxyURLProtocol sharedInstance].httpCacheEnabled && rewriteRule == nil && !stubbingHeaders && self.recordingCassette == nil && [SBTHTTPCache canCacheRequest:self.request]) {
+        SBTHTTPCache *httpCache = [SBTProxyURLProtocol httpCache];
+        SBTHTTPCacheEntry *cacheEntry = [httpCache entryForRequest:self.request];
+        
+        if (cacheEntry.isFresh) {
+            // CACHED REQUEST
+            [httpCache recordHit];
+            [self loadStubResponse:[cacheEntry stubResponse] stubRuleId:nil source:SBTProxyURLProtocolLocalResponseSourceHTTPCache matchingRules:matchingRules throttleRule:throttleRule];
+            
+            return;
+        }
+        
+        self.httpCache = httpCache;
+        self.staleCacheEntry = cacheEntry.canBeRevalidated ? cacheEntry : nil;
+    }
+    
+    if (monitorRule != nil || throttleRule != nil || rewriteRule != nil || cookieBlockRule != nil || stubbingHeaders || self.recordingCassette != nil || self.httpCache != nil) {
         __unused SBTRequestMatch *requestMatch1 = throttleRule[SBTProxyURLProtocolMatchingRuleKey];
         __unused SBTRequestMatch *requestMatch2 = cookieBlockRule[SBTProxyURLProtocolMatchingRuleKey];
         __unused SBTRequestMatch *requestMatch3 = rewriteRule[SBTProxyURLProtocolMatchingRuleKey];
@@ -488,13 +858,23 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
         __unused SBTRequestMatch *requestMatch5 = monitorRule[SBTProxyURLProtocolMatchingRuleKey];
         NSLog(@"[SBTUITestTunnel] Throttling/monitoring/chaning cookies/stubbing headers %@ request: %@\n\nMatching rule:\n%@", [self.request HTTPMethod], [self.request URL], requestMatch1 ?: requestMatch2 ?: requestMatch3 ?: requestMatch4 ?: requestMatch5);
         NSMutableURLRequest *newRequest = [self.request mutableCopy];
-        NSData *bodyData = [self.request sbt_extractHTTPBody];
-        if (bodyData) {
-            [newRequest setHTTPBody:bodyData];
-            [newRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)bodyData.length]
-                 forHTTPHeaderField:@"Content-Length"];
+        NSInputStream *bodyStream = self.request.HTTPBodyStream;
+        if (bodyStream != nil && rewriteRule == nil && ![SBTTeeInputStream isCapturingStream:bodyStream]) {
+            // Forward the body stream as is capturing its content while being sent, this avoids reading
+            // (and holding in memory) the whole body before the request starts
+            self.bodyTee = [[SBTTeeInputStream alloc] initWithInputStream:bodyStream];
+            newRequest.HTTPBodyStream = self.bodyTee;
+        } else {
+            NSData *bodyData = [self.request sbt_extractHTTPBody];
+            if (bodyData) {
+                [newRequest setHTTPBody:bodyData];
+                [newRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)bodyData.length]
+                     forHTTPHeaderField:@"Content-Length"];
+            }
         }
         
+        [self.staleCacheEntry addValidatorsToRequest:newRequest];
+        
         [SBTRequestPropertyStorage setProperty:@YES forKey:SBTProxyURLProtocolHandledKey inRequest:newRequest];
         
         NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
@@ -551,6 +931,94 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     }
 }
 
+- (void)loadStubResponse:(SBTStubResponse *)stubResponse stubRuleId:(NSString *)stubRuleId source:(SBTProxyURLProtocolLocalResponseSource)source matchingRules:(NSArray<NSDictionary *> *)matchingRules throttleRule:(NSDictionary *)throttleRule
+{
+    NSInteger stubbingStatusCode = stubResponse.returnCode;
+            
+    NSTimeInterval stubbingResponseTime = stubResponse.responseTime;
+    if (stubbingResponseTime == 0.0 && throttleRule) {
+        // if response time is not set in stub but set in proxy
+        stubbingResponseTime = [throttleRule[SBTProxyURLProtocolDelayResponseTimeKey] doubleValue];
+    }
+    
+    if (stubbingResponseTime < 0) {
+        // When negative delayResponseTime is the faked response time expressed in KB/s
+        stubbingResponseTime = stubResponse.data.length / (1024 * ABS(stubbingResponseTime));
+    }
+    
+    __weak typeof(self)weakSelf = self;
+    id<NSURLProtocolClient>client = self.client;
+    NSURLRequest *request = self.request;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(stubbingResponseTime * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        __strong typeof(weakSelf)strongSelf = weakSelf;
+        
+        strongSelf.response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:stubbingStatusCode HTTPVersion:nil headerFields:stubResponse.headers];
+        
+        NSError *stubError = nil;
+        if ([stubResponse isKindOfClass:[SBTStubFailureResponse class]]) {
+            stubError = [NSError errorWithDomain:NSURLErrorDomain code:((SBTStubFailureResponse *)stubResponse).failureCode userInfo:nil];
+        }
+        [[SBTProxyURLProtocol networkStatistics] recordRequest:request
+                                                      response:strongSelf.response
+                                                         error:stubError
+                                                       latency:stubbingResponseTime
+                                                     bytesSent:request.HTTPBody.length
+                                                 bytesReceived:stubResponse.data.length];
+        
+        NSDictionary *monitorRule = [strongSelf monitorRuleFromMatchingRules:matchingRules];
+        if (monitorRule != nil) {
+            SBTMonitoredNetworkRequest *monitoredRequest = [[SBTMonitoredNetworkRequest alloc] init];
+            
+            monitoredRequest.timestamp = [[NSDate date] timeIntervalSinceReferenceDate];
+            monitoredRequest.requestTime = stubbingResponseTime;
+            monitoredRequest.request = strongSelf.request;
+            monitoredRequest.originalRequest = strongSelf.request;
+            
+            monitoredRequest.response = (NSHTTPURLResponse *)strongSelf.response;
+            
+            monitoredRequest.responseData = stubResponse.data;
+            
+            // cache hits, cassette replays and HAR entries stand for passthrough traffic
+            monitoredRequest.isStubbed = (source == SBTProxyURLProtocolLocalResponseSourceStub);
+            monitoredRequest.isRewritten = NO;
+        
+            
+            monitoredRequest.requestData = [monitoredRequest.originalRequest sbt_extractHTTPBody];
+            [monitorRule[SBTProxyURLProtocolCapturePolicyKey] applyToRequest:monitoredRequest];
+            
+            [SBTProxyURLProtocol monitoredRequestsAppend:monitoredRequest];
+        }
+        
+        if (stubError != nil) {
+            [client URLProtocol:strongSelf didFailWithError:stubError];
+            [client URLProtocolDidFinishLoading:strongSelf];
+        } else {
+            if (stubResponse.headers[@"Location"] != nil) {
+                NSURL *redirectionUrl = [NSURL URLWithString:stubResponse.headers[@"Location"]];
+                NSMutableURLRequest *redirectionRequest = [NSMutableURLRequest requestWithURL:redirectionUrl];
+                
+                [NSURLProtocol removePropertyForKey:SBTProxyURLProtocolHandledKey inRequest:redirectionRequest];
+                if (![SBTRequestPropertyStorage propertyForKey:SBTProxyURLOriginalRequestKey inRequest:redirectionRequest]) {
+                    // don't handle double (or more) redirects
+                    [[self class] associateOriginalRequest:request withRequest:redirectionRequest];
+                }
+                
+                [client URLProtocol:strongSelf wasRedirectedToRequest:redirectionRequest redirectResponse:strongSelf.response];
+            } else {
+                [client URLProtocol:strongSelf didReceiveResponse:strongSelf.response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+                [client URLProtocol:strongSelf didLoadData:stubResponse.data];
+                [client URLProtocolDidFinishLoading:strongSelf];
+            }
+        }
+        
+        if (stubResponse.activeIterations > 0) {
+            if (--stubResponse.activeIterations == 0) {
+                [SBTProxyURLProtocol stubRequestsRemoveWithId:stubRuleId];
+            }
+        }
+    });
+}
+
 - (void)stopLoading
 {
     [self.connection cancel];
@@ -580,6 +1048,8 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     NSArray<NSDictionary *> *matchingRules = [SBTProxyURLProtocol matchingRulesForRequest:self.request];
     if ([self rewriteRuleFromMatchingRules:matchingRules] != nil) {
         // if we're rewriting the request we will send only a didLoadData callback after rewriting content once everything was received
+    } else if (self.notModified) {
+        // the cached body is sent once the request completes
     } else {
         [self.client URLProtocol:self didLoadData:data];
     }
@@ -604,6 +1074,39 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     
     self.response = task.response;
     
+    SBTMonitoredNetworkRequestTiming *timing = self.taskMetrics != nil ? [[SBTMonitoredNetworkRequestTiming alloc] initWithTaskMetrics:self.taskMetrics] : nil;
+    int64_t bytesSent = timing != nil ? timing.requestHeaderBytes + timing.requestBodyBytes : (int64_t)(self.bodyTee.capturedLength ?: request.HTTPBody.length);
+    int64_t bytesReceived = timing != nil ? timing.responseHeaderBytes + timing.responseBodyBytes : (int64_t)responseData.length;
+    [[SBTProxyURLProtocol networkStatistics] recordRequest:request
+                                                  response:task.response
+                                                     error:error
+                                                   latency:timing.totalDuration ?: requestTime
+                                                 bytesSent:bytesSent
+                                             bytesReceived:bytesReceived];
+    
+    if (self.httpCache != nil && error == nil && [task.response isKindOfClass:[NSHTTPURLResponse class]]) {
+        if (self.notModified) {
+            SBTHTTPCacheEntry *cacheEntry = [self.httpCache updateEntry:self.staleCacheEntry withNotModifiedResponse:(NSHTTPURLResponse *)task.response forRequest:request];
+            [self.httpCache recordRevalidation];
+            
+            self.response = cacheEntry.response;
+            responseData = cacheEntry.data;
+            
+            [self.client URLProtocol:self didReceiveResponse:self.response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+            [self.client URLProtocol:self didLoadData:responseData];
+        } else {
+            [self.httpCache storeResponse:(NSHTTPURLResponse *)task.response data:responseData forRequest:request];
+            [self.httpCache recordMiss];
+        }
+    }
+    
+    // after a redirect the response belongs to the last hop, which gets recorded by the protocol instance loading it
+    if (self.recordingCassette != nil && !self.redirected && error == nil && [task.response isKindOfClass:[NSHTTPURLResponse class]]) {
+        // record the upstream response before rewrites are applied
+        NSData *requestBody = [self.bodyTee capturedData] ?: [request sbt_extractHTTPBody];
+        [self.recordingCassette recordRequest:request body:requestBody response:(NSHTTPURLResponse *)task.response responseData:responseData responseTime:requestTime];
+    }
+    
     if (isRequestRewritten) {
         SBTRewrite *rewrite = rewriteRule[SBTProxyURLProtocolRewriteResponse];
         responseData = [rewrite rewriteResponseBody:responseData];
@@ -621,11 +1124,13 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     
     NSURLRequest *originalRequest = [[self class] originalRequestFor:request];
     
-    if ([self monitorRuleFromMatchingRules:matchingRules] != nil) {
+    NSDictionary *monitorRule = [self monitorRuleFromMatchingRules:matchingRules];
+    if (monitorRule != nil) {
         SBTMonitoredNetworkRequest *monitoredRequest = [[SBTMonitoredNetworkRequest alloc] init];
         
         monitoredRequest.timestamp = [[NSDate date] timeIntervalSinceReferenceDate];
         monitoredRequest.requestTime = requestTime;
+        monitoredRequest.timing = timing;
         monitoredRequest.request = request ?: task.currentRequest;
         monitoredRequest.originalRequest = originalRequest ?: task.originalRequest;
         
@@ -636,11 +1141,10 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
         monitoredRequest.isStubbed = NO;
         monitoredRequest.isRewritten = isRequestRewritten;
         
-        monitoredRequest.requestData = [monitoredRequest.originalRequest sbt_extractHTTPBody];
+        monitoredRequest.requestData = [self.bodyTee capturedData] ?: [monitoredRequest.originalRequest sbt_extractHTTPBody];
+        [monitorRule[SBTProxyURLProtocolCapturePolicyKey] applyToRequest:monitoredRequest];
         
-        dispatch_sync([SBTProxyURLProtocol sharedInstance].monitoredRequestsSyncQueue, ^{
-            [[SBTProxyURLProtocol sharedInstance].monitoredRequests addObject:monitoredRequest];
-        });
+        [SBTProxyURLProtocol monitoredRequestsAppend:monitoredRequest];
     }
     
     if (isRequestRewritten) {
@@ -655,8 +1159,22 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     }
 }
 
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+    // delivered before URLSession:task:didCompleteWithError:
+    self.taskMetrics = metrics;
+}
+
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task willPerformHTTPRedirection:(NSHTTPURLResponse *)response newRequest:(NSURLRequest *)request completionHandler:(void (^)(NSURLRequest * _Nullable))completionHandler
 {
+    if (self.recordingCassette != nil && !self.redirected) {
+        // record the redirect itself so that replaying the original request follows it as well
+        NSTimeInterval requestTime = -1.0 * [[SBTProxyURLProtocol sharedInstance].tasksTime[task] timeIntervalSinceNow];
+        NSData *requestBody = [self.bodyTee capturedData] ?: [self.request sbt_extractHTTPBody];
+        [self.recordingCassette recordRequest:self.request body:requestBody response:response responseData:[NSData data] responseTime:requestTime];
+    }
+    self.redirected = YES;
+    
     NSMutableURLRequest *mRequest = [request mutableCopy];
     if (response.statusCode == 302 || response.statusCode == 303) {
         mRequest.HTTPBody = [NSData data]; // GET redirects should not forward HTTPBody
@@ -673,12 +1191,26 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
     completionHandler(mRequest);
 }
 
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task needNewBodyStream:(void (^)(NSInputStream * _Nullable))completionHandler
+{
+    // redirects (307/308) resend the body, the original stream was consumed so send what the tee captured
+    NSData *body = self.bodyTee.captureCompleted ? [self.bodyTee capturedData] : nil;
+    if (body == nil) {
+        NSLog(@"[SBTUITestTunnel] Can't provide a new body stream for %@, body wasn't fully captured", task.originalRequest.URL);
+    }
+
+    completionHandler(body != nil ? [NSInputStream inputStreamWithData:body] : nil);
+}
+
 -(void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
 {
     NSArray<NSDictionary *> *matchingRules = [SBTProxyURLProtocol matchingRulesForRequest:self.request];
     NSDictionary *headersStubRequest = [self stubRuleFromMatchingRules:matchingRules];
     if ([self rewriteRuleFromMatchingRules:matchingRules] != nil) {
         // if we're rewriting the request we will send only a didReceiveResponse callback after rewriting content once everything was received
+    } else if (self.staleCacheEntry != nil && [response isKindOfClass:[NSHTTPURLResponse class]] && ((NSHTTPURLResponse *)response).statusCode == 304) {
+        // the cached response is still valid, it will be sent once the request completes
+        self.notModified = YES;
     } else if (headersStubRequest != nil) {
         SBTRequestMatch *requestMatch = headersStubRequest[SBTProxyURLProtocolMatchingRuleKey];
         
@@ -845,34 +1377,21 @@ typedef void(^SBTStubUpdateBlock)(NSURLRequest *request);
 //    API MISUSE: properties set by +[NSURLProtocol setProperty:forKey:inRequest:] should only include property
 //    list types (NSArray, NSDictionary, NSString, NSData, NSDate, NSNumber).
 //
-// The methods below perform serialization for NSURLRequest types before/after they are sent through NSURLProtocol.
+// Instead of archiving the original NSURLRequest (body included) on every hop, requests carry a token
+// pointing to the original request stored in SBTOriginalRequestTable.
 
-/// Finds the original request in NSURLProtocol and deserializes it
+/// Finds the original request associated to a request
 + (NSURLRequest *)originalRequestFor:(NSURLRequest*)request {
-    NSData *serializedOriginal = [SBTRequestPropertyStorage propertyForKey:SBTProxyURLOriginalRequestKey inRequest:request];
-    NSURLRequest *originalRequest = nil;
-
-    if (serializedOriginal) {
-        // needs to be deserialized after retrieving from NSURLProtocol
-        NSError *unarchiveError;
-        NSSet *classes = [NSSet setWithObjects:[NSURLRequest class], [NSMutableURLRequest class], nil];
-        originalRequest = [NSKeyedUnarchiver unarchivedObjectOfClasses:classes fromData:serializedOriginal error:&unarchiveError];
-        NSAssert(unarchiveError == nil, @"Error unarchiving NSURLRequest from NSURLProtocol");
-    }
-
-    return originalRequest;
+    NSString *token = [SBTRequestPropertyStorage propertyForKey:SBTProxyURLOriginalRequestKey inRequest:request];
+    
+    return token != nil ? [[SBTOriginalRequestTable sharedTable] requestForToken:token] : nil;
 }
 
-/// Associates the original request to the current request by serializing and storing it
+/// Associates the original request to the current request storing it in the original request table
 + (void)associateOriginalRequest:(NSURLRequest *)original withRequest:(NSMutableURLRequest*)request {
-    // serialize the request since only plist values should be given to `setProperty:`
-    NSError *archiveError;
-    NSData *serializedOriginal = [NSKeyedArchiver archivedDataWithRootObject:original
-                                                       requiringSecureCoding:YES
-                                                                       error:&archiveError];
-    NSAssert(archiveError == nil, @"Error archiving NSURLRequest for NSURLProtocol");
-
-    [SBTRequestPropertyStorage setProperty:serializedOriginal forKey:SBTProxyURLOriginalRequestKey inRequest:request];
+    NSString *token = [[SBTOriginalRequestTable sharedTable] insertRequest:original];
+    
+    [SBTRequestPropertyStorage setProperty:token forKey:SBTProxyURLOriginalRequestKey inRequest:request];
 }
 
 @end
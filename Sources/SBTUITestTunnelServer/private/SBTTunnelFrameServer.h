@@ -0,0 +1,50 @@
+// SBTTunnelFrameServer.h
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+@import Foundation;
+@import SBTUITestTunnelCommon;
+
+/// Accepts connections of the framed tunnel transport on a loopback port or a unix domain socket.
+///
+/// Every connection is persistent, command frames are passed to the command handler in the order they are
+/// received and the response is sent back in a frame carrying the same request identifier.
+@interface SBTTunnelFrameServer : NSObject
+
+/**
+ *  Initializer
+ *
+ *  @param port the loopback port to listen on
+ *  @param commandHandler invoked for every command, reply must be called exactly once with the command's response
+ */
+- (nonnull instancetype)initWithPort:(NSInteger)port
+                      commandHandler:(nonnull void (^)(NSString * _Nonnull command, NSDictionary * _Nonnull parameters, void (^ _Nonnull reply)(NSDictionary * _Nullable response)))commandHandler;
+
+/**
+ *  Initializer
+ *
+ *  @param socketPath the path of the unix domain socket to listen on, an existing file at this path is replaced
+ *  @param commandHandler invoked for every command, reply must be called exactly once with the command's response
+ */
+- (nonnull instancetype)initWithSocketPath:(nonnull NSString *)socketPath
+                            commandHandler:(nonnull void (^)(NSString * _Nonnull command, NSDictionary * _Nonnull parameters, void (^ _Nonnull reply)(NSDictionary * _Nullable response)))commandHandler;
+
+/// Starts listening and accepting connections
+- (BOOL)startWithError:(NSError * _Nullable * _Nullable)error;
+
+/// Stops listening and closes all connections
+- (void)stop;
+
+@end
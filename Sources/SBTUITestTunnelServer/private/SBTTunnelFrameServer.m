@@ -0,0 +1,212 @@
+// SBTTunnelFrameServer.m
+//
+// Copyright (C) 2026 Subito.it S.r.l (www.subito.it)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "SBTTunnelFrameServer.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+@interface SBTTunnelFrameServer()
+
+@property (nonatomic, assign) NSInteger port;
+@property (nonatomic, copy) NSString *socketPath;
+@property (nonatomic, copy) void (^commandHandler)(NSString *, NSDictionary *, void (^)(NSDictionary *));
+@property (nonatomic, strong) dispatch_source_t acceptSource;
+@property (nonatomic, strong) NSMutableSet<SBTTunnelFrameConnection *> *connections;
+
+@end
+
+@implementation SBTTunnelFrameServer
+
+- (instancetype)initWithPort:(NSInteger)port commandHandler:(void (^)(NSString *, NSDictionary *, void (^)(NSDictionary *)))commandHandler
+{
+    if ((self = [super init])) {
+        _port = port;
+        _commandHandler = commandHandler;
+        _connections = [NSMutableSet set];
+    }
+
+    return self;
+}
+
+- (instancetype)initWithSocketPath:(NSString *)socketPath commandHandler:(void (^)(NSString *, NSDictionary *, void (^)(NSDictionary *)))commandHandler
+{
+    if ((self = [self initWithPort:0 commandHandler:commandHandler])) {
+        _socketPath = [socketPath copy];
+    }
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [self stop];
+}
+
+- (BOOL)startWithError:(NSError **)error
+{
+    int listenSocket = self.socketPath ? [self unixListenSocketWithError:error] : [self tcpListenSocketWithError:error];
+    if (listenSocket < 0) {
+        return NO;
+    }
+
+    __weak typeof(self) weakSelf = self;
+    self.acceptSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)listenSocket, 0, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0));
+    dispatch_source_set_event_handler(self.acceptSource, ^{
+        int connectionSocket = accept(listenSocket, NULL, NULL);
+        if (connectionSocket >= 0) {
+            [weakSelf acceptConnectionWithSocket:connectionSocket];
+        }
+    });
+    NSString *socketPath = self.socketPath;
+    dispatch_source_set_cancel_handler(self.acceptSource, ^{
+        close(listenSocket);
+        if (socketPath) {
+            unlink(socketPath.fileSystemRepresentation);
+        }
+    });
+    dispatch_resume(self.acceptSource);
+
+    if (socketPath) {
+        NSLog(@"[SBTUITestTunnel] Frame tunnel listening on %@", socketPath);
+    } else {
+        NSLog(@"[SBTUITestTunnel] Frame tunnel listening on port %ld", (long)self.port);
+    }
+
+    return YES;
+}
+
+- (int)tcpListenSocketWithError:(NSError **)error
+{
+    int listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        [self failWithError:error message:@"socket() failed"];
+        return -1;
+    }
+
+    int on = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)self.port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listenSocket, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listenSocket, 16) != 0) {
+        close(listenSocket);
+        [self failWithError:error message:[NSString stringWithFormat:@"Failed listening on port %ld, errno %d", (long)self.port, errno]];
+        return -1;
+    }
+
+    return listenSocket;
+}
+
+- (int)unixListenSocketWithError:(NSError **)error
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    const char *path = self.socketPath.fileSystemRepresentation;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        [self failWithError:error message:[NSString stringWithFormat:@"Socket path too long: %@", self.socketPath]];
+        return -1;
+    }
+    strlcpy(address.sun_path, path, sizeof(address.sun_path));
+    address.sun_len = (uint8_t)SUN_LEN(&address);
+
+    int listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        [self failWithError:error message:@"socket() failed"];
+        return -1;
+    }
+
+    // a stale socket left by a previous run would make bind fail
+    unlink(path);
+
+    if (bind(listenSocket, (struct sockaddr *)&address, SUN_LEN(&address)) != 0 || listen(listenSocket, 16) != 0) {
+        close(listenSocket);
+        [self failWithError:error message:[NSString stringWithFormat:@"Failed listening on %@, errno %d", self.socketPath, errno]];
+        return -1;
+    }
+
+    return listenSocket;
+}
+
+- (void)stop
+{
+    if (self.acceptSource != nil) {
+        dispatch_source_cancel(self.acceptSource);
+        self.acceptSource = nil;
+    }
+
+    NSSet<SBTTunnelFrameConnection *> *connections = nil;
+    @synchronized (self.connections) {
+        connections = [self.connections copy];
+        [self.connections removeAllObjects];
+    }
+    [connections makeObjectsPerformSelector:@selector(cancel)];
+}
+
+- (void)acceptConnectionWithSocket:(int)connectionSocket
+{
+    void (^commandHandler)(NSString *, NSDictionary *, void (^)(NSDictionary *)) = self.commandHandler;
+
+    __block __weak SBTTunnelFrameConnection *weakConnection = nil;
+    SBTTunnelFrameConnection *connection = [[SBTTunnelFrameConnection alloc] initWithFileDescriptor:connectionSocket frameHandler:^(SBTTunnelFrame *frame) {
+        if (frame.type != SBTTunnelFrameTypeCommand) {
+            return;
+        }
+
+        commandHandler(frame.command, [frame payloadDictionary] ?: @{}, ^(NSDictionary *response) {
+            [weakConnection sendFrame:[SBTTunnelFrame responseFrameForFrame:frame response:response]];
+        });
+    }];
+    weakConnection = connection;
+
+    __weak typeof(self) weakSelf = self;
+    connection.closeHandler = ^{
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        SBTTunnelFrameConnection *closedConnection = weakConnection;
+        if (strongSelf == nil || closedConnection == nil) {
+            return;
+        }
+
+        @synchronized (strongSelf.connections) {
+            [strongSelf.connections removeObject:closedConnection];
+        }
+    };
+
+    @synchronized (self.connections) {
+        [self.connections addObject:connection];
+    }
+
+    [connection resume];
+}
+
+- (BOOL)failWithError:(NSError **)error message:(NSString *)message
+{
+    if (error) {
+        *error = [NSError errorWithDomain:@"SBTTunnelFrameServer" code:-1 userInfo:@{ NSLocalizedDescriptionKey: message }];
+    }
+
+    return NO;
+}
+
+@end